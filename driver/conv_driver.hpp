@@ -207,27 +207,13 @@ class ConvDriver : public Driver
     typedef uint32_t context_t;
 #endif
 public:
-    ConvDriver() : Driver()
-    {
-        miopenCreateTensorDescriptor(&inputTensor);
-        miopenCreateTensorDescriptor(&weightTensor);
-        miopenCreateTensorDescriptor(&outputTensor);
-        miopenCreateTensorDescriptor(&biasTensor);
-        miopenCreateTensorDescriptor(&inputTensor_vect4);
-        miopenCreateTensorDescriptor(&weightTensor_vect4);
-        miopenCreateConvolutionDescriptor(&convDesc);
-
-        {
-            AutoMiopenWarmupMode warmupMode;
-            miopenCreateTensorDescriptor(&warmupInputTensor);
-            miopenCreateTensorDescriptor(&warmupWeightTensor);
-            miopenCreateTensorDescriptor(&warmupOutputTensor);
-            miopenCreateConvolutionDescriptor(&warmupConvDesc);
-        }
+    ConvDriver() : Driver() { CreateDescriptors(); }
 
-        workspace_dev = nullptr;
-        // the variable name is implementation dependent, checking size instead
-        InitDataType<Tgpu>();
+    /// Shares the handle of another driver, e.g. to only parse a command line into problems
+    /// (see MakeProblems()) without creating another GPU stream.
+    explicit ConvDriver(miopenHandle_t shared_handle) : Driver(shared_handle)
+    {
+        CreateDescriptors();
     }
 
     int AddCmdLineArgs() override;
@@ -288,6 +274,10 @@ public:
 
     int VerifyBackward() override;
     int VerifyForward() override;
+
+    // Find 2.0 problems for the directions selected by --forw, to be destroyed by the caller.
+    std::vector<miopenProblem_t> MakeProblems();
+
     ~ConvDriver() override
     {
         miopenDestroyTensorDescriptor(biasTensor);
@@ -305,6 +295,29 @@ public:
     }
 
 private:
+    void CreateDescriptors()
+    {
+        miopenCreateTensorDescriptor(&inputTensor);
+        miopenCreateTensorDescriptor(&weightTensor);
+        miopenCreateTensorDescriptor(&outputTensor);
+        miopenCreateTensorDescriptor(&biasTensor);
+        miopenCreateTensorDescriptor(&inputTensor_vect4);
+        miopenCreateTensorDescriptor(&weightTensor_vect4);
+        miopenCreateConvolutionDescriptor(&convDesc);
+
+        {
+            AutoMiopenWarmupMode warmupMode;
+            miopenCreateTensorDescriptor(&warmupInputTensor);
+            miopenCreateTensorDescriptor(&warmupWeightTensor);
+            miopenCreateTensorDescriptor(&warmupOutputTensor);
+            miopenCreateConvolutionDescriptor(&warmupConvDesc);
+        }
+
+        workspace_dev = nullptr;
+        // the variable name is implementation dependent, checking size instead
+        InitDataType<Tgpu>();
+    }
+
     const miopenDataType_t warmup_data_type = miopenFloat;
     typedef float warmup_Tgpu;
 
@@ -796,6 +809,30 @@ int ConvDriver<Tgpu, Tref>::GetandSetData()
     return (0);
 }
 
+template <typename Tgpu, typename Tref>
+std::vector<miopenProblem_t> ConvDriver<Tgpu, Tref>::MakeProblems()
+{
+    const auto directions = std::vector<std::pair<bool, miopenProblemDirection_t>>{
+        {is_fwd, miopenProblemDirectionForward},
+        {is_bwd, miopenProblemDirectionBackward},
+        {is_wrw, miopenProblemDirectionBackwardWeights},
+    };
+
+    std::vector<miopenProblem_t> problems;
+    for(const auto& direction : directions)
+    {
+        if(!direction.first)
+            continue;
+        miopenProblem_t problem;
+        miopenCreateConvProblem(&problem, convDesc, direction.second);
+        miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionX, inputTensor);
+        miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionW, weightTensor);
+        miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionY, outputTensor);
+        problems.push_back(problem);
+    }
+    return problems;
+}
+
 template <typename Tgpu, typename Tref>
 int ConvDriver<Tgpu, Tref>::AddCmdLineArgs()
 {
@@ -152,7 +152,7 @@ inline void PadBufferSize(size_t& sz, int datatype_sz)
            "activ[fp16], softmax[fp16], bnorm[fp16], rnn[fp16], gemm, ctc, dropout[fp16], "
            "tensorop[fp16], reduce[fp16,fp64]"
 #ifdef MIOPEN_BETA_API
-           ", layernorm[bf16, fp16, fp32]"
+           ", layernorm[bf16, fp16, fp32], prewarm, tuningplan"
 #endif
            "\n");
     exit(0); // NOLINT (concurrency-mt-unsafe)
@@ -178,6 +178,7 @@ inline std::string ParseBaseArg(int argc, char* argv[])
        arg != "reduce" && arg != "reducefp16" && arg != "reducefp64" &&
 #ifdef MIOPEN_BETA_API
        arg != "layernorm" && arg != "layernormfp16" && arg != "layernormbfp16" &&
+       arg != "prewarm" && arg != "tuningplan" &&
 #endif
        arg != "--version")
     {
@@ -207,6 +208,13 @@ public:
         miopenGetStream(handle, &q);
     }
 
+    /// Shares the handle of another driver, which has to outlive this one.
+    explicit Driver(miopenHandle_t shared_handle) : handle(shared_handle), owns_handle(false)
+    {
+        data_type = miopenFloat;
+        miopenGetStream(handle, &q);
+    }
+
     miopenHandle_t GetHandle() { return handle; }
     miopenDataType_t GetDataType() { return data_type; }
 
@@ -215,7 +223,11 @@ public:
 #elif MIOPEN_BACKEND_HIP
     hipStream_t& GetStream() { return q; }
 #endif
-    virtual ~Driver() { miopenDestroy(handle); }
+    virtual ~Driver()
+    {
+        if(owns_handle)
+            miopenDestroy(handle);
+    }
 
     // TODO: add timing APIs
     virtual int AddCmdLineArgs()                         = 0;
@@ -232,6 +244,7 @@ protected:
     template <typename Tgpu>
     void InitDataType();
     miopenHandle_t handle;
+    bool owns_handle = true;
     miopenDataType_t data_type;
 
 #if MIOPEN_BACKEND_OPENCL
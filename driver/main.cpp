@@ -45,6 +45,8 @@
 #include <miopen/stringutils.hpp>
 #ifdef MIOPEN_BETA_API
 #include "layernorm_driver.hpp"
+#include "prewarm_driver.hpp"
+#include "tuning_plan_driver.hpp"
 #endif
 
 int main(int argc, char* argv[])
@@ -212,6 +214,14 @@ int main(int argc, char* argv[])
     {
         drv = new LayerNormDriver<bfloat16, float>();
     }
+    else if(base_arg == "prewarm")
+    {
+        drv = new PrewarmDriver();
+    }
+    else if(base_arg == "tuningplan")
+    {
+        drv = new TuningPlanDriver();
+    }
 #endif
     else
     {
@@ -234,8 +244,10 @@ int main(int argc, char* argv[])
         return rc;
     }
 
-    int fargval =
-        !miopen::StartsWith(base_arg, "CBAInfer") ? drv->GetInputFlags().GetValueInt("forw") : 1;
+    int fargval = !miopen::StartsWith(base_arg, "CBAInfer") && base_arg != "prewarm" &&
+                          base_arg != "tuningplan"
+                      ? drv->GetInputFlags().GetValueInt("forw")
+                      : 1;
     bool bnFwdInVer   = (fargval == 2 && miopen::StartsWith(base_arg, "bnorm"));
     bool verifyarg    = (drv->GetInputFlags().GetValueInt("verify") == 1);
     int cumulative_rc = 0; // Do not stop running tests in case of errors.
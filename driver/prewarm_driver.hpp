@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PREWARM_DRIVER_HPP
+#define GUARD_MIOPEN_PREWARM_DRIVER_HPP
+
+#include "InputFlags.hpp"
+#include "driver.hpp"
+#include "problem_list.hpp"
+
+#include <miopen/miopen.h>
+
+#include <cstdio>
+#include <iostream>
+
+/// Loads the kernels of all convolutions listed in a file (MIOpenDriver command lines, e.g.
+/// test/perf_models/*.txt) with a single miopenPrewarmProblems call and reports the phases.
+class PrewarmDriver : public Driver
+{
+public:
+    PrewarmDriver() : Driver() {}
+
+    int AddCmdLineArgs() override;
+    int ParseCmdLineArgs(int argc, char* argv[]) override;
+    InputFlags& GetInputFlags() override { return inflags; }
+    int GetandSetData() override;
+    int AllocateBuffersAndCopy() override { return problems.empty() ? 1 : 0; }
+    int RunForwardGPU() override;
+    int VerifyForward() override;
+    int RunBackwardGPU() override { return 0; }
+    int VerifyBackward() override { return 0; }
+
+private:
+    InputFlags inflags;
+    ProblemList problems;
+};
+
+inline int PrewarmDriver::AddCmdLineArgs()
+{
+    inflags.AddInputFlag("file",
+                         'f',
+                         "",
+                         "File with MIOpenDriver convolution commands, one per line (Default='')",
+                         "string");
+    inflags.AddInputFlag("forw",
+                         'F',
+                         "0",
+                         "Directions of the convolutions without --forw in the file (Default=0)",
+                         "int");
+    inflags.AddInputFlag(
+        "verify", 'V', "0", "Verify that all kernels have been loaded (Default=0)", "int");
+    return 0;
+}
+
+inline int PrewarmDriver::ParseCmdLineArgs(int argc, char* argv[])
+{
+    inflags.Parse(argc, argv);
+    if(inflags.GetValueStr("file").empty())
+    {
+        std::cerr << "Error: --file is required" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+inline int PrewarmDriver::GetandSetData()
+{
+    return problems.Load(GetHandle(), inflags.GetValueStr("file"), inflags.GetValueStr("forw"));
+}
+
+inline int PrewarmDriver::RunForwardGPU()
+{
+    miopenPrewarmTimings_t timings;
+    const auto status =
+        miopenPrewarmProblems(GetHandle(), problems.size(), problems.data(), &timings);
+    if(status != miopenStatusSuccess)
+        return status;
+
+    printf("Prewarmed %zu of %zu problems, %zu programs loaded\n",
+           timings.problems,
+           problems.size(),
+           timings.programs);
+    printf("Db lookup: %.3f ms\n", timings.dbLookup);
+    printf("Kernel load: %.3f ms (summed over threads: kernel db lookup %.3f ms, decompression "
+           "%.3f ms, module load %.3f ms)\n",
+           timings.kernelLoad,
+           timings.kernDbLookup,
+           timings.decompress,
+           timings.moduleLoad);
+    printf("Invokers: %.3f ms\n", timings.invokers);
+    printf("Total: %.3f ms\n", timings.total);
+    return 0;
+}
+
+inline int PrewarmDriver::VerifyForward()
+{
+    // Everything is already loaded, so nothing should be done the second time.
+    miopenPrewarmTimings_t timings;
+    const auto status =
+        miopenPrewarmProblems(GetHandle(), problems.size(), problems.data(), &timings);
+    if(status != miopenStatusSuccess || timings.problems != 0 || timings.programs != 0)
+    {
+        printf("Prewarm verification failed: %zu problems, %zu programs loaded again\n",
+               timings.problems,
+               timings.programs);
+        return EC_VerifyFwd;
+    }
+    printf("Prewarm verifies OK\n");
+    return 0;
+}
+
+#endif // GUARD_MIOPEN_PREWARM_DRIVER_HPP
@@ -0,0 +1,156 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PROBLEM_LIST_HPP
+#define GUARD_MIOPEN_PROBLEM_LIST_HPP
+
+#include "conv_driver.hpp"
+
+#include <miopen/miopen.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// Problems of the convolutions listed in a file as MIOpenDriver commands, one per line, e.g.
+/// test/perf_models/*.txt. Other commands are skipped.
+class ProblemList
+{
+public:
+    ProblemList()                   = default;
+    ProblemList(const ProblemList&) = delete;
+    ProblemList& operator=(const ProblemList&) = delete;
+
+    ~ProblemList()
+    {
+        for(auto problem : problems)
+            miopenDestroyProblem(problem);
+    }
+
+    /// Directions of the commands without --forw are set by forw. The command lines are parsed
+    /// on the handle of the calling driver.
+    int Load(miopenHandle_t handle, const std::string& path, const std::string& forw);
+
+    bool empty() const { return problems.empty(); }
+    std::size_t size() const { return problems.size(); }
+    const miopenProblem_t* data() const { return problems.data(); }
+
+private:
+    std::vector<miopenProblem_t> problems;
+
+    int AddProblems(miopenHandle_t handle, const std::string& base_arg, std::vector<char*>& argv);
+    template <typename Tgpu, typename Tref>
+    int AddConvProblems(miopenHandle_t handle, std::vector<char*>& argv);
+};
+
+template <typename Tgpu, typename Tref>
+int ProblemList::AddConvProblems(miopenHandle_t handle, std::vector<char*>& argv)
+{
+    ConvDriver<Tgpu, Tref> conv_driver{handle};
+    conv_driver.AddCmdLineArgs();
+    auto rc = conv_driver.ParseCmdLineArgs(static_cast<int>(argv.size()), argv.data());
+    if(rc == 0)
+        rc = conv_driver.GetandSetData();
+    if(rc != 0)
+        return rc;
+
+    const auto conv_problems = conv_driver.MakeProblems();
+    problems.insert(problems.end(), conv_problems.begin(), conv_problems.end());
+    return 0;
+}
+
+inline int ProblemList::AddProblems(miopenHandle_t handle,
+                                    const std::string& base_arg,
+                                    std::vector<char*>& argv)
+{
+    if(base_arg == "conv")
+        return AddConvProblems<float, float>(handle, argv);
+    if(base_arg == "convfp16")
+        return AddConvProblems<float16, float>(handle, argv);
+    if(base_arg == "convbfp16")
+        return AddConvProblems<bfloat16, float>(handle, argv);
+    if(base_arg == "convint8")
+        return AddConvProblems<int8_t, int32_t>(handle, argv);
+    if(base_arg == "convfp8")
+        return AddConvProblems<float8, float>(handle, argv);
+    if(base_arg == "convbfp8")
+        return AddConvProblems<bfloat8, float>(handle, argv);
+
+    std::cout << "Skipping " << base_arg << ": only convolutions are supported" << std::endl;
+    return 0;
+}
+
+inline int
+ProblemList::Load(miopenHandle_t handle, const std::string& path, const std::string& forw)
+{
+    std::ifstream file(path);
+    if(!file)
+    {
+        std::cerr << "Error: unable to open " << path << std::endl;
+        return 1;
+    }
+
+    std::string line;
+    while(std::getline(file, line))
+    {
+        std::istringstream ss(line);
+        std::vector<std::string> args;
+        std::string arg;
+        while(ss >> arg)
+            args.push_back(arg);
+
+        // Skip everything before the driver itself, e.g. ./bin/MIOpenDriver
+        auto driver = args.begin();
+        while(driver != args.end() && driver->find("MIOpenDriver") == std::string::npos)
+            ++driver;
+        if(driver == args.end() || std::next(driver) == args.end())
+            continue;
+        args.erase(args.begin(), driver);
+
+        if(std::find(args.begin(), args.end(), "--forw") == args.end() &&
+           std::find(args.begin(), args.end(), "-F") == args.end())
+        {
+            args.push_back("--forw");
+            args.push_back(forw);
+        }
+
+        std::vector<char*> argv;
+        for(auto& a : args)
+            argv.push_back(&a[0]);
+
+        if(AddProblems(handle, args[1], argv) != 0)
+        {
+            std::cerr << "Error: unable to parse " << line << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#endif // GUARD_MIOPEN_PROBLEM_LIST_HPP
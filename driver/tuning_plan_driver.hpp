@@ -0,0 +1,165 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNING_PLAN_DRIVER_HPP
+#define GUARD_MIOPEN_TUNING_PLAN_DRIVER_HPP
+
+#include "InputFlags.hpp"
+#include "driver.hpp"
+#include "problem_list.hpp"
+
+#include <miopen/miopen.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Estimates the cost of tuning all convolutions listed in a file (MIOpenDriver command lines, e.g.
+/// test/perf_models/*.txt) with miopenPlanTuning and writes the plan as JSON. Nothing is compiled
+/// or run, so this can be used with the HIPNOGPU backend.
+class TuningPlanDriver : public Driver
+{
+public:
+    TuningPlanDriver() : Driver() {}
+
+    int AddCmdLineArgs() override;
+    int ParseCmdLineArgs(int argc, char* argv[]) override;
+    InputFlags& GetInputFlags() override { return inflags; }
+    int GetandSetData() override;
+    int AllocateBuffersAndCopy() override { return problems.empty() ? 1 : 0; }
+    int RunForwardGPU() override;
+    int VerifyForward() override;
+    int RunBackwardGPU() override { return 0; }
+    int VerifyBackward() override { return 0; }
+
+private:
+    InputFlags inflags;
+    ProblemList problems;
+    std::string plan;
+
+    int Plan(std::string& json);
+};
+
+inline int TuningPlanDriver::AddCmdLineArgs()
+{
+    inflags.AddInputFlag("file",
+                         'f',
+                         "",
+                         "File with MIOpenDriver convolution commands, one per line (Default='')",
+                         "string");
+    inflags.AddInputFlag("forw",
+                         'F',
+                         "0",
+                         "Directions of the convolutions without --forw in the file (Default=0)",
+                         "int");
+    inflags.AddInputFlag(
+        "compile_ms", 'c', "1000", "Time of a kernel build in ms (Default=1000)", "float");
+    inflags.AddInputFlag(
+        "measure_ms", 'm', "10", "Time of a config measurement in ms (Default=10)", "float");
+    inflags.AddInputFlag(
+        "out", 'o', "", "File to write the JSON to, stdout if empty (Default='')", "string");
+    inflags.AddInputFlag(
+        "verify", 'V', "0", "Verify that planning again gives the same plan (Default=0)", "int");
+    return 0;
+}
+
+inline int TuningPlanDriver::ParseCmdLineArgs(int argc, char* argv[])
+{
+    inflags.Parse(argc, argv);
+    if(inflags.GetValueStr("file").empty())
+    {
+        std::cerr << "Error: --file is required" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+inline int TuningPlanDriver::GetandSetData()
+{
+    return problems.Load(GetHandle(), inflags.GetValueStr("file"), inflags.GetValueStr("forw"));
+}
+
+inline int TuningPlanDriver::Plan(std::string& json)
+{
+    miopenTuningCostModel_t model;
+    model.compileMs = static_cast<float>(inflags.GetValueDouble("compile_ms"));
+    model.measureMs = static_cast<float>(inflags.GetValueDouble("measure_ms"));
+
+    size_t size = 0;
+    auto status =
+        miopenPlanTuning(GetHandle(), problems.size(), problems.data(), &model, nullptr, &size);
+    if(status != miopenStatusSuccess)
+        return status;
+
+    std::vector<char> buffer(size);
+    status = miopenPlanTuning(
+        GetHandle(), problems.size(), problems.data(), &model, buffer.data(), &size);
+    if(status != miopenStatusSuccess)
+        return status;
+
+    json = buffer.data();
+    return 0;
+}
+
+inline int TuningPlanDriver::RunForwardGPU()
+{
+    const auto rc = Plan(plan);
+    if(rc != 0)
+        return rc;
+
+    const auto path = inflags.GetValueStr("out");
+    if(path.empty())
+    {
+        std::cout << plan;
+        return 0;
+    }
+
+    std::ofstream file(path);
+    file << plan;
+    if(!file)
+    {
+        std::cerr << "Error: unable to write " << path << std::endl;
+        return 1;
+    }
+    std::cout << "Tuning plan of " << problems.size() << " problems written to " << path
+              << std::endl;
+    return 0;
+}
+
+inline int TuningPlanDriver::VerifyForward()
+{
+    // Nothing is measured, so the plan depends only on the problems and the limits.
+    std::string again;
+    if(Plan(again) != 0 || again != plan)
+    {
+        std::cout << "Tuning plan verification failed" << std::endl;
+        return EC_VerifyFwd;
+    }
+    std::cout << "Tuning plan verifies OK" << std::endl;
+    return 0;
+}
+
+#endif // GUARD_MIOPEN_TUNING_PLAN_DRIVER_HPP
@@ -258,6 +258,107 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+#ifdef MIOPEN_BETA_API
+/*! @brief Number of the buckets in the latency histograms of miopenLatencyStatistics_t
+ */
+#define MIOPEN_STATISTICS_HISTOGRAM_BUCKETS 24
+
+/*! @struct miopenLatencyStatistics_t
+ * @brief Number of operations and the distribution of their latencies
+ *
+ * Bucket i of the histogram counts the operations which took less than 2^i microseconds (and
+ * not less than 2^(i-1)), the last bucket counts all longer operations.
+ */
+typedef struct
+{
+    uint64_t count; /*!< Number of operations */
+    double totalMs; /*!< Total time of the operations */
+    double maxMs;   /*!< Time of the longest operation */
+    uint64_t histogram[MIOPEN_STATISTICS_HISTOGRAM_BUCKETS]; /*!< Latency histogram */
+} miopenLatencyStatistics_t;
+
+/*! @struct miopenDbStatistics_t
+ * @brief Lookups of a database, which consists of the user and the system layers
+ */
+typedef struct
+{
+    uint64_t userHits;                /*!< Found in the user database */
+    uint64_t systemHits;              /*!< Found in the system database only */
+    uint64_t misses;                  /*!< Not found in any */
+    miopenLatencyStatistics_t lookup; /*!< Latencies of the lookups */
+} miopenDbStatistics_t;
+
+/*! @struct miopenStatistics_t
+ * @brief Process-wide statistics of the database lookups, kernel compilations and the
+ * immediate mode fallbacks
+ */
+typedef struct
+{
+    miopenDbStatistics_t findDb;            /*!< Find-db lookups */
+    miopenDbStatistics_t perfDb;            /*!< Perf-db lookups */
+    miopenDbStatistics_t kernDb;            /*!< Kernel cache lookups */
+    miopenLatencyStatistics_t kernelStores; /*!< Kernels saved to the kernel cache */
+    miopenLatencyStatistics_t compilations; /*!< Kernels compiled */
+    uint64_t fallbackAi;                    /*!< Immediate mode fallbacks to the AI heuristic */
+    uint64_t fallbackNearest;               /*!< Fallbacks to the nearest find-db records */
+    uint64_t fallbackWti;                   /*!< Fallbacks to the WTI estimates */
+    uint64_t fallbackFailed;                /*!< Fallbacks which found no solution */
+} miopenStatistics_t;
+
+/*! @brief Gets the statistics collected since the start of the process or the last reset
+ *
+ * The statistics can also be written as JSON at the exit of the process to the file set by the
+ * MIOPEN_DB_STATISTICS_FILE environment variable.
+ *
+ * @param statistics Pointer to a location where to write the statistics (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetStatistics(miopenStatistics_t* statistics);
+
+/*! @brief Resets the statistics returned by miopenGetStatistics
+ *
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenResetStatistics(void);
+
+/*! @struct miopenHandleCacheStatistics_t
+ * @brief Memory held by the kernel and invoker caches of a handle
+ */
+typedef struct
+{
+    size_t programs;           /*!< Programs in the kernel cache */
+    size_t programBytes;       /*!< Total size of the code objects of the programs */
+    size_t programBudget;      /*!< Limit of programBytes of the unused programs, 0 if unlimited */
+    uint64_t programEvictions; /*!< Programs evicted from the kernel cache */
+    size_t invokers;           /*!< Invokers in the invoker cache */
+    size_t invokerBytes;       /*!< Approximate size of the invoker cache */
+    uint64_t invokerEvictions; /*!< Invokers evicted from the invoker cache */
+} miopenHandleCacheStatistics_t;
+
+/*! @brief Gets the size of the kernel and invoker caches of the handle
+ *
+ * @param handle     MIOpen handle (input)
+ * @param statistics Pointer to a location where to write the statistics (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetHandleCacheStatistics(
+    miopenHandle_t handle, miopenHandleCacheStatistics_t* statistics);
+
+/*! @brief Limits the total size of the code objects of the programs cached by the handle
+ *
+ * Only the programs which are not used by any cached invoker, and not shared with other handles on
+ * the same device, are charged. When the limit is exceeded, the least recently used of them are
+ * released. They are loaded again from the kernel cache on disk when needed. The default limit is
+ * set by the MIOPEN_DEBUG_PROGRAM_CACHE_BUDGET_MB environment variable.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param bytes      Limit in bytes, 0 if unlimited (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetProgramCacheBudget(miopenHandle_t handle, size_t bytes);
+#endif
+
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -5487,6 +5588,79 @@ miopenCreateActivationProblem(miopenProblem_t* problem,
                               miopenActivationDescriptor_t operatorDesc,
                               miopenProblemDirection_t direction);
 
+/*! @struct miopenPrewarmTimings_t
+ * @brief Phases of miopenPrewarmProblems, times are in milliseconds
+ *
+ * Kernel db lookup, decompression and module load times are summed over the threads which load
+ * the kernels in parallel.
+ */
+typedef struct
+{
+    size_t problems;    /*!< Problems which solutions have been prepared */
+    size_t programs;    /*!< Programs loaded into the kernel cache of the handle */
+    float dbLookup;     /*!< Find-db and perf-db lookups of the solutions */
+    float kernelLoad;   /*!< Parallel loading of the programs (wall time) */
+    float kernDbLookup; /*!< Kernel db lookups */
+    float decompress;   /*!< Decompression and verification of the found kernels */
+    float moduleLoad;   /*!< Rest of the program loading, including compilation on a miss */
+    float invokers;     /*!< Preparation of the invokers */
+    float total;        /*!< Total time of the call */
+} miopenPrewarmTimings_t;
+
+/*! @brief Loads the kernels of the problems ahead of their first use.
+ *
+ * Solutions are selected as in the immediate mode, i.e. from the find-db with the fallback to
+ * heuristics. All kernels they need are loaded from the kernel cache (or compiled if missing) in
+ * parallel and the invokers are prepared, so that the first call for each of the problems on this
+ * handle does not have to. Problems which have already been used on the handle are skipped.
+ * Only convolution problems are supported.
+ *
+ * @param handle      Handle to load the kernels to
+ * @param numProblems Number of the problems
+ * @param problems    Problems to load the kernels of
+ * @param timings     Pointer to a location where to write the timings of the phases. May be null
+ * @return            miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenPrewarmProblems(miopenHandle_t handle,
+                                                   size_t numProblems,
+                                                   const miopenProblem_t* problems,
+                                                   miopenPrewarmTimings_t* timings);
+
+/*! @struct miopenTuningCostModel_t
+ * @brief Costs used by miopenPlanTuning to estimate the tuning time, in milliseconds
+ */
+typedef struct
+{
+    float compileMs; /*!< Build of one program */
+    float measureMs; /*!< Measurement of one config, including the warm-up run */
+} miopenTuningCostModel_t;
+
+/*! @brief Estimates the cost of tuning the problems without compiling or running any kernel.
+ *
+ * Enumerates the search spaces of all convolution solvers applicable to each of the problems and
+ * writes them as JSON: per problem and solver, the applicability, the sizes of the primary and
+ * spare config spaces, the number of configs which would be measured, the number of distinct
+ * kernel builds and the estimated tuning time. Can be used on the HIPNOGPU backend. The limits
+ * set by MIOPEN_DEBUG_TUNING_ITERATIONS_MAX, MIOPEN_TUNING_TIME_MS_MAX and
+ * MIOPEN_COMPILE_PARALLEL_LEVEL are taken into account. Only convolution problems are supported.
+ *
+ * @param handle      Handle to plan the tuning for
+ * @param numProblems Number of the problems
+ * @param problems    Problems to plan the tuning of
+ * @param model       Costs of a build and a measurement. May be null to use the defaults of 1000 ms
+ *                    and 10 ms
+ * @param json        Buffer to write the null-terminated JSON to. May be null to query the size
+ * @param jsonSize    Size of the buffer (input) and of the JSON including the terminating null
+ *                    (output)
+ * @return            miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenPlanTuning(miopenHandle_t handle,
+                                              size_t numProblems,
+                                              const miopenProblem_t* problems,
+                                              const miopenTuningCostModel_t* model,
+                                              char* json,
+                                              size_t* jsonSize);
+
 #endif
 
 /** @} */
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/invoker_cache.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Measures the per call cost of the immediate mode steps which depend on the keys of the
+/// convolution problem: the problem is built from the descriptors, its network config is
+/// looked up in the invoker cache and its db key in an in-memory db. The keys formatted on every
+/// call are compared with the keys found by the problem fingerprint, e.g.:
+///   speedtest_conv_problem_keys --problems 50 --iterations 1000000
+namespace miopen {
+namespace conv_problem_keys {
+
+struct Descriptors
+{
+    TensorDescriptor in;
+    TensorDescriptor weights;
+    TensorDescriptor out;
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(problems, "problems");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        // Various ResNet-like layers.
+        for(auto i = 0; i < problems; ++i)
+        {
+            const auto channels = 64 << (i % 4);
+            const auto size     = 56 >> (i % 4);
+            const auto batch    = 1 << (i % 7);
+            auto in = TensorDescriptor{miopenHalf, {batch, channels, size, size}};
+            auto weights =
+                TensorDescriptor{miopenHalf, {channels * (1 + i % 3), channels, 3, 3}};
+            auto out = conv.GetForwardOutputTensor(in, weights);
+            descriptors.push_back({std::move(in), std::move(weights), std::move(out)});
+        }
+
+        debug::conv_problem_keys_cache_enabled = false;
+        Prepare();
+        const auto text_time = Test();
+        debug::conv_problem_keys_cache_enabled = true;
+        const auto fingerprint_time = Test();
+
+        std::cout << "Problems: " << problems << ", calls: " << iterations << std::endl;
+        std::cout << "Formatted keys: " << text_time << " ns per call" << std::endl;
+        std::cout << "Keys by fingerprint: " << fingerprint_time << " ns per call" << std::endl;
+    }
+
+private:
+    int problems   = 50;
+    int iterations = 1000000;
+    ConvolutionDescriptor conv{{1, 1}, {1, 1}, {1, 1}};
+    std::vector<Descriptors> descriptors;
+    InvokerCache invokers;
+    std::unordered_map<std::string, int> db;
+    const std::string solver = "ConvBinWinograd3x3U";
+
+    conv::ProblemDescription MakeProblem(int i) const
+    {
+        const auto& d = descriptors[i % descriptors.size()];
+        return {d.in, d.weights, d.out, conv, conv::Direction::Forward};
+    }
+
+    void Prepare()
+    {
+        for(auto i = 0; i < problems; ++i)
+        {
+            const auto problem = MakeProblem(i);
+            invokers.Register(problem.MakeNetworkConfig(), solver, [](auto&&...) {});
+            db.emplace(DbRecord{problem}.GetKey(), i);
+        }
+    }
+
+    double Test() const
+    {
+        auto found       = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+        {
+            const auto problem = MakeProblem(i);
+            if(invokers.Get(problem.MakeNetworkConfig(), solver))
+                ++found;
+            if(db.find(DbRecord{problem}.GetKey()) != db.end())
+                ++found;
+        }
+        const auto time =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if(found != 2 * iterations)
+            std::cout << "Unexpected misses: " << 2 * iterations - found << std::endl;
+        return time * 1e9 / iterations;
+    }
+};
+
+} // namespace conv_problem_keys
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::conv_problem_keys::SpeedTestDriver>(argc, argv);
+    return 0;
+}
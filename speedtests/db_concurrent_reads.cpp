@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/ramdb.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Measures the throughput of concurrent lookups in the cached in-process dbs, e.g.:
+///   speedtest_db_concurrent_reads --threads 32 --records 1000 --iterations 100000
+/// Each lookup gets the db from the GetCached() registry and finds a record in it, as every
+/// convolution call does with the find-db and the perf-db. With non-blocking reads the
+/// throughput is expected to grow with the number of threads.
+namespace miopen {
+namespace db_concurrent_reads {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(threads, "threads");
+        add(records, "records");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        const auto temp = TempFile{"db-concurrent-reads-speedtest"};
+        const auto path = temp.Path();
+        const auto keys = WriteDb(path);
+
+        std::cout << std::setw(8) << "Threads" << std::setw(24) << "RamDb lookups/s"
+                  << std::setw(24) << "ReadonlyRamDb lookups/s" << std::endl;
+
+        for(auto count = 1;; count = std::min(count * 2, threads))
+        {
+            const auto ram = Measure(count, keys, [&](const std::string& key) {
+                return static_cast<bool>(RamDb::GetCached(path, false).FindRecord(key));
+            });
+            const auto readonly = Measure(count, keys, [&](const std::string& key) {
+                return ReadonlyRamDb::GetCached(path, false).GetRecord(key) != nullptr;
+            });
+
+            std::cout << std::setw(8) << count << std::setw(24) << std::fixed
+                      << std::setprecision(0) << ram << std::setw(24) << readonly << std::endl;
+
+            if(count >= threads)
+                break;
+        }
+    }
+
+private:
+    int threads    = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int records    = 1000;
+    int iterations = 100000;
+
+    std::vector<std::string> WriteDb(const std::string& path) const
+    {
+        auto keys = std::vector<std::string>{};
+        {
+            auto file = std::ofstream{path};
+            for(auto i = 0; i < records; ++i)
+            {
+                keys.push_back("1-" + std::to_string(i) + "-3x3-64-1x1-0x0-1x1-0-NCHW-FP32-F");
+                file << keys.back() << "=ConvSolver:" << i << ",1,1,0.5,Kernel,LocalSize,Params\n";
+            }
+        }
+        auto time_file = std::ofstream{RamDb::GetTimeFilePath(path)};
+        time_file << ramdb_clock::now().time_since_epoch().count();
+        return keys;
+    }
+
+    /// Returns the total number of lookups per second made by all the threads.
+    template <class TLookup>
+    double Measure(int count, const std::vector<std::string>& keys, const TLookup& lookup) const
+    {
+        auto workers     = std::vector<std::thread>{};
+        auto found       = std::vector<int>(count);
+        const auto start = std::chrono::steady_clock::now();
+
+        for(auto id = 0; id < count; ++id)
+            workers.emplace_back([&, id]() {
+                auto local = 0;
+                for(auto i = 0; i < iterations; ++i)
+                    if(lookup(keys[(i + id) % keys.size()]))
+                        ++local;
+                found[id] = local;
+            });
+        for(auto& worker : workers)
+            worker.join();
+
+        const auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+        if(std::any_of(found.begin(), found.end(), [&](auto n) { return n != iterations; }))
+            std::cerr << "Some records have not been found." << std::endl;
+        return count * static_cast<double>(iterations) / time.count();
+    }
+};
+
+} // namespace db_concurrent_reads
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::db_concurrent_reads::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,374 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/readonlymappeddb.hpp>
+#include <miopen/readonlyramdb.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/// Compares cold-start time and resident memory of the system find-db backends.
+/// Every backend instance is cached per process, so run the test once per mode, e.g.:
+///   speedtest_find_db_load --db src/kernels/gfx906_60.HIP.fdb.txt --mode text
+///   speedtest_find_db_load --db src/kernels/gfx906_60.HIP.fdb.txt --mode binary
+/// The binary mode maps <db>.bin if it exists (see fdb_convert), otherwise it builds the
+/// image in memory. The shared mode is the binary one with MIOPEN_FIND_DB_SHARED_MEMORY
+/// enabled, it only differs when <db>.bin does not exist.
+///
+/// With --processes N the db is loaded by N processes started at once, as the ranks on a node
+/// do, and their aggregate proportional memory (shared pages are split between the processes
+/// sharing them) is reported along with the load times:
+///   speedtest_find_db_load --db src/kernels/gfx906_60.HIP.fdb.txt --mode shared --processes 8
+///
+/// The text mode reads the db file and indexes the text in place. The embedded mode indexes the
+/// copy of the db embedded into the library instead, so it is available in MIOPEN_EMBED_DB builds
+/// only (the file is still read for the keys to look up). The copy mode loads the file the way
+/// the text mode did before, with a copy of the whole text in a stream and a string for every key
+/// and payload, to compare startup time and peak memory against it.
+namespace miopen {
+namespace find_db_load {
+
+static double GetResidentMb()
+{
+    auto statm    = std::ifstream{"/proc/self/statm"};
+    auto size     = 0ull;
+    auto resident = 0ull;
+    statm >> size >> resident;
+    return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024. * 1024.);
+}
+
+static double GetProportionalMb()
+{
+    auto smaps = std::ifstream{"/proc/self/smaps_rollup"};
+    auto line  = std::string{};
+    while(std::getline(smaps, line))
+        if(line.compare(0, 4, "Pss:") == 0)
+            return std::stod(line.substr(4)) / 1024.;
+    return 0;
+}
+
+static double GetPeakResidentMb()
+{
+    auto status = std::ifstream{"/proc/self/status"};
+    auto line   = std::string{};
+    while(std::getline(status, line))
+        if(line.compare(0, 6, "VmHWM:") == 0)
+            return std::stod(line.substr(6)) / 1024.;
+    return 0;
+}
+
+struct CopiedDb
+{
+    std::unordered_map<std::string, std::string> cache;
+
+    /// Payloads are not parsed, so only the load time and memory are comparable.
+    const std::string* FindRecord(const std::string& key) const
+    {
+        const auto it = cache.find(key);
+        return it == cache.end() ? nullptr : &it->second;
+    }
+};
+
+static CopiedDb LoadCopies(const std::string& path)
+{
+    auto file = std::ifstream{path};
+    auto text = std::ostringstream{};
+    text << file.rdbuf();
+
+    auto db     = CopiedDb{};
+    auto stream = std::stringstream{text.str()};
+    auto line   = std::string{};
+
+    while(std::getline(stream, line))
+    {
+        const auto key_size = line.find('=');
+        if(key_size != std::string::npos && key_size != 0)
+            db.cache.emplace(line.substr(0, key_size), line.substr(key_size + 1));
+    }
+
+    return db;
+}
+
+static std::vector<std::string> ReadKeys(const std::string& path)
+{
+    auto file = std::ifstream{path};
+    auto keys = std::vector<std::string>{};
+    auto line = std::string{};
+
+    while(std::getline(file, line))
+    {
+        const auto key_size = line.find('=');
+        if(key_size != std::string::npos && key_size != 0)
+            keys.push_back(line.substr(0, key_size));
+    }
+
+    return keys;
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(db_path, "db");
+        add(mode, "mode");
+        add(iterations, "iterations");
+        add(processes, "processes");
+    }
+
+    void run()
+    {
+        if(db_path.empty())
+        {
+            std::cerr << "Path to a text find-db is required (--db)." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        if(mode == "shared")
+            debug::find_db_shared_memory_override() = true;
+        if(mode == "text")
+            debug::rordb_embed_fs_override() = true;
+        if(mode == "embedded" && !MIOPEN_EMBED_DB)
+        {
+            std::cerr << "The embedded mode requires a MIOPEN_EMBED_DB build." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        if(processes > 1 && (mode == "text" || mode == "embedded" || mode == "binary" ||
+                             mode == "shared"))
+            TestProcesses();
+        else if(mode == "text" || mode == "embedded")
+            Test(
+                [&]() -> const auto& { return ReadonlyRamDb::GetCached(db_path, true); },
+                [](const auto& db) { return db.GetCacheMap().size(); });
+        else if(mode == "copy")
+            Test(
+                [&]() -> const auto& {
+                    static const auto db = LoadCopies(db_path);
+                    return db;
+                },
+                [](const auto& db) { return db.cache.size(); });
+        else if(mode == "binary" || mode == "shared")
+            Test(
+                [&]() -> const auto& { return ReadonlyMappedDb::GetCached(db_path, true); },
+                [](const auto& db) { return db.GetSize(); });
+        else
+        {
+            std::cerr << "Unknown mode: " << mode << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Permitted modes: text, embedded, copy, binary, shared" << std::endl;
+    }
+
+private:
+    std::string db_path;
+    std::string mode = "text";
+    int iterations   = 10;
+    int processes    = 1;
+
+    std::size_t Load() const
+    {
+        if(mode == "text" || mode == "embedded")
+            return ReadonlyRamDb::GetCached(db_path, true).GetCacheMap().size();
+        return ReadonlyMappedDb::GetCached(db_path, true).GetSize();
+    }
+
+    /// Each child reports "<load time> <proportional memory> <resident memory>" once all the
+    /// children have loaded the db, so the shared pages are split between all of them.
+    [[noreturn]] void RunChild(int loaded_fd, int start_fd, int result_fd) const
+    {
+        const auto pss_before = GetProportionalMb();
+        const auto rss_before = GetResidentMb();
+        const auto start      = std::chrono::steady_clock::now();
+        const auto records    = Load();
+        const auto load_time  = std::chrono::duration<double, std::milli>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+
+        auto byte = char{0};
+        if(write(loaded_fd, &byte, 1) != 1 || read(start_fd, &byte, 1) < 0)
+            _exit(1);
+
+        auto result = std::ostringstream{};
+        result << load_time << ' ' << GetProportionalMb() - pss_before << ' '
+               << GetResidentMb() - rss_before << ' ' << records << '\n';
+        const auto str = result.str();
+        _exit(write(result_fd, str.data(), str.size()) == static_cast<ssize_t>(str.size()) ? 0
+                                                                                          : 1);
+    }
+
+    void TestProcesses() const
+    {
+        int loaded[2];
+        int start[2];
+        int results[2];
+        if(pipe(loaded) != 0 || pipe(start) != 0 || pipe(results) != 0)
+        {
+            std::cerr << "Unable to create pipes." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        auto children = std::vector<pid_t>{};
+        for(auto i = 0; i < processes; ++i)
+        {
+            const auto pid = fork();
+            if(pid == 0)
+            {
+                close(start[1]);
+                RunChild(loaded[1], start[0], results[1]);
+            }
+            children.push_back(pid);
+        }
+
+        close(loaded[1]);
+        close(start[0]);
+        close(results[1]);
+
+        // All the children keep their dbs loaded until the last one is done.
+        auto byte = char{0};
+        for(auto i = 0; i < processes; ++i)
+            if(read(loaded[0], &byte, 1) != 1)
+                break;
+        close(start[1]);
+
+        auto output = std::string{};
+        auto buffer = std::vector<char>(4096);
+        for(auto size = read(results[0], buffer.data(), buffer.size()); size > 0;
+            size      = read(results[0], buffer.data(), buffer.size()))
+            output.append(buffer.data(), size);
+        for(const auto pid : children)
+            waitpid(pid, nullptr, 0);
+
+        auto input     = std::istringstream{output};
+        auto reported  = 0;
+        auto max_time  = 0.;
+        auto sum_time  = 0.;
+        auto total_pss = 0.;
+        auto total_rss = 0.;
+        auto records   = std::size_t{0};
+        auto time      = 0.;
+        auto pss       = 0.;
+        auto rss       = 0.;
+
+        while(input >> time >> pss >> rss >> records)
+        {
+            ++reported;
+            max_time = std::max(max_time, time);
+            sum_time += time;
+            total_pss += pss;
+            total_rss += rss;
+        }
+
+        std::cout << "Mode: " << mode << std::endl;
+        std::cout << "Processes: " << reported << " of " << processes << std::endl;
+        std::cout << "Records: " << records << std::endl;
+        std::cout << "Load time: " << (reported > 0 ? sum_time / reported : 0) << " ms average, "
+                  << max_time << " ms max" << std::endl;
+        std::cout << "Aggregate PSS after load: +" << total_pss << " MB" << std::endl;
+        std::cout << "Aggregate RSS after load: +" << total_rss << " MB" << std::endl;
+    }
+
+    static double PerLookupNs(double time, unsigned long long count)
+    {
+        return count > 0 ? time * 1e9 / count : 0;
+    }
+
+    template <class TDb>
+    static double TimeLookups(const TDb& db,
+                              const std::vector<std::string>& keys,
+                              int passes,
+                              unsigned long long& found)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < passes; ++i)
+            for(const auto& key : keys)
+                if(db.FindRecord(key))
+                    ++found;
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count() *
+               .001 * .001;
+    }
+
+    template <class TLoad, class TSize>
+    void Test(const TLoad& load, const TSize& get_size) const
+    {
+        const auto rss_before = GetResidentMb();
+        const auto start      = std::chrono::steady_clock::now();
+        const auto& db        = load();
+        const auto load_time  = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count() *
+                               .001;
+        const auto rss_loaded = GetResidentMb();
+        const auto rss_peak   = GetPeakResidentMb();
+
+        const auto keys = ReadKeys(db_path);
+        auto found      = 0ull;
+
+        // The first pass includes one-time costs (e.g. parsing of payloads which are cached
+        // afterwards), so it is reported separately from the steady-state lookups.
+        const auto first_time = TimeLookups(db, keys, 1, found);
+        const auto first_found = found;
+        const auto warm_time  = TimeLookups(db, keys, iterations, found);
+
+        std::cout << "Mode: " << mode << std::endl;
+        std::cout << "Records: " << get_size(db) << std::endl;
+        std::cout << "Load time: " << load_time << " ms" << std::endl;
+        std::cout << "RSS after load: +" << rss_loaded - rss_before << " MB" << std::endl;
+        std::cout << "Peak RSS during load: +" << rss_peak - rss_before << " MB" << std::endl;
+        std::cout << "RSS after lookups: +" << GetResidentMb() - rss_before << " MB" << std::endl;
+        std::cout << "First lookups: " << first_found << " in " << first_time << " s ("
+                  << PerLookupNs(first_time, first_found) << " ns per lookup)" << std::endl;
+        std::cout << "Repeated lookups: " << found - first_found << " in " << warm_time << " s ("
+                  << PerLookupNs(warm_time, found - first_found) << " ns per lookup)" << std::endl;
+    }
+};
+
+} // namespace find_db_load
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::find_db_load::SpeedTestDriver>(argc, argv);
+    return 0;
+}
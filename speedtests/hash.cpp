@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/md5.hpp>
+#include <miopen/xxhash.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Compares throughput of the hashes used for kernel db verification and cache keys, e.g.:
+///   speedtest_hash --size 262144 --iterations 100
+/// Sizes of the order of a kernel binary show the verification cost, short strings the cost
+/// of cache keys.
+namespace miopen {
+namespace hash {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(size, "size");
+        add(iterations, "iterations");
+    }
+
+    void run() const
+    {
+        auto gen  = std::mt19937{};
+        auto data = std::string(size, '\0');
+        for(auto& c : data)
+            c = static_cast<char>(gen());
+
+        Test("md5", data, [](const std::string& s) { return md5(s); });
+        Test("xxhash64", data, [](const std::string& s) { return xxhash64(s); });
+        Test("xxh3_128", data, [](const std::string& s) { return xxh3_128(s); });
+    }
+
+private:
+    int size       = 256 * 1024;
+    int iterations = 100;
+
+    template <class THash>
+    void Test(const char* name, const std::string& data, const THash& hash) const
+    {
+        auto checksum    = std::size_t{0};
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+            checksum += hash(data).size();
+        const auto time =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << name << ": " << iterations << " x " << data.size() << " bytes in " << time
+                  << " s (" << time * 1e9 / iterations << " ns per hash, "
+                  << data.size() * static_cast<double>(iterations) / time / (1024. * 1024.)
+                  << " MiB/s)" << std::endl;
+        if(checksum == 0)
+            std::cout << "Unexpected empty hash" << std::endl;
+    }
+};
+
+} // namespace hash
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::hash::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+
+#include <driver.hpp>
+
+#include <iostream>
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/// Compares load latency and on-disk size of the kernel db with different codecs, e.g.:
+///   bunzip2 -k src/kernels/gfx90a.kdb.bz2
+///   speedtest_kern_db_codec --db src/kernels/gfx90a.kdb
+/// All kernels of the db are written to a temporary db with each codec, then read back by a
+/// fresh db instance as a cold start would do.
+namespace miopen {
+namespace kern_db_codec {
+
+static double Seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(db_path, "db");
+        add(kernels, "kernels");
+    }
+
+    void run() const
+    {
+        if(db_path.empty())
+        {
+            std::cerr << "Path to an unpacked kernel db is required (--db)." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        const auto configs = ReadKernels();
+        auto total_size    = std::size_t{0};
+        for(const auto& config : configs)
+            total_size += config.kernel_blob.size();
+        std::cout << "Kernels: " << configs.size() << " (" << total_size / 1024 << " KiB)"
+                  << std::endl;
+        std::cout << "Source db: " << boost::filesystem::file_size(db_path) / 1024 << " KiB"
+                  << std::endl;
+
+        Test(configs, "none", KernDbCodec::None);
+        Test(configs, "bzip2", KernDbCodec::Bzip2);
+#if MIOPEN_USE_ZSTD
+        Test(configs, "zstd", KernDbCodec::Zstd);
+#endif
+    }
+
+private:
+    std::string db_path;
+    int kernels = 1000;
+
+    std::vector<KernelConfig> ReadKernels() const
+    {
+        auto db      = KernDb{db_path, true};
+        auto configs = std::vector<KernelConfig>{};
+        const auto query =
+            "SELECT kernel_name, kernel_args FROM kern_db LIMIT " + std::to_string(kernels) + ";";
+
+        for(const auto& row : db.sql.Exec(query))
+        {
+            auto config        = KernelConfig{};
+            config.kernel_name = row.at("kernel_name");
+            config.kernel_args = row.at("kernel_args");
+            config.kernel_blob = db.FindRecordUnsafe(config).value();
+            configs.push_back(std::move(config));
+        }
+
+        return configs;
+    }
+
+    static void Test(const std::vector<KernelConfig>& configs, const char* name, KernDbCodec codec)
+    {
+        const auto temp = TempFile{"kern-db-codec-speedtest"};
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            auto db = KernDb{temp.Path(), false, codec};
+            db.sql.Exec("BEGIN;");
+            for(const auto& config : configs)
+                db.StoreRecordUnsafe(config);
+            db.sql.Exec("COMMIT;");
+        }
+        const auto store_time = Seconds(start);
+        const auto size       = boost::filesystem::file_size(temp.Path());
+
+        start      = std::chrono::steady_clock::now();
+        auto db    = KernDb{temp.Path(), false, codec};
+        auto found = 0ull;
+        for(const auto& config : configs)
+            if(db.FindRecordUnsafe(config))
+                ++found;
+        const auto load_time = Seconds(start);
+
+        std::cout << name << ": " << size / 1024 << " KiB, stored in " << store_time
+                  << " s, loaded " << found << " in " << load_time << " s ("
+                  << load_time * 1e6 / std::max(found, 1ull) << " us per kernel)" << std::endl;
+    }
+};
+
+} // namespace kern_db_codec
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kern_db_codec::SpeedTestDriver>(argc, argv);
+    return 0;
+}
+#else
+int main()
+{
+    std::cout << "SQLite kernel cache is disabled" << std::endl;
+    return 0;
+}
+#endif
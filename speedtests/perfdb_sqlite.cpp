@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+
+#include <driver.hpp>
+
+#include <iostream>
+
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <chrono>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// Measures lookup and tuning write throughput of SQLitePerfDb, e.g.:
+///   bunzip2 -k src/kernels/gfx906_60.db.bz2
+///   speedtest_perfdb_sqlite --db src/kernels/gfx906_60.db --lookups 1000 --writes 1000
+/// Rows of the config table of the db are looked up, then the same rows are written to a
+/// temporary user db one by one, and in batches as the tuning does.
+namespace miopen {
+namespace perfdb_sqlite {
+
+/// Problem config read back from the config table, so the test does not depend on how the
+/// problem descriptions are serialized.
+struct ConfigRow
+{
+    std::vector<std::pair<std::string, std::string>> fields;
+
+    static std::string table_name() { return "config"; }
+
+    std::tuple<std::string, std::vector<std::string>> WhereClause() const
+    {
+        auto clauses = std::vector<std::string>{};
+        auto values  = std::vector<std::string>{};
+        for(const auto& field : fields)
+        {
+            clauses.push_back("(" + field.first + " = ? )");
+            values.push_back(field.second);
+        }
+        return std::make_tuple(JoinStrings(clauses, " AND "), values);
+    }
+
+    std::tuple<std::string, std::vector<std::string>> InsertQuery() const
+    {
+        auto names  = std::vector<std::string>{};
+        auto values = std::vector<std::string>{};
+        for(const auto& field : fields)
+        {
+            names.push_back(field.first);
+            values.push_back(field.second);
+        }
+        const auto tokens = std::vector<std::string>(values.size(), "?");
+        return std::make_tuple("INSERT OR IGNORE INTO " + table_name() + "( " +
+                                   JoinStrings(names, ",") + " ) VALUES( " +
+                                   JoinStrings(tokens, ",") + ");",
+                               values);
+    }
+};
+
+struct TestValue
+{
+    int value;
+
+    void Serialize(std::ostream& stream) const { stream << value << ",0,0,0"; }
+};
+
+static double Seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(db_path, "db");
+        add(lookups, "lookups");
+        add(writes, "writes");
+        add(batch_size, "batch-size");
+    }
+
+    void run() const
+    {
+        if(db_path.empty())
+        {
+            std::cerr << "Path to an unpacked system perf-db is required (--db)." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        auto db         = SQLitePerfDb{db_path, true};
+        const auto rows = ReadRows(db);
+        std::cout << "Configs: " << rows.size() << std::endl;
+
+        TestLookups(db, rows);
+        TestWrites(rows, 1);
+        TestWrites(rows, batch_size);
+    }
+
+private:
+    std::string db_path;
+    int lookups    = 1000;
+    int writes     = 1000;
+    int batch_size = 50;
+
+    static std::vector<ConfigRow> ReadRows(SQLitePerfDb& db)
+    {
+        auto rows = std::vector<ConfigRow>{};
+        for(const auto& result : db.sql.Exec("SELECT * FROM config;"))
+        {
+            auto row = ConfigRow{};
+            for(const auto& field : result)
+                if(field.first != "id")
+                    row.fields.emplace_back(field);
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+    void TestLookups(SQLitePerfDb& db, const std::vector<ConfigRow>& rows) const
+    {
+        const auto n     = std::min<std::size_t>(lookups, rows.size());
+        auto found       = 0ull;
+        const auto start = std::chrono::steady_clock::now();
+
+        for(auto i = 0u; i < n; ++i)
+            if(db.FindRecord(rows[i]))
+                ++found;
+
+        const auto time = Seconds(start);
+        std::cout << "Lookups: " << n << " (" << found << " found) in " << time << " s ("
+                  << n / time << " per second)" << std::endl;
+    }
+
+    void TestWrites(const std::vector<ConfigRow>& rows, int batch) const
+    {
+        const auto temp  = TempFile{"perfdb-sqlite-speedtest"};
+        auto db          = SQLitePerfDb{temp.Path(), false};
+        const auto n     = std::min<std::size_t>(writes, rows.size());
+        const auto start = std::chrono::steady_clock::now();
+
+        for(auto i = 0u; i < n;)
+        {
+            // Without a batch each update is committed on its own.
+            const auto guard = batch > 1 ? db.BeginBatch() : SQLite::Batch{};
+            for(auto j = 0; j < batch && i < n; ++j, ++i)
+                db.Update(rows[i], "Solver" + std::to_string(j), TestValue{static_cast<int>(i)});
+        }
+
+        const auto time = Seconds(start);
+        std::cout << "Writes, batch of " << batch << ": " << n << " in " << time << " s ("
+                  << n / time << " per second)" << std::endl;
+    }
+};
+
+} // namespace perfdb_sqlite
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perfdb_sqlite::SpeedTestDriver>(argc, argv);
+    return 0;
+}
+#else
+int main()
+{
+    std::cout << "SQLite is disabled" << std::endl;
+    return 0;
+}
+#endif
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/batchnorm/problem_description.hpp>
+#include <miopen/invoker_cache.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/pooling/problem_description.hpp>
+#include <miopen/problem_key.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Measures the host cost of finding the kernels or the invoker of a small problem of the
+/// primitives which do not go through the convolution find path. The network configs formatted on
+/// every call are compared with the lookups by ProblemKey, e.g.:
+///   speedtest_primitive_keys --problems 16 --iterations 1000000
+namespace miopen {
+namespace primitive_keys {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(problems, "problems");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        for(auto i = 0; i < problems; ++i)
+        {
+            const auto batch    = 1 + i % 4;
+            const auto channels = 16 << (i % 3);
+            const auto x        = TensorDescriptor{miopenFloat, {batch, channels, 14, 14}};
+            const auto y        = TensorDescriptor{miopenFloat, {batch, channels, 7, 7}};
+            const auto bn       = TensorDescriptor{miopenFloat, {1, channels, 1, 1}};
+            pooling_problems.emplace_back(pooling, x, y, true);
+            batchnorm_problems.emplace_back(miopenBNSpatial, x, x, bn, 1e-5);
+        }
+
+        Report("OpTensor", TestOpTensor(false), TestOpTensor(true));
+        Report("Pooling",
+               TestInvokers(pooling_problems, false),
+               TestInvokers(pooling_problems, true));
+        Report("Batchnorm",
+               TestInvokers(batchnorm_problems, false),
+               TestInvokers(batchnorm_problems, true));
+    }
+
+private:
+    int problems   = 16;
+    int iterations = 1000000;
+    PoolingDescriptor pooling{miopenPoolingMax, miopenPaddingDefault, {2, 2}, {2, 2}, {0, 0}};
+    std::vector<pooling::ProblemDescription> pooling_problems;
+    std::vector<batchnorm::ProblemDescription> batchnorm_problems;
+    const std::string solver = "Solver";
+
+    static void Report(const std::string& primitive, double text_time, double key_time)
+    {
+        std::cout << primitive << ": " << text_time << " ns per call with formatted configs, "
+                  << key_time << " ns with problem keys" << std::endl;
+    }
+
+    template <class Problem>
+    double TestInvokers(const std::vector<Problem>& list, bool use_keys) const
+    {
+        auto invokers         = InvokerCache{};
+        const auto get_config = [&](const Problem& problem) {
+            if(!use_keys)
+                return std::make_shared<const NetworkConfig>(problem.MakeNetworkConfig());
+            return GetNetworkConfig(problem.MakeProblemKey(),
+                                    [&]() { return problem.MakeNetworkConfig(); });
+        };
+
+        for(const auto& problem : list)
+            invokers.Register(problem.MakeNetworkConfig(), solver, [](auto&&...) {});
+
+        return Measure([&](int i) {
+            return static_cast<bool>(invokers.Get(*get_config(list[i % list.size()]), solver));
+        });
+    }
+
+    /// Lookup of the Op2dTensorLite kernel, the way OpTensor does it.
+    double TestOpTensor(bool use_keys) const
+    {
+        auto cache             = KernelCache{};
+        const auto algorithm   = std::string{"Op2dTensorLite"};
+        const auto make_config = [](int i) {
+            const auto channels = 16 << (i % 3);
+            return std::to_string(miopenFloat) + "-" + std::to_string(miopenFloat) + "-" +
+                   std::to_string(miopenTensorOpAdd) + "-" + std::to_string(4) + "x" +
+                   std::to_string(256) + "x" + std::to_string(1) + std::to_string(64) +
+                   std::to_string((channels + 63) / 64);
+        };
+        const auto make_key = [](int i) {
+            const auto channels = 16 << (i % 3);
+            auto key            = ProblemKey{"OpTensor3d"};
+            key.Add(miopenFloat).Add(miopenFloat).Add(miopenTensorOpAdd);
+            key.Add(4).Add(256).Add(1).Add(64).Add((channels + 63) / 64);
+            return key;
+        };
+
+        for(auto i = 0; i < problems; ++i)
+        {
+            cache.AddKernel({algorithm, make_config(i)}, Kernel{}, 0);
+            cache.AddKernel({algorithm, make_key(i).ToString()}, Kernel{}, 0);
+        }
+
+        return Measure([&](int i) {
+            const auto problem = i % problems;
+            if(use_keys)
+                return !cache.GetKernels("Op2dTensorLite", make_key(problem)).empty();
+            return !cache.GetKernels(algorithm, make_config(problem)).empty();
+        });
+    }
+
+    double Measure(const std::function<bool(int)>& call) const
+    {
+        auto found       = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+        {
+            if(call(i))
+                ++found;
+        }
+        const auto time =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if(found != iterations)
+            std::cout << "Unexpected misses: " << iterations - found << std::endl;
+        return time * 1e9 / iterations;
+    }
+};
+
+} // namespace primitive_keys
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::primitive_keys::SpeedTestDriver>(argc, argv);
+    return 0;
+}
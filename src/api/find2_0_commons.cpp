@@ -27,6 +27,8 @@
 #include <miopen/miopen.h>
 
 #include <miopen/common.hpp>
+#include <miopen/conv/prewarm.hpp>
+#include <miopen/conv/tuning_plan.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
@@ -38,6 +40,9 @@
 
 #include <nlohmann/json.hpp>
 
+#include <cstring>
+#include <sstream>
+
 template <class OperationDescriptor>
 static miopenStatus_t MakeProblem(miopenProblem_t* problem,
                                   OperationDescriptor operatorDesc,
@@ -53,6 +58,29 @@ static miopenStatus_t MakeProblem(miopenProblem_t* problem,
     });
 }
 
+static std::vector<miopen::conv::ProblemDescription>
+MakeConvProblems(size_t numProblems, const miopenProblem_t* problems)
+{
+    auto conv_problems = std::vector<miopen::conv::ProblemDescription>{};
+    conv_problems.reserve(numProblems);
+
+    for(std::size_t i = 0; i < numProblems; ++i)
+    {
+        const auto& problem_deref = miopen::deref(problems[i]);
+        const auto conv_desc =
+            boost::get<miopen::ConvolutionDescriptor>(&problem_deref.GetOperatorDescriptor());
+
+        if(conv_desc == nullptr)
+            MIOPEN_THROW(miopenStatusNotImplemented, "Only convolution problems are supported");
+
+        conv_problems.push_back(conv_desc->mode == miopenTranspose
+                                    ? problem_deref.MakeTransposed().AsConvolution()
+                                    : problem_deref.AsConvolution());
+    }
+
+    return conv_problems;
+}
+
 extern "C" {
 miopenStatus_t miopenCreateConvProblem(miopenProblem_t* problem,
                                        miopenConvolutionDescriptor_t operatorDesc,
@@ -344,4 +372,67 @@ miopenStatus_t miopenGetSolverIdConvAlgorithm(uint64_t solverId, miopenConvAlgor
         *result = id_deref.GetAlgo();
     });
 }
+
+miopenStatus_t miopenPrewarmProblems(miopenHandle_t handle,
+                                     size_t numProblems,
+                                     const miopenProblem_t* problems,
+                                     miopenPrewarmTimings_t* timings)
+{
+    MIOPEN_LOG_FUNCTION(handle, numProblems, problems);
+
+    return miopen::try_([&] {
+        const auto conv_problems = MakeConvProblems(numProblems, problems);
+        const auto result        = miopen::conv::Prewarm(miopen::deref(handle), conv_problems);
+
+        if(timings != nullptr)
+        {
+            timings->problems     = result.problems;
+            timings->programs     = result.programs;
+            timings->dbLookup     = result.db_lookup;
+            timings->kernelLoad   = result.kernel_load;
+            timings->kernDbLookup = result.kern_db_lookup;
+            timings->decompress   = result.decompress;
+            timings->moduleLoad   = result.module_load;
+            timings->invokers     = result.invokers;
+            timings->total        = result.total;
+        }
+    });
+}
+
+miopenStatus_t miopenPlanTuning(miopenHandle_t handle,
+                                size_t numProblems,
+                                const miopenProblem_t* problems,
+                                const miopenTuningCostModel_t* model,
+                                char* json,
+                                size_t* jsonSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, numProblems, problems);
+
+    return miopen::try_([&] {
+        if(jsonSize == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "JsonSize parameter should not be a nullptr.");
+
+        const auto conv_problems = MakeConvProblems(numProblems, problems);
+        auto cost_model          = miopen::conv::TuningCostModel{};
+        if(model != nullptr)
+        {
+            cost_model.compile_ms = model->compileMs;
+            cost_model.measure_ms = model->measureMs;
+        }
+
+        const auto plan =
+            miopen::conv::PlanTuning(miopen::deref(handle), conv_problems, cost_model);
+        auto ss = std::ostringstream{};
+        plan.WriteJson(ss);
+        const auto str = ss.str();
+
+        if(json != nullptr)
+        {
+            if(*jsonSize < str.size() + 1)
+                MIOPEN_THROW(miopenStatusBadParm, "JSON buffer is too small.");
+            std::memcpy(json, str.c_str(), str.size() + 1);
+        }
+        *jsonSize = str.size() + 1;
+    });
+}
 }
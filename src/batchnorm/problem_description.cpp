@@ -47,6 +47,15 @@ NetworkConfig ProblemDescription::MakeNetworkConfig() const
     }
 }
 
+ProblemKey ProblemDescription::MakeProblemKey() const
+{
+    auto key = ProblemKey{"Batchnorm"};
+    key.Add(direction).Add(bn_mode);
+    key.Add(xDesc.GetType()).AddRange(xDesc.GetLengths()).Add(scaleBiasDesc.GetType());
+    key.Add(resultsave).Add(resultrunning).Add(useSaved);
+    return key;
+}
+
 NetworkConfig ProblemDescription::MakeForwardTrainingNetworkConfig() const
 {
     std::ostringstream ss;
@@ -25,8 +25,10 @@
  *******************************************************************************/
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/db_stats.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/xxhash.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/env.hpp>
 #include <miopen/stringutils.hpp>
@@ -141,7 +143,7 @@ KDb GetDb(const TargetProperties& target, size_t num_cu)
     if(!boost::filesystem::exists(sys_path))
         sys_path = boost::filesystem::path{};
 #endif
-    return {sys_path.string(), user_path.string()};
+    return {sys_path.string(), user_path.string(), &GetDbStats().kern_db};
 }
 #endif
 
@@ -150,8 +152,8 @@ boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& args,
                                      bool is_kernel_str)
 {
-    const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
-    return GetCachePath(false) / miopen::md5(device + ":" + args) / filename;
+    const std::string filename = (is_kernel_str ? miopen::xxh3_128(name) : name) + ".o";
+    return GetCachePath(false) / miopen::xxh3_128(device + ":" + args) / filename;
 }
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -173,10 +175,15 @@ std::string LoadBinary(const TargetProperties& target,
                        bool is_kernel_str)
 {
     if(miopen::IsCacheDisabled())
+    {
+        // Every kernel is compiled then.
+        GetDbStats().kern_db.Count(false, false, std::chrono::steady_clock::now());
         return {};
+    }
 
     auto db = GetDb(target, num_cu);
 
+    // The names of kernel strings are md5 hashed in the system kernel dbs.
     const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
     const KernelConfig cfg{filename, args, ""};
 
@@ -205,7 +212,8 @@ void SaveBinary(const std::string& hsaco,
     if(miopen::IsCacheDisabled())
         return;
 
-    auto db = GetDb(target, num_cu);
+    const auto start = std::chrono::steady_clock::now();
+    auto db          = GetDb(target, num_cu);
 
     const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
     KernelConfig cfg{filename, args, hsaco};
@@ -213,6 +221,7 @@ void SaveBinary(const std::string& hsaco,
     const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
     MIOPEN_LOG_I2("Saving binary for: " << verbose_name << "; args: " << args);
     db.StoreRecord(cfg);
+    GetDbStats().kernel_stores.AddSince(start);
 }
 #else
 boost::filesystem::path LoadBinary(const TargetProperties& target,
@@ -221,17 +230,23 @@ boost::filesystem::path LoadBinary(const TargetProperties& target,
                                    const std::string& args,
                                    bool is_kernel_str)
 {
+    const auto start = std::chrono::steady_clock::now();
     if(miopen::IsCacheDisabled())
+    {
+        GetDbStats().kern_db.Count(false, false, start);
         return {};
+    }
 
     (void)num_cu;
     auto f = GetCacheFile(target.DbId(), name, args, is_kernel_str);
     if(boost::filesystem::exists(f))
     {
+        GetDbStats().kern_db.Count(true, false, start);
         return f.string();
     }
     else
     {
+        GetDbStats().kern_db.Count(false, false, start);
         return {};
     }
 }
@@ -248,9 +263,11 @@ void SaveBinary(const boost::filesystem::path& binary_path,
     }
     else
     {
-        auto p = GetCacheFile(target.DbId(), name, args, is_kernel_str);
+        const auto start = std::chrono::steady_clock::now();
+        auto p           = GetCacheFile(target.DbId(), name, args, is_kernel_str);
         boost::filesystem::create_directories(p.parent_path());
         boost::filesystem::rename(binary_path, p);
+        GetDbStats().kernel_stores.AddSince(start);
     }
 }
 #endif
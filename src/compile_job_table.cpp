@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_job_table.hpp>
+#include <miopen/binary_cache.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/xxhash.hpp>
+
+#include <chrono>
+#include <exception>
+#include <tuple>
+
+namespace miopen {
+
+CompileJobTable& CompileJobTable::Get()
+{
+    static CompileJobTable table;
+    return table;
+}
+
+uint64_t CompileJobTable::MakeKey(const std::string& target,
+                                  const std::string& program_name,
+                                  const std::string& params)
+{
+    auto key = target;
+    key += '\0';
+    key += program_name;
+    key += '\0';
+    key += params;
+    return xxhash64(key.data(), key.size());
+}
+
+void CompileJobTable::Run(uint64_t key, const std::function<void()>& compile, bool remember)
+{
+    auto lock = std::unique_lock<std::mutex>{mutex};
+    ++stats.requested;
+
+    const auto found = jobs.find(key);
+    if(found != jobs.end())
+    {
+        auto job = found->second;
+        if(job.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+            ++stats.skipped;
+        else
+            ++stats.waited;
+        lock.unlock();
+        job.get();
+        return;
+    }
+
+    auto promise = std::promise<void>{};
+    jobs.emplace(key, promise.get_future().share());
+    ++stats.run;
+    lock.unlock();
+
+    try
+    {
+        compile();
+    }
+    catch(...)
+    {
+        lock.lock();
+        jobs.erase(key);
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    lock.lock();
+    promise.set_value();
+    if(!remember)
+        jobs.erase(key);
+    else if(jobs.size() > max_jobs)
+        PruneUnsafe();
+}
+
+void CompileJobTable::PruneUnsafe()
+{
+    MIOPEN_LOG_I2("Pruning " << jobs.size() << " compile jobs");
+    for(auto it = jobs.begin(); it != jobs.end();)
+    {
+        if(it->second.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+            it = jobs.erase(it);
+        else
+            ++it;
+    }
+}
+
+CompileJobTable::Stats CompileJobTable::GetStats() const
+{
+    const auto lock = std::lock_guard<std::mutex>{mutex};
+    return stats;
+}
+
+void CompileJobTable::Clear()
+{
+    const auto lock = std::lock_guard<std::mutex>{mutex};
+    PruneUnsafe();
+    stats = {};
+}
+
+void PrecompileProgram(const Handle& handle,
+                       const std::string& program_name,
+                       const std::string& params)
+{
+    // Without the kernel cache the compiled program is lost as soon as it is released.
+    CompileJobTable::Get().Run(
+        CompileJobTable::MakeKey(handle.GetDbBasename(), program_name, params),
+        [&]() { std::ignore = handle.LoadProgram(program_name, params, false, ""); },
+        !IsCacheDisabled());
+}
+
+} // namespace miopen
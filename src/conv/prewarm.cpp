@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/prewarm.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/config.h>
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/solver_id.hpp>
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+#include <miopen/kern_db.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+float Milliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+float Milliseconds(uint64_t ns) { return static_cast<float>(ns) * 1e-6f; }
+
+struct PreparedProblem
+{
+    const ProblemDescription* problem;
+    NetworkConfig config;
+    solver::Id solver_id;
+    solver::ConvSolution solution;
+};
+
+} // namespace
+
+PrewarmTimings Prewarm(Handle& handle, const std::vector<ProblemDescription>& problems)
+{
+    auto timings     = PrewarmTimings{};
+    const auto start = Clock::now();
+
+    // Solutions are looked up in the find-db (with the fallback to heuristics), and their
+    // parameters in the perf-db, without any search.
+    auto prepared = std::vector<PreparedProblem>{};
+    for(const auto& problem : problems)
+    {
+        auto ctx = ExecutionContext{&handle};
+        problem.SetupFloats(ctx);
+        ctx.do_search              = false;
+        ctx.disable_search_enforce = true;
+
+        auto config          = problem.MakeNetworkConfig();
+        const auto solutions = problem.GetConv().GetSolutions(ctx, problem, 1, nullptr);
+        if(solutions.empty())
+        {
+            MIOPEN_LOG_W("No solutions for " << config.ToString());
+            continue;
+        }
+
+        const auto solver_id = solver::Id{solutions.front().solution_id};
+        if(handle.GetInvoker(config, solver_id))
+            continue;
+
+        auto db       = GetDb(ctx);
+        auto solution = solver_id.GetSolver().FindSolution(ctx, problem, db, {});
+        if(!solution.Succeeded() || !solution.invoker_factory)
+        {
+            MIOPEN_LOG_W("Unable to prepare " << solver_id.ToString() << " for "
+                                              << config.ToString());
+            continue;
+        }
+        prepared.push_back({&problem, std::move(config), solver_id, std::move(solution)});
+    }
+    const auto looked_up = Clock::now();
+    timings.db_lookup    = Milliseconds(looked_up - start);
+
+    // Same as PrecompileSolutions(), but with the time of each load measured.
+    auto kernels = std::vector<solver::KernelInfo>{};
+    auto unique  = std::set<std::pair<std::string, std::string>>{};
+    for(const auto& p : prepared)
+    {
+        for(const auto& kernel : p.solution.construction_params)
+        {
+            if(handle.HasProgram(kernel.kernel_file, kernel.comp_options))
+                continue;
+            if(unique.emplace(kernel.kernel_file, kernel.comp_options).second)
+                kernels.push_back(kernel);
+        }
+    }
+
+    auto programs          = std::vector<Program>(kernels.size());
+    auto load_ns           = std::atomic<uint64_t>{0};
+    auto kern_db_lookup_ns = std::atomic<uint64_t>{0};
+    auto decompress_ns     = std::atomic<uint64_t>{0};
+
+    par_for_strided(kernels.size(), max_threads{solver::GetTuningThreadsMax()}, [&](auto i) {
+        const auto& k = kernels[i];
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        // The kernel db times are kept per thread, so only this load is counted.
+        const auto& kern_db_times   = GetKernDbTimes();
+        const auto lookup_start     = kern_db_times.lookup_ns;
+        const auto decompress_start = kern_db_times.decompress_ns;
+#endif
+        const auto load_start = Clock::now();
+        programs[i]           = handle.LoadProgram(k.kernel_file, k.comp_options, false, "");
+        load_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - load_start)
+                       .count();
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        kern_db_lookup_ns += kern_db_times.lookup_ns - lookup_start;
+        decompress_ns += kern_db_times.decompress_ns - decompress_start;
+#endif
+    });
+
+    for(std::size_t i = 0; i < programs.size(); i++)
+        handle.AddProgram(programs[i], kernels[i].kernel_file, kernels[i].comp_options);
+
+    const auto loaded      = Clock::now();
+    timings.programs       = programs.size();
+    timings.kernel_load    = Milliseconds(loaded - looked_up);
+    timings.kern_db_lookup = Milliseconds(kern_db_lookup_ns.load());
+    timings.decompress     = Milliseconds(decompress_ns.load());
+
+    timings.module_load =
+        std::max(Milliseconds(load_ns.load()) - timings.kern_db_lookup - timings.decompress, 0.f);
+
+    for(const auto& p : prepared)
+    {
+        auto invoker =
+            handle.PrepareInvoker(*p.solution.invoker_factory, p.solution.construction_params);
+        const auto algo = AlgorithmName{p.solver_id.GetAlgo(p.problem->GetDirection())};
+        handle.RegisterInvoker(invoker, p.config, p.solver_id.ToString(), algo);
+    }
+    timings.problems = prepared.size();
+    timings.invokers = Milliseconds(Clock::now() - loaded);
+    timings.total    = Milliseconds(Clock::now() - start);
+
+    MIOPEN_LOG_I("Prewarmed " << timings.problems << " problems, " << timings.programs
+                              << " programs in " << timings.total << " ms");
+    return timings;
+}
+
+} // namespace conv
+} // namespace miopen
@@ -31,11 +31,21 @@
 #include <miopen/datatype.hpp>
 #include <miopen/execution_context.hpp>
 #include <miopen/tensor_layout.hpp>
+#include <miopen/xxhash.hpp>
 
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
 
 namespace miopen {
 
+namespace debug {
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+bool conv_problem_keys_cache_enabled = true;
+
+} // namespace debug
+
 std::string
 EncodeDataTypesForKey(miopenDataType_t in, miopenDataType_t weights, miopenDataType_t out)
 {
@@ -63,6 +73,56 @@ std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)
     return stream;
 }
 
+int64_t EncodeLayout(const std::string& layout)
+{
+    // Layouts are up to 5 letters long, so they fit as is. Longer ones are hashed.
+    if(layout.size() > sizeof(int64_t))
+        return static_cast<int64_t>(xxhash64(layout.data(), layout.size()));
+    auto value = int64_t{0};
+    std::memcpy(&value, layout.data(), layout.size());
+    return value;
+}
+
+int64_t EncodeCastType(const std::optional<miopenDataType_t>& type)
+{
+    return type ? static_cast<int64_t>(*type) : -1;
+}
+
+struct ProblemKeys
+{
+    ProblemDescription::Encoding encoding;
+    std::string network_config;
+    uint64_t network_config_hash;
+    std::string key;
+};
+
+constexpr std::size_t max_cached_problem_keys = 1024;
+
+/// Immediate mode calls are usually repeated with the same few problems, so their text keys are
+/// kept per thread (no locks are taken) and looked up by the fingerprint. The full encodings are
+/// compared, so a fingerprint collision only costs formatting of the keys again.
+template <class TFormatConfig, class TFormatKey>
+const ProblemKeys& GetProblemKeys(const ProblemDescription& problem,
+                                  const TFormatConfig& format_config,
+                                  const TFormatKey& format_key)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    thread_local auto cache = std::unordered_map<uint64_t, ProblemKeys>{};
+
+    const auto found = cache.find(problem.GetFingerprint());
+    if(found != cache.end() && found->second.encoding == problem.GetEncoding())
+        return found->second;
+    if(found == cache.end() && cache.size() >= max_cached_problem_keys)
+        cache.clear();
+
+    auto& keys               = cache[problem.GetFingerprint()];
+    keys.encoding            = problem.GetEncoding();
+    keys.network_config      = format_config();
+    keys.network_config_hash = xxhash64(keys.network_config.data(), keys.network_config.size());
+    keys.key                 = format_key();
+    return keys;
+}
+
 } // namespace
 
 std::string ProblemDescription::GetDirectionStr() const
@@ -97,13 +157,84 @@ void ProblemDescription::HeuristicUpdateLayouts()
             in_layout      = layout;
             weights_layout = layout;
             out_layout     = layout;
-            return;
+            break;
         }
     }
     // If we did not find consistent layout, leave them as-is
+
+    UpdateFingerprint();
+}
+
+void ProblemDescription::UpdateFingerprint()
+{
+    const auto spatial_dims = GetSpatialDims();
+    const auto has_dims     = [&](const auto& values, std::size_t count) {
+        return values.size() >= count;
+    };
+
+    // Invalid problems are rejected later, the text keys of them are not cached.
+    if(!has_dims(in.GetLengths(), spatial_dims + 2) ||
+       !has_dims(weights.GetLengths(), spatial_dims + 2) ||
+       !has_dims(out.GetLengths(), spatial_dims + 2) ||
+       !has_dims(conv.GetConvPads(), spatial_dims) ||
+       !has_dims(conv.GetConvStrides(), spatial_dims) ||
+       !has_dims(conv.GetConvDilations(), spatial_dims))
+    {
+        encoding    = {};
+        fingerprint = 0;
+        return;
+    }
+
+    // clang-format off
+    encoding = {
+        spatial_dims,
+        GetInBatchSize_(), GetInChannels_(), GetInDepth_(), GetInHeight_(), GetInWidth_(),
+        GetWeightsDepth_(), GetWeightsHeight_(), GetWeightsWidth_(),
+        GetOutChannels_(), GetOutDepth_(), GetOutHeight_(), GetOutWidth_(),
+        GetPadD(), GetPadH(), GetPadW(),
+        GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW(),
+        GetDilationD(), GetDilationH(), GetDilationW(),
+        GetGroupCount(), GetBias(), static_cast<int64_t>(direction),
+        static_cast<int64_t>(GetInDataType()),
+        static_cast<int64_t>(GetWeightsDataType()),
+        static_cast<int64_t>(GetOutDataType()),
+        EncodeCastType(GetInCastType()),
+        EncodeCastType(GetWeightsCastType()),
+        EncodeCastType(GetOutCastType()),
+        EncodeLayout(in_layout), EncodeLayout(weights_layout), EncodeLayout(out_layout),
+    };
+    // clang-format on
+    fingerprint = xxhash64(encoding.data(), sizeof(encoding));
 }
 
 void ProblemDescription::MakeNetworkConfig(std::string& conf_key) const
+{
+    conf_key = MakeNetworkConfig().ToString();
+}
+
+NetworkConfig ProblemDescription::MakeNetworkConfig() const
+{
+    if(!debug::conv_problem_keys_cache_enabled || fingerprint == 0)
+        return NetworkConfig{FormatNetworkConfig()};
+
+    const auto& keys = GetProblemKeys(
+        *this, [this]() { return FormatNetworkConfig(); }, [this]() { return FormatKey(); });
+    return {keys.network_config, keys.network_config_hash};
+}
+
+std::string ProblemDescription::Serialize() const
+{
+    if(!debug::conv_problem_keys_cache_enabled || fingerprint == 0)
+        return FormatKey();
+
+    return GetProblemKeys(
+               *this, [this]() { return FormatNetworkConfig(); }, [this]() { return FormatKey(); })
+        .key;
+}
+
+void ProblemDescription::Serialize(std::ostream& stream) const { stream << Serialize(); }
+
+std::string ProblemDescription::FormatNetworkConfig() const
 {
     std::ostringstream ss;
 
@@ -148,11 +279,12 @@ void ProblemDescription::MakeNetworkConfig(std::string& conf_key) const
     ss << 'x' << GetGroupCount();
     ss << 'x' << GetDirectionStr();
 
-    conf_key = ss.str();
+    return ss.str();
 }
 
-void ProblemDescription::Serialize(std::ostream& stream) const
+std::string ProblemDescription::FormatKey() const
 {
+    std::ostringstream stream;
     const auto sep = '-';
     // Problem description with default layout
     // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
@@ -201,6 +333,7 @@ void ProblemDescription::Serialize(std::ostream& stream) const
     {
         stream << optional.str();
     }
+    return stream.str();
 }
 
 bool ProblemDescription::IsLayoutDefault() const
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/tuning_plan.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <set>
+#include <utility>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+using Programs = std::set<std::pair<std::string, std::string>>;
+
+nlohmann::json ToJson(const SolverTuningPlan& plan)
+{
+    auto json = nlohmann::json{{"solver", plan.solver}, {"applicable", plan.applicable}};
+    if(!plan.applicable)
+        return json;
+    json["tunable"] = plan.tunable;
+    if(!plan.error.empty())
+        json["error"] = plan.error;
+    if(!plan.tunable || !plan.error.empty())
+        return json;
+    json["primary"]       = plan.primary;
+    json["spare"]         = plan.spare;
+    json["searched"]      = plan.searched;
+    json["kernel_builds"] = plan.kernel_builds;
+    json["estimated_ms"]  = plan.estimated_ms;
+    return json;
+}
+
+nlohmann::json ToJson(const ProblemTuningPlan& plan)
+{
+    auto solvers = nlohmann::json::array();
+    for(const auto& solver : plan.solvers)
+        solvers.push_back(ToJson(solver));
+    return {
+        {"problem", plan.problem},
+        {"kernel_builds", plan.kernel_builds},
+        {"estimated_ms", plan.estimated_ms},
+        {"solvers", solvers},
+    };
+}
+
+} // namespace
+
+void TuningPlan::WriteJson(std::ostream& stream) const
+{
+    auto json_problems = nlohmann::json::array();
+    for(const auto& problem : problems)
+        json_problems.push_back(ToJson(problem));
+    const auto json = nlohmann::json{
+        {"assumptions",
+         {
+             {"compile_ms", model.compile_ms},
+             {"measure_ms", model.measure_ms},
+             {"threads", threads},
+             {"iterations_max", iterations_max},
+             {"time_max_ms", time_max_ms},
+         }},
+        {"kernel_builds", kernel_builds},
+        {"estimated_ms", estimated_ms},
+        {"problems", json_problems},
+    };
+    stream << json.dump(1) << std::endl;
+}
+
+float EstimateTuningTime(std::size_t kernel_builds,
+                         std::size_t searched,
+                         const TuningCostModel& model,
+                         std::size_t threads,
+                         float time_max_ms)
+{
+    // The configs are measured while the compile agents build the next ones, so the search takes
+    // the longer of the two, plus the build of the first batch before anything can be measured.
+    const auto compile =
+        static_cast<float>(kernel_builds) * model.compile_ms / std::max<std::size_t>(threads, 1);
+    const auto measure = static_cast<float>(searched) * model.measure_ms;
+    const auto fill    = kernel_builds != 0 ? model.compile_ms : 0.f;
+    return std::min(std::max(compile, measure) + fill, time_max_ms);
+}
+
+TuningPlan PlanTuning(Handle& handle,
+                      const std::vector<ProblemDescription>& problems,
+                      const TuningCostModel& model)
+{
+    auto plan           = TuningPlan{};
+    plan.model          = model;
+    plan.threads        = std::max<std::size_t>(solver::GetTuningThreadsMax(), 1);
+    plan.iterations_max = solver::GetTuningIterationsMax();
+    plan.time_max_ms    = static_cast<float>(solver::GetTuningTimeMax().count());
+
+    auto all_programs = Programs{};
+    for(const auto& problem : problems)
+    {
+        auto ctx = ExecutionContext{&handle};
+        problem.SetupFloats(ctx);
+        ctx.do_search = false;
+
+        auto problem_plan     = ProblemTuningPlan{};
+        problem_plan.problem  = problem.Serialize();
+        auto problem_programs = Programs{};
+
+        for(const auto& id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+        {
+            const auto solver  = id.GetSolver();
+            auto solver_plan   = SolverTuningPlan{};
+            solver_plan.solver = id.ToString();
+
+            try
+            {
+                solver_plan.applicable = solver.IsApplicable(ctx, problem);
+                solver_plan.tunable    = solver_plan.applicable && solver.IsTunable();
+                if(solver_plan.tunable)
+                {
+                    const auto space          = solver.GetTuningSpace(ctx, problem);
+                    solver_plan.primary       = space.primary;
+                    solver_plan.spare         = space.spare;
+                    solver_plan.searched      = space.searched;
+                    solver_plan.kernel_builds = space.programs.size();
+                    solver_plan.estimated_ms  = EstimateTuningTime(space.programs.size(),
+                                                                   space.searched,
+                                                                   model,
+                                                                   plan.threads,
+                                                                   plan.time_max_ms);
+                    problem_programs.insert(space.programs.begin(), space.programs.end());
+                    problem_plan.estimated_ms += solver_plan.estimated_ms;
+                }
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_W(solver_plan.solver << ": " << ex.what());
+                solver_plan.error = ex.what();
+            }
+
+            problem_plan.solvers.push_back(std::move(solver_plan));
+        }
+
+        problem_plan.kernel_builds = problem_programs.size();
+        plan.estimated_ms += problem_plan.estimated_ms;
+        all_programs.insert(problem_programs.begin(), problem_programs.end());
+        plan.problems.push_back(std::move(problem_plan));
+    }
+    plan.kernel_builds = all_programs.size();
+
+    MIOPEN_LOG_I("Planned tuning of " << plan.problems.size() << " problems: "
+                                      << plan.kernel_builds << " kernel builds, "
+                                      << plan.estimated_ms << " ms");
+    return plan;
+}
+
+} // namespace conv
+} // namespace miopen
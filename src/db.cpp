@@ -24,7 +24,9 @@
  *
  *******************************************************************************/
 #include <miopen/db.hpp>
+#include <miopen/cached_instances.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -39,19 +41,339 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstdlib>
+#include <exception>
 #include <fstream>
 #include <ios>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_USER_DB_LOG_STRUCTURED)
+
 namespace miopen {
 
+namespace debug {
+
+boost::optional<bool>& user_db_log_structured_override()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static boost::optional<bool> data = boost::none;
+    return data;
+}
+
+} // namespace debug
+
+DbFileState GetDbFileState(const std::string& filename)
+{
+#ifndef _WIN32
+    struct stat st = {};
+    if(stat(filename.c_str(), &st) != 0)
+        return {};
+    return {(static_cast<std::uint64_t>(st.st_dev) << 32) ^ static_cast<std::uint64_t>(st.st_ino),
+            static_cast<std::streamoff>(st.st_size),
+            static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec};
+#else
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(filename, ec);
+    if(ec)
+        return {};
+    const auto modified = boost::filesystem::last_write_time(filename, ec);
+    return {0, static_cast<std::streamoff>(size), static_cast<std::int64_t>(modified)};
+#endif
+}
+
+/// Exists while the db file holds overwritten records or tombstones appended in the
+/// log-structured mode, so that processes running in the plain mode do not take the first
+/// version of a record for the latest one.
+static std::string GetLogMarkerPath(const std::string& filename)
+{
+    return filename + ".log-structured";
+}
+
+static bool IsMarkedLogStructured(const std::string& filename)
+{
+    boost::system::error_code ec;
+    return boost::filesystem::exists(GetLogMarkerPath(filename), ec);
+}
+
+/// Positions of the latest version of each record of a db file.
+/// Shared by all PlainTextDb instances of the file, thus has to be MT-safe on its own,
+/// as readers holding the shared file lock may refresh it simultaneously.
+class PlainTextDbIndex
+{
+public:
+    static PlainTextDbIndex& Get(const std::string& filename)
+    {
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static auto instances = std::map<std::string, std::unique_ptr<PlainTextDbIndex>>{};
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static auto lookup = CachedInstances<PlainTextDbIndex>{};
+
+        return lookup.Get(filename, [&]() {
+            auto& instance = instances[filename];
+            instance       = std::make_unique<PlainTextDbIndex>();
+            return instance.get();
+        });
+    }
+
+    std::mutex& GetMutex() { return mutex; }
+
+    /// Brings the index in sync with the file. Only appended data is parsed unless the
+    /// file has been replaced or truncated.
+    void RefreshUnsafe(std::istream& file, const std::string& filename)
+    {
+        const auto state = GetDbFileState(filename);
+
+        if(state.size < 0 || state.id != file_id || state.size < indexed)
+        {
+            Reset();
+            file_id = state.id;
+        }
+
+        if(state.size <= indexed)
+            return;
+
+        file.clear();
+        file.seekg(indexed);
+
+        auto line   = std::string{};
+        auto offset = indexed;
+
+        while(offset < state.size && std::getline(file, line))
+        {
+            const auto begin = offset;
+            offset += static_cast<std::streamoff>(line.size()) + (file.eof() ? 0 : 1);
+
+            const auto key_size = line.find('=');
+            const bool is_key   = (key_size != std::string::npos && key_size != 0);
+
+            if(!is_key)
+            {
+                if(!line.empty()) // Do not blame empty lines.
+                    MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "@"
+                                                                      << begin);
+                garbage += offset - begin;
+                continue;
+            }
+
+            AddUnsafe(line.substr(0, key_size), {begin, offset}, key_size + 1 == line.size());
+        }
+
+        indexed = offset;
+    }
+
+    /// Registers a record appended by this process.
+    void AppendUnsafe(const std::string& filename,
+                      const std::string& key,
+                      RecordPositions pos,
+                      bool removed)
+    {
+        // Data appended by someone else has to be parsed first.
+        if(pos.begin != indexed)
+        {
+            Reset();
+            return;
+        }
+
+        AddUnsafe(key, pos, removed);
+        indexed = pos.end;
+        file_id = GetDbFileState(filename).id;
+    }
+
+    boost::optional<RecordPositions> FindUnsafe(const std::string& key) const
+    {
+        const auto it = records.find(key);
+        if(it == records.end())
+            return boost::none;
+        return it->second;
+    }
+
+    std::vector<RecordPositions> GetAllUnsafe() const
+    {
+        auto ret = std::vector<RecordPositions>{};
+        ret.reserve(records.size());
+        for(const auto& record : records)
+            ret.push_back(record.second);
+        std::sort(ret.begin(), ret.end(), [](const auto& left, const auto& right) {
+            return left.begin < right.begin;
+        });
+        return ret;
+    }
+
+    /// Whether the file is marked as log-structured. The marker is only created or removed along
+    /// with a change of the file under the exclusive file lock, so it is looked up again only
+    /// when the file changes.
+    bool IsMarkedUnsafe(const std::string& filename)
+    {
+        const auto state = GetDbFileState(filename);
+        if(state.id != marker_state.id || state.size != marker_state.size ||
+           state.modified != marker_state.modified)
+        {
+            marked       = IsMarkedLogStructured(filename);
+            marker_state = state;
+        }
+        return marked;
+    }
+
+    /// Overwritten and removed records, as well as tombstones, are garbage.
+    std::streamoff GetGarbageSizeUnsafe() const { return garbage; }
+    std::streamoff GetLiveSizeUnsafe() const { return indexed - garbage; }
+
+    void Reset()
+    {
+        records.clear();
+        file_id = 0;
+        indexed = 0;
+        garbage = 0;
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, RecordPositions> records;
+    std::uint64_t file_id  = 0;
+    std::streamoff indexed = 0;
+    std::streamoff garbage = 0;
+    DbFileState marker_state;
+    bool marked = false;
+
+    void AddUnsafe(const std::string& key, RecordPositions pos, bool removed)
+    {
+        const auto it = records.find(key);
+
+        if(it != records.end())
+            garbage += it->second.end - it->second.begin;
+
+        if(removed)
+        {
+            garbage += pos.end - pos.begin;
+            if(it != records.end())
+                records.erase(it);
+            return;
+        }
+
+        if(it != records.end())
+            it->second = pos;
+        else
+            records.emplace(key, pos);
+    }
+};
+
+/// Compacts log-structured db files on a background thread, so that the writer which has
+/// produced the garbage does not wait for the whole file to be rewritten.
+class PlainTextDbCompactor
+{
+public:
+    static PlainTextDbCompactor& Get()
+    {
+        // Never destroyed, the thread is stopped by an atexit handler instead. The handler is
+        // registered after the lock files and the indices of the dbs have been created, so it
+        // runs before they are destroyed.
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static auto& instance = *[]() {
+            auto ptr = new PlainTextDbCompactor{};
+            std::atexit([]() { Get().Stop(); });
+            return ptr;
+        }();
+        return instance;
+    }
+
+    void Schedule(const std::string& filename)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(stopping)
+            return;
+        if(pending.insert(filename).second)
+            changed.notify_one();
+    }
+
+    void Wait()
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        done.wait(lock, [&]() { return stopping || (pending.empty() && !busy); });
+    }
+
+    PlainTextDbCompactor(const PlainTextDbCompactor&) = delete;
+    PlainTextDbCompactor& operator=(const PlainTextDbCompactor&) = delete;
+
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::condition_variable done;
+    std::set<std::string> pending;
+    bool busy     = false;
+    bool stopping = false;
+    std::thread thread;
+
+    PlainTextDbCompactor() : thread([this]() { Run(); }) {}
+
+    void Run()
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+
+        while(true)
+        {
+            changed.wait(lock, [&]() { return stopping || !pending.empty(); });
+            // Compaction is an optimization, the files are left as they are at the exit.
+            if(stopping)
+                return;
+
+            const auto filename = *pending.begin();
+            pending.erase(pending.begin());
+            busy = true;
+            lock.unlock();
+
+            try
+            {
+                if(!PlainTextDb{filename}.Compact())
+                    MIOPEN_LOG_W("Failed to compact " << filename);
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_W("Failed to compact " << filename << ": " << ex.what());
+            }
+
+            lock.lock();
+            busy = false;
+            done.notify_all();
+        }
+    }
+
+    void Stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+            changed.notify_one();
+            done.notify_all();
+        }
+        thread.join();
+    }
+};
+
+bool PlainTextDb::IsLogStructured()
+{
+    if(debug::user_db_log_structured_override())
+        return *debug::user_db_log_structured_override();
+    return IsEnabled(MIOPEN_USER_DB_LOG_STRUCTURED{});
+}
+
 PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
     : filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
+      index(PlainTextDbIndex::Get(filename_)),
       warning_if_unreadable(is_system)
 {
     if(is_system)
@@ -160,6 +482,75 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
         return boost::none;
     }
 
+    if(!IsLogStructured())
+    {
+        const auto marked = [&]() {
+            const std::lock_guard<std::mutex> guard{index.GetMutex()};
+            return index.IsMarkedUnsafe(filename);
+        }();
+        return ScanRecordUnsafe(file, key, pos, marked);
+    }
+
+    // A stale index is rebuilt once. If it still does not match the file, the file is scanned.
+    for(auto attempt = 0; attempt < 2; ++attempt)
+    {
+        const auto found = [&]() {
+            const std::lock_guard<std::mutex> guard{index.GetMutex()};
+            index.RefreshUnsafe(file, filename);
+            return index.FindUnsafe(key);
+        }();
+
+        // Record was not found
+        if(!found)
+            return boost::none;
+
+        std::string line;
+        file.clear();
+        file.seekg(found->begin);
+
+        if(!std::getline(file, line) || line.compare(0, key.size() + 1, key + '=') != 0)
+        {
+            MIOPEN_LOG_E("Db index is out of sync with the file, rebuilding: " << filename);
+            const std::lock_guard<std::mutex> guard{index.GetMutex()};
+            index.Reset();
+            continue;
+        }
+
+        MIOPEN_LOG_I2("Key match: " << key);
+        const auto contents = line.substr(key.size() + 1);
+        MIOPEN_LOG_I2("Contents found: " << contents);
+
+        DbRecord record(key);
+        const bool is_parse_ok = record.ParseContents(contents);
+
+        if(!is_parse_ok)
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file "
+                                                                 << filename << "@"
+                                                                 << found->begin);
+            MIOPEN_LOG_E("Contents: " << contents);
+        }
+        // A record with matching key have been found.
+        if(pos != nullptr)
+            *pos = *found;
+        return record;
+    }
+
+    MIOPEN_LOG_E("Db index is still out of sync with the file, scanning it: " << filename);
+    return ScanRecordUnsafe(file, key, pos, true);
+}
+
+boost::optional<DbRecord> PlainTextDb::ScanRecordUnsafe(std::istream& file,
+                                                        const std::string& key,
+                                                        RecordPositions* pos,
+                                                        bool last_wins) const
+{
+    // The log may hold several versions of the record, and the last one wins.
+    auto ret = boost::optional<DbRecord>{};
+
+    file.clear();
+    file.seekg(0);
+
     int n_line = 0;
     while(true)
     {
@@ -191,6 +582,17 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
 
         if(contents.empty())
         {
+            if(last_wins)
+            {
+                // Tombstone of a removed record.
+                ret = boost::none;
+                if(pos != nullptr)
+                {
+                    pos->begin = -1;
+                    pos->end   = -1;
+                }
+                continue;
+            }
             MIOPEN_LOG_E("None contents under the key: " << current_key << " form file " << filename
                                                          << "#" << n_line);
             continue;
@@ -212,10 +614,11 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
             pos->begin = line_begin;
             pos->end   = next_line_begin;
         }
-        return record;
+        if(!last_wins)
+            return record;
+        ret = std::move(record);
     }
-    // Record was not found
-    return boost::none;
+    return ret;
 }
 
 static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
@@ -235,26 +638,89 @@ static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
     }
 }
 
-bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
+bool PlainTextDb::AppendUnsafe(const DbRecord& record, const RecordPositions* pos)
 {
-    assert(pos);
+    const auto existed = pos->begin >= 0 && pos->end >= 0;
+    const auto removed = record.GetSize() == 0;
+
+    // Nothing to remove
+    if(removed && !existed)
+        return true;
+
+    const std::lock_guard<std::mutex> guard{index.GetMutex()};
 
-    if(pos->begin < 0 || pos->end < 0)
     {
+        std::ofstream file(filename, std::ios::app);
+
+        if(!file)
         {
-            std::ofstream file(filename, std::ios::app);
+            MIOPEN_LOG_E("File is unwritable: " << filename);
+            return false;
+        }
 
-            if(!file)
-            {
-                MIOPEN_LOG_E("File is unwritable: " << filename);
-                return false;
-            }
+        file.seekp(0, std::ios::end);
+        const auto begin = static_cast<std::streamoff>(file.tellp());
 
-            (void)file.tellp();
+        if(removed)
+            file << record.key << '=' << std::endl;
+        else
             record.WriteContents(file);
+
+        const auto end = static_cast<std::streamoff>(file.tellp());
+        file.close();
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("Failed to append a record to: " << filename);
+            index.Reset();
+            return false;
         }
 
-        boost::filesystem::permissions(filename, boost::filesystem::all_all);
+        // The index is not used in the plain mode.
+        if(IsLogStructured())
+            index.AppendUnsafe(filename, record.key, {begin, end}, removed);
+    }
+
+    if(IsLogStructured() && existed && !IsMarkedLogStructured(filename))
+    {
+        const auto marker = GetLogMarkerPath(filename);
+        std::ofstream{marker};
+        boost::system::error_code ec;
+        boost::filesystem::permissions(marker, boost::filesystem::all_all, ec);
+    }
+
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    return true;
+}
+
+bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
+{
+    assert(pos);
+
+    if(IsLogStructured())
+    {
+        if(!AppendUnsafe(record, pos))
+            return false;
+
+        constexpr std::streamoff min_garbage_size = 1024 * 1024;
+
+        const auto compaction_required = [&]() {
+            const std::lock_guard<std::mutex> guard{index.GetMutex()};
+            const auto garbage = index.GetGarbageSizeUnsafe();
+            return garbage >= min_garbage_size && garbage > index.GetLiveSizeUnsafe();
+        }();
+
+        // The file is compacted by another thread, as this one holds the file lock.
+        if(compaction_required)
+            PlainTextDbCompactor::Get().Schedule(filename);
+        return true;
+    }
+
+    if(pos->begin < 0 || pos->end < 0)
+    {
+        if(record.GetSize() == 0)
+            return true;
+        return AppendUnsafe(record, pos);
     }
     else
     {
@@ -290,13 +756,112 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
         std::rename(temp_name.c_str(), filename.c_str());
         /// \todo What if rename fails? Thou shalt not loose the original file.
         boost::filesystem::permissions(filename, boost::filesystem::all_all);
+
+        const std::lock_guard<std::mutex> guard{index.GetMutex()};
+        index.Reset();
+    }
+    return true;
+}
+
+bool PlainTextDb::Compact()
+{
+    if(DisableUserDbFileIO)
+        return true;
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return CompactUnsafe();
+}
+
+void PlainTextDb::WaitForCompaction() { PlainTextDbCompactor::Get().Wait(); }
+
+bool PlainTextDb::CompactUnsafe()
+{
+    std::ifstream from(filename);
+
+    // Nothing to compact
+    if(!from)
+    {
+        std::remove(GetLogMarkerPath(filename).c_str());
+        return true;
+    }
+
+    const std::lock_guard<std::mutex> guard{index.GetMutex()};
+    index.RefreshUnsafe(from, filename);
+
+    if(index.GetGarbageSizeUnsafe() == 0)
+    {
+        std::remove(GetLogMarkerPath(filename).c_str());
+        return true;
+    }
+
+    MIOPEN_LOG_I("Compacting " << filename << ": " << index.GetGarbageSizeUnsafe()
+                               << " bytes of garbage, " << index.GetLiveSizeUnsafe()
+                               << " bytes of live records");
+
+    const auto temp_name = filename + ".temp";
+
+    {
+        std::ofstream to(temp_name);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
+        // Records are copied in the order of their latest versions, so the compacted file is
+        // exactly what the plain mode would have produced by appending.
+        for(const auto& pos : index.GetAllUnsafe())
+        {
+            from.clear();
+            from.seekg(pos.begin);
+            Copy(from, to, pos.end - pos.begin);
+        }
+
+        to.close();
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Failed to write compacted db: " << temp_name);
+            std::remove(temp_name.c_str());
+            return false;
+        }
     }
+
+    from.close();
+
+    // The file is replaced at once, so the db is never left without it.
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp_name, filename, ec);
+
+    if(ec)
+    {
+        MIOPEN_LOG_E("Failed to replace " << filename
+                                          << " with the compacted db: " << ec.message());
+        std::remove(temp_name.c_str());
+        return false;
+    }
+
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    std::remove(GetLogMarkerPath(filename).c_str());
+    index.Reset();
     return true;
 }
 
+bool PlainTextDb::PrepareWriteUnsafe()
+{
+    // The plain mode rewrites records in place, which is only correct for one version of each.
+    if(IsLogStructured() || !IsMarkedLogStructured(filename))
+        return true;
+    MIOPEN_LOG_I("Compacting log-structured db before a change in the plain mode: " << filename);
+    return CompactUnsafe();
+}
+
 bool PlainTextDb::StoreRecordUnsafe(const DbRecord& record)
 {
     MIOPEN_LOG_I2("Storing record: " << record.key);
+    if(!PrepareWriteUnsafe())
+        return false;
     RecordPositions pos;
     FindRecordUnsafe(record.key, &pos);
     return FlushUnsafe(record, &pos);
@@ -304,6 +869,8 @@ bool PlainTextDb::StoreRecordUnsafe(const DbRecord& record)
 
 bool PlainTextDb::UpdateRecordUnsafe(DbRecord& record)
 {
+    if(!PrepareWriteUnsafe())
+        return false;
     RecordPositions pos;
     const auto old_record = FindRecordUnsafe(record.key, &pos);
     DbRecord new_record(record);
@@ -327,6 +894,8 @@ bool PlainTextDb::RemoveRecordUnsafe(const std::string& key)
     // Create empty record with same key and replace original with that
     // This will remove record
     MIOPEN_LOG_I("Removing record: " << key);
+    if(!PrepareWriteUnsafe())
+        return false;
     RecordPositions pos;
     FindRecordUnsafe(key, &pos);
     const DbRecord empty_record(key);
@@ -127,43 +127,68 @@ bool DbRecord::ParseContents(std::istream& contents)
 
     while(std::getline(contents, id_and_values, ';'))
     {
-        const auto id_size = id_and_values.find(':');
+        if(ParseItem(id_and_values))
+            ++found;
+    }
 
-        // Empty VALUES is ok, empty ID is not:
-        if(id_size == std::string::npos)
-        {
-            MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << key);
-            continue;
-        }
+    return (found > 0);
+}
 
-        auto id     = id_and_values.substr(0, id_size);
-        auto values = id_and_values.substr(id_size + 1);
+bool DbRecord::ParseContents(std::string_view contents)
+{
+    int found = 0;
+
+    map.clear();
+
+    // Split the same way as std::getline() does: no empty item after the last separator.
+    while(!contents.empty())
+    {
+        const auto item_size = contents.find(';');
+        if(ParseItem(contents.substr(0, item_size)))
+            ++found;
+        contents.remove_prefix(item_size == std::string_view::npos ? contents.size()
+                                                                   : item_size + 1);
+    }
+
+    return (found > 0);
+}
+
+bool DbRecord::ParseItem(std::string_view id_and_values)
+{
+    const auto id_size = id_and_values.find(':');
+
+    // Empty VALUES is ok, empty ID is not:
+    if(id_size == std::string_view::npos)
+    {
+        MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << key);
+        return false;
+    }
+
+    auto id     = std::string{id_and_values.substr(0, id_size)};
+    auto values = std::string{id_and_values.substr(id_size + 1)};
 
 #if WORKAROUND_ISSUE_1987
-        // Detect legacy find-db item (v.1.0 ID:VALUES) and transform it to the current format.
-        // For now, *only* legacy find-db record use convolution algorithm as ID, so if ID is
-        // a valid algorithm, then we can safely assume that the item is in legacy format.
-        if(IsValidConvolutionDirAlgo(id))
+    // Detect legacy find-db item (v.1.0 ID:VALUES) and transform it to the current format.
+    // For now, *only* legacy find-db record use convolution algorithm as ID, so if ID is
+    // a valid algorithm, then we can safely assume that the item is in legacy format.
+    if(IsValidConvolutionDirAlgo(id))
+    {
+        if(!TransformFindDbItem10to20(id, values))
         {
-            if(!TransformFindDbItem10to20(id, values))
-            {
-                MIOPEN_LOG_E("Ill-formed legacy find-db item: " << values);
-                continue;
-            }
+            MIOPEN_LOG_E("Ill-formed legacy find-db item: " << values);
+            return false;
         }
+    }
 #endif
 
-        if(map.find(id) != map.end())
-        {
-            MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
-            continue;
-        }
-
-        map.emplace(id, values);
-        ++found;
+    if(map.find(id) != map.end())
+    {
+        MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
+        return false;
     }
 
-    return (found > 0);
+    map.emplace(std::move(id), std::move(values));
+    return true;
 }
 
 void DbRecord::WriteContents(std::ostream& stream) const
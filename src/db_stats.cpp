@@ -0,0 +1,181 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_stats.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <type_traits>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DB_STATISTICS_FILE)
+
+namespace miopen {
+
+namespace {
+
+void Reset(std::atomic<uint64_t>& counter) { counter.store(0, std::memory_order_relaxed); }
+
+uint64_t Get(const std::atomic<uint64_t>& counter)
+{
+    return counter.load(std::memory_order_relaxed);
+}
+
+nlohmann::json ToJson(const LatencyStats& stats)
+{
+    auto histogram = nlohmann::json::array();
+    for(const auto& bucket : stats.histogram)
+        histogram.push_back(Get(bucket));
+    return {
+        {"count", Get(stats.count)},
+        {"total_ms", Get(stats.total_ns) * 1e-6},
+        {"max_ms", Get(stats.max_ns) * 1e-6},
+        {"histogram_us_log2", histogram},
+    };
+}
+
+nlohmann::json ToJson(const DbLayerStats& stats)
+{
+    return {
+        {"user_hits", Get(stats.user_hits)},
+        {"system_hits", Get(stats.system_hits)},
+        {"misses", Get(stats.misses)},
+        {"lookup", ToJson(stats.lookup)},
+    };
+}
+
+/// Writes the statistics at exit, unless no file is set.
+struct DbStatsWriter
+{
+    DbStatsWriter()                     = default;
+    DbStatsWriter(const DbStatsWriter&) = delete;
+    DbStatsWriter& operator=(const DbStatsWriter&) = delete;
+
+    ~DbStatsWriter()
+    {
+        const auto path = GetStringEnv(MIOPEN_DB_STATISTICS_FILE{});
+        if(path == nullptr || *path == '\0')
+            return;
+        auto file = std::ofstream{path};
+        GetDbStats().WriteJson(file);
+        if(!file)
+            MIOPEN_LOG_W("Unable to write db statistics to " << path);
+    }
+};
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DbStatsWriter writer;
+
+} // namespace
+
+void LatencyStats::Add(std::chrono::nanoseconds time)
+{
+    const auto ns = static_cast<uint64_t>(std::max<std::int64_t>(time.count(), 0));
+    auto us       = ns / 1000;
+    auto bucket   = std::size_t{0};
+    while(us != 0 && bucket < buckets - 1)
+    {
+        us >>= 1;
+        ++bucket;
+    }
+
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+    histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    auto max = max_ns.load(std::memory_order_relaxed);
+    while(ns > max && !max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {}
+}
+
+void LatencyStats::Reset()
+{
+    miopen::Reset(count);
+    miopen::Reset(total_ns);
+    miopen::Reset(max_ns);
+    for(auto& bucket : histogram)
+        miopen::Reset(bucket);
+}
+
+void DbLayerStats::Count(bool user_hit, bool system_hit, std::chrono::steady_clock::time_point start)
+{
+    lookup.AddSince(start);
+    auto& counter = user_hit ? user_hits : system_hit ? system_hits : misses;
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DbLayerStats::Reset()
+{
+    miopen::Reset(user_hits);
+    miopen::Reset(system_hits);
+    miopen::Reset(misses);
+    lookup.Reset();
+}
+
+void DbStats::Reset()
+{
+    find_db.Reset();
+    perf_db.Reset();
+    kern_db.Reset();
+    kernel_stores.Reset();
+    compilations.Reset();
+    miopen::Reset(fallback_ai);
+    miopen::Reset(fallback_nearest);
+    miopen::Reset(fallback_wti);
+    miopen::Reset(fallback_failed);
+}
+
+void DbStats::WriteJson(std::ostream& stream) const
+{
+    const auto json = nlohmann::json{
+        {"find_db", ToJson(find_db)},
+        {"perf_db", ToJson(perf_db)},
+        {"kern_db", ToJson(kern_db)},
+        {"kernel_stores", ToJson(kernel_stores)},
+        {"compilations", ToJson(compilations)},
+        {"fallback",
+         {
+             {"ai", Get(fallback_ai)},
+             {"nearest", Get(fallback_nearest)},
+             {"wti", Get(fallback_wti)},
+             {"failed", Get(fallback_failed)},
+         }},
+    };
+    stream << json.dump(4) << std::endl;
+}
+
+static_assert(std::is_trivially_destructible<DbStats>{}, "See GetDbStats()");
+
+DbStats& GetDbStats()
+{
+    // Constant-initialized and trivially destructible, so it may be used by the other static
+    // objects at any time, including the writer above at exit.
+    static DbStats stats;
+    return stats;
+}
+
+} // namespace miopen
@@ -0,0 +1,303 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_write_queue.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_USER_DB_ASYNC_WRITES)
+
+namespace miopen {
+
+namespace debug {
+
+boost::optional<bool>& user_db_async_writes_override()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static boost::optional<bool> data = boost::none;
+    return data;
+}
+
+} // namespace debug
+
+namespace {
+
+/// Pending changes above this limit make the writers wait for the background thread.
+constexpr std::size_t max_pending_changes = 1024;
+
+struct Queues
+{
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<DbWriteQueue>> items;
+};
+
+Queues& GetQueues()
+{
+    // The queues are never destroyed, as changes may be queued by other static destructors.
+    // Instead, their threads are stopped by an atexit handler.
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto& queues = *new Queues{};
+    return queues;
+}
+
+std::vector<DbWriteQueue*> GetAllQueues(const std::string& name_prefix = "")
+{
+    auto& queues = GetQueues();
+    const std::lock_guard<std::mutex> lock{queues.mutex};
+    auto ret = std::vector<DbWriteQueue*>{};
+    for(const auto& item : queues.items)
+    {
+        const auto name = boost::filesystem::path{item.first}.filename().string();
+        if(name.compare(0, name_prefix.size(), name_prefix) == 0)
+            ret.push_back(item.second.get());
+    }
+    return ret;
+}
+
+} // namespace
+
+bool DbWriteQueue::IsEnabled()
+{
+    if(debug::user_db_async_writes_override())
+        return *debug::user_db_async_writes_override();
+    return miopen::IsEnabled(MIOPEN_USER_DB_ASYNC_WRITES{});
+}
+
+DbWriteQueue::DbWriteQueue(std::string path_, BatchFactory begin_batch_)
+    : path(std::move(path_)), begin_batch(std::move(begin_batch_)), thread([this]() { Run(); })
+{
+}
+
+DbWriteQueue::~DbWriteQueue() { Stop(); }
+
+DbWriteQueue& DbWriteQueue::Get(const std::string& path, const BatchFactory& begin_batch)
+{
+    auto& queues = GetQueues();
+    const std::lock_guard<std::mutex> lock{queues.mutex};
+
+    const auto it = queues.items.find(path);
+    if(it != queues.items.end())
+        return *it->second;
+
+    // The db instances may be static objects created on the first use. The db is created before
+    // the queue, so that an exit handler registered after the queue runs before the db is
+    // destroyed (see StopAllAtExit()).
+    begin_batch();
+
+    MIOPEN_LOG_I2("Asynchronous writes to " << path);
+    auto queue = std::unique_ptr<DbWriteQueue>{new DbWriteQueue{path, begin_batch}};
+    return *queues.items.emplace(path, std::move(queue)).first->second;
+}
+
+void DbWriteQueue::StopAllAtExit()
+{
+    std::atexit([]() {
+        for(auto queue : GetAllQueues())
+            queue->Stop();
+    });
+}
+
+DbWriteQueue* DbWriteQueue::Find(const std::string& path)
+{
+    auto& queues = GetQueues();
+    const std::lock_guard<std::mutex> lock{queues.mutex};
+    const auto it = queues.items.find(path);
+    return it != queues.items.end() ? it->second.get() : nullptr;
+}
+
+void DbWriteQueue::Store(const DbRecord& record, std::function<bool()> write)
+{
+    Enqueue(record, {}, std::move(write));
+}
+
+void DbWriteQueue::Update(const DbRecord& values,
+                          const std::string& id,
+                          std::function<bool()> write)
+{
+    Enqueue(values, id, std::move(write));
+}
+
+void DbWriteQueue::Enqueue(const DbRecord& record,
+                           const std::string& id,
+                           std::function<bool()> write)
+{
+    auto lock       = std::unique_lock<std::mutex>{mutex};
+    const auto& key = record.GetKey();
+
+    written.wait(lock, [&]() {
+        return stopping || pending.size() < max_pending_changes || pending.count({key, id}) != 0;
+    });
+
+    if(stopping)
+    {
+        // Too late for the background thread, e.g. during the exit.
+        lock.unlock();
+        if(!write())
+            MIOPEN_LOG_E("Failed to write to user db at <" << path << ">");
+        return;
+    }
+
+    // A record replaced as a whole makes the pending changes of its ids obsolete.
+    if(id.empty())
+    {
+        pending.erase(pending.lower_bound({key, ""}), pending.lower_bound({key + '\0', ""}));
+    }
+
+    pending[{key, id}] = Change{next_sequence++, record, id, std::move(write)};
+    ++stats.queued;
+    changed.notify_one();
+}
+
+void DbWriteQueue::Run()
+{
+    auto lock = std::unique_lock<std::mutex>{mutex};
+
+    while(true)
+    {
+        changed.wait(lock, [&]() { return stopping || !pending.empty(); });
+        if(pending.empty())
+            return;
+
+        in_flight.swap(pending);
+        const auto last_sequence = next_sequence - 1;
+        written.notify_all();
+        lock.unlock();
+
+        auto changes = std::vector<const Change*>{};
+        for(const auto& item : in_flight)
+            changes.push_back(&item.second);
+        std::sort(changes.begin(), changes.end(), [](auto l, auto r) {
+            return l->sequence < r->sequence;
+        });
+
+        try
+        {
+            const auto batch = begin_batch();
+            for(const auto change : changes)
+            {
+                if(!change->write())
+                    MIOPEN_LOG_E("Failed to write to user db at <" << path << ">");
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_E("Failed to write to user db at <" << path << ">: " << ex.what());
+        }
+
+        lock.lock();
+        stats.written += in_flight.size();
+        in_flight.clear();
+        written_sequence = last_sequence;
+        written.notify_all();
+    }
+}
+
+void DbWriteQueue::Flush()
+{
+    auto lock                = std::unique_lock<std::mutex>{mutex};
+    const auto last_sequence = next_sequence - 1;
+    written.wait(lock, [&]() { return written_sequence >= last_sequence; });
+}
+
+void DbWriteQueue::FlushAll()
+{
+    for(auto queue : GetAllQueues())
+        queue->Flush();
+}
+
+void DbWriteQueue::FlushAll(const std::string& name_prefix)
+{
+    for(auto queue : GetAllQueues(name_prefix))
+        queue->Flush();
+}
+
+bool DbWriteQueue::HasQueues()
+{
+    auto& queues = GetQueues();
+    const std::lock_guard<std::mutex> lock{queues.mutex};
+    return !queues.items.empty();
+}
+
+void DbWriteQueue::Stop()
+{
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(stopping)
+            return;
+        stopping = true;
+        changed.notify_one();
+        written.notify_all();
+    }
+    thread.join();
+}
+
+void DbWriteQueue::Overlay(const std::string& key, boost::optional<DbRecord>& record) const
+{
+    auto changes = std::vector<const Change*>{};
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    for(const auto* changes_ : {&in_flight, &pending})
+    {
+        const auto end = changes_->lower_bound({key + '\0', ""});
+        for(auto it = changes_->lower_bound({key, ""}); it != end; ++it)
+            changes.push_back(&it->second);
+    }
+
+    if(changes.empty())
+        return;
+
+    std::sort(changes.begin(), changes.end(), [](auto l, auto r) {
+        return l->sequence < r->sequence;
+    });
+
+    for(const auto change : changes)
+    {
+        if(change->id.empty() || !record)
+        {
+            record = change->record;
+            continue;
+        }
+        auto merged = change->record;
+        merged.Merge(*record);
+        record = std::move(merged);
+    }
+}
+
+DbWriteQueue::Stats DbWriteQueue::GetStats() const
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    return stats;
+}
+
+} // namespace miopen
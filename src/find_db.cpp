@@ -240,7 +240,7 @@ bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config)
     auto unbuilt = false;
     auto any     = false;
 
-    for(const auto& pair : content->As<FindDbData>())
+    for(const auto& pair : *values)
     {
         if(in_sync)
         {
@@ -249,7 +249,7 @@ bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config)
                 unbuilt = true;
                 // This is not an logged as error because no error was detected.
                 // Find wasn't executed yet and invokers were not prepared.
-                LogFindDbItem(pair);
+                LogFindDbItem(pair, config);
                 break;
             }
 
@@ -264,20 +264,28 @@ bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config)
 template <class TDb>
 void FindDbRecord_t<TDb>::CopyTo(std::vector<PerfField>& to) const
 {
-    const auto range = content->As<FindDbData>();
-    std::transform(range.begin(), range.end(), std::back_inserter(to), [](const auto& pair) {
-        return PerfField{
-            pair.second.algorithm, pair.first, pair.second.time, pair.second.workspace};
-    });
+    const auto copy = [&](const auto& range) {
+        std::transform(range.begin(), range.end(), std::back_inserter(to), [](const auto& pair) {
+            return PerfField{
+                pair.second.algorithm, pair.first, pair.second.time, pair.second.workspace};
+        });
+    };
+
+    // The immediate mode loads only the decoded values, the content is set when regenerated.
+    if(content)
+        copy(content->As<FindDbData>());
+    else
+        copy(*values);
 }
 
 template <class TDb>
-void FindDbRecord_t<TDb>::LogFindDbItem(const std::pair<std::string, FindDbData>& item) const
+void FindDbRecord_t<TDb>::LogFindDbItem(const std::pair<std::string, FindDbData>& item,
+                                        const NetworkConfig& config) const
 {
     MIOPEN_LOG_I2("Kernel cache entry not found for solver: "
-                  << item.first << " at network config: " << content->GetKey());
+                  << item.first << " at network config: " << config.ToString());
 
-    for(const auto& pair2 : content->As<FindDbData>())
+    for(const auto& pair2 : *values)
         MIOPEN_LOG_I2("Find-db record content: " << pair2.first << ':' << pair2.second);
 }
 
@@ -0,0 +1,270 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_db_nearest.hpp>
+
+#include <miopen/cached_instances.hpp>
+#include <miopen/db.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/rank.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace miopen {
+
+namespace {
+
+bool ParseSize(const std::string& token, double& value)
+{
+    if(token.empty())
+        return false;
+    char* end       = nullptr;
+    const auto size = std::strtoll(token.c_str(), &end, 10);
+    if(end != token.c_str() + token.size() || size <= 0)
+        return false;
+    value = static_cast<double>(size);
+    return true;
+}
+
+template <class TDb>
+auto AddKeys(rank<1>, FindDbNearest& index, const TDb& db)
+    -> decltype(db.VisitKeys(std::function<void(std::string_view)>{}))
+{
+    db.VisitKeys([&](std::string_view key) { index.Add(std::string{key}); });
+}
+
+template <class TDb>
+void AddKeys(rank<0>, FindDbNearest&, const TDb&)
+{
+}
+
+} // namespace
+
+boost::optional<FindDbKeyFeatures> FindDbKeyFeatures::Parse(const std::string& key)
+{
+    // C-[D-]H-W-FxF[xF]-K-[oD-]oH-oW-N-PADS-STRIDES-DILATIONS-BIAS-LAYOUT(S)-TYPE-DIRECTION[OPT]
+    const auto tokens = SplitDelim(key, '-');
+    if(tokens.size() < 15)
+        return boost::none;
+
+    // The filter size of 2D problems takes the 4th position, where 3D ones have the input width.
+    const std::size_t dims = tokens[3].find('x') != std::string::npos ? 2 : 3;
+    const auto tail        = tokens.size() - (8 + 2 * dims);
+    if(tail != 3 && tail != 5)
+        return boost::none;
+
+    const auto get = [&](std::size_t i, double& value) { return ParseSize(tokens[i], value); };
+
+    auto in_c = 0.0, out_c = 0.0, batch = 0.0;
+    auto in_dhw  = std::array<double, 3>{1.0, 1.0, 1.0};
+    auto out_dhw = std::array<double, 3>{1.0, 1.0, 1.0};
+
+    if(!get(0, in_c) || !get(2 + dims, out_c) || !get(3 + 2 * dims, batch))
+        return boost::none;
+    for(std::size_t i = 0; i < dims; ++i)
+    {
+        if(!get(1 + i, in_dhw[3 - dims + i]) || !get(3 + dims + i, out_dhw[3 - dims + i]))
+            return boost::none;
+    }
+
+    auto features   = FindDbKeyFeatures{};
+    features.bucket = tokens[1 + dims];
+    for(auto i = 4 + 2 * dims; i < tokens.size(); ++i)
+        features.bucket += '-' + tokens[i];
+    features.sizes = {std::log2(in_c),
+                      std::log2(out_c),
+                      std::log2(batch),
+                      std::log2(in_dhw[0]),
+                      std::log2(in_dhw[1]),
+                      std::log2(in_dhw[2])};
+    features.work  = batch * in_c * out_c * out_dhw[0] * out_dhw[1] * out_dhw[2];
+    return features;
+}
+
+double FindDbKeyFeatures::Distance(const FindDbKeyFeatures& other) const
+{
+    // The batch size affects the choice of the solver less than the other sizes do.
+    static const auto weights = std::array<double, 6>{1.0, 1.0, 0.5, 1.0, 1.0, 1.0};
+
+    auto sum = 0.0;
+    for(std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        const auto diff = sizes[i] - other.sizes[i];
+        sum += weights[i] * diff * diff;
+    }
+    return std::sqrt(sum);
+}
+
+bool FindDbNearest::Add(const std::string& key)
+{
+    auto features = FindDbKeyFeatures::Parse(key);
+    if(!features)
+        return false;
+    auto& points = buckets[features->bucket];
+    features->bucket.clear();
+    points.push_back({key, std::move(*features)});
+    ++size;
+    return true;
+}
+
+std::vector<FindDbNearest::Neighbour> FindDbNearest::Find(const std::string& key,
+                                                          std::size_t count) const
+{
+    const auto features = FindDbKeyFeatures::Parse(key);
+    if(!features)
+        return {};
+    const auto bucket = buckets.find(features->bucket);
+    if(bucket == buckets.end())
+        return {};
+
+    auto neighbours = std::vector<Neighbour>{};
+    neighbours.reserve(bucket->second.size());
+    for(const auto& point : bucket->second)
+    {
+        neighbours.push_back({point.key,
+                              features->Distance(point.features),
+                              features->work / point.features.work});
+    }
+
+    count = std::min(count, neighbours.size());
+    std::partial_sort(neighbours.begin(),
+                      neighbours.begin() + count,
+                      neighbours.end(),
+                      [](const Neighbour& lhs, const Neighbour& rhs) {
+                          return lhs.distance < rhs.distance;
+                      });
+    neighbours.resize(count);
+    return neighbours;
+}
+
+std::vector<FindDbNearest::Estimate>
+FindDbNearest::Rank(const std::vector<Neighbour>& neighbours,
+                    const std::function<boost::optional<DbRecord>(const std::string&)>& load)
+{
+    struct Vote
+    {
+        double weight;
+        std::unordered_map<std::string, double> relative;
+    };
+
+    auto votes     = std::vector<Vote>{};
+    auto algorithm = std::unordered_map<std::string, std::string>{};
+    auto base_time = 0.0;
+
+    for(const auto& neighbour : neighbours)
+    {
+        const auto record = load(neighbour.key);
+        if(!record)
+            continue;
+
+        auto vote = Vote{1.0 / (1.0 + neighbour.distance), {}};
+        auto best = std::numeric_limits<double>::max();
+        for(const auto& pair : record->As<FindDbData>())
+        {
+            if(pair.second.time > 0)
+                best = std::min<double>(best, pair.second.time);
+        }
+        if(best == std::numeric_limits<double>::max())
+            continue;
+
+        for(const auto& pair : record->As<FindDbData>())
+        {
+            if(pair.second.time <= 0)
+                continue;
+            const auto relative = pair.second.time / best;
+            vote.relative.emplace(pair.first, relative);
+            algorithm.emplace(pair.first, pair.second.algorithm);
+        }
+
+        // The nearest record sets the scale of the time.
+        if(votes.empty())
+            base_time = best * neighbour.work_ratio;
+        votes.push_back(std::move(vote));
+    }
+
+    auto estimates = std::vector<Estimate>{};
+    estimates.reserve(algorithm.size());
+    for(const auto& solver : algorithm)
+    {
+        auto score  = 0.0;
+        auto weight = 0.0;
+        for(const auto& vote : votes)
+        {
+            const auto relative = vote.relative.find(solver.first);
+            if(relative == vote.relative.end())
+                continue;
+            score += vote.weight * relative->second;
+            weight += vote.weight;
+        }
+        score /= weight;
+        estimates.push_back({solver.first, solver.second, static_cast<float>(score * base_time)});
+    }
+
+    std::sort(estimates.begin(), estimates.end(), [](const Estimate& lhs, const Estimate& rhs) {
+        return lhs.time != rhs.time ? lhs.time < rhs.time : lhs.solver < rhs.solver;
+    });
+    return estimates;
+}
+
+const FindDbNearest& FindDbNearest::GetCached(const std::string& path)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = CachedInstances<FindDbNearest>{};
+    return instances.Get(path, [&]() {
+        // Same lifetime considerations as for ReadonlyRamDb::GetCached() apply here.
+        auto instance    = new FindDbNearest{};
+        const auto start = std::chrono::steady_clock::now();
+        auto&& db        = GetDbInstance<SystemFindDb>(path, true);
+        AddKeys(rank<1>{}, *instance, db);
+        const auto end = std::chrono::steady_clock::now();
+        MIOPEN_LOG_I2("Indexed " << instance->GetSize() << " find-db keys of " << path << " in "
+                                 << std::chrono::duration<double, std::milli>(end - start).count()
+                                 << " ms");
+        return instance;
+    });
+}
+
+std::vector<FindDbNearest::Estimate>
+FindDbNearest::GetEstimates(const std::string& path, const std::string& key, std::size_t count)
+{
+    const auto& index = GetCached(path);
+    if(index.GetSize() == 0)
+        return {};
+    const auto neighbours = index.Find(key, count);
+    for(const auto& neighbour : neighbours)
+        MIOPEN_LOG_I2("Nearest find-db key " << neighbour.key << ", distance "
+                                             << neighbour.distance);
+    auto&& db = GetDbInstance<SystemFindDb>(path, true);
+    return Rank(neighbours, [&](const std::string& neighbour) { return db.FindRecord(neighbour); });
+}
+
+} // namespace miopen
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_db_shards.hpp>
+
+#include <miopen/cached_instances.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/stringutils.hpp>
+
+#if MIOPEN_EMBED_DB
+#include <miopen_data.hpp>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+namespace miopen {
+
+namespace {
+
+std::string RemoveTextExtension(const std::string& path)
+{
+    const auto ext = std::string{".txt"};
+    return EndsWith(path, ext) ? path.substr(0, path.size() - ext.size()) : path;
+}
+
+} // namespace
+
+const FindDbShards& FindDbShards::GetCached(const std::string& path)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = CachedInstances<FindDbShards>{};
+    return instances.Get(path, [&]() {
+        // Same lifetime considerations as for ReadonlyRamDb::GetCached() apply here.
+        auto instance  = new FindDbShards{};
+        instance->path = path;
+        instance->Load();
+        return instance;
+    });
+}
+
+std::string_view FindDbShards::GetShard(std::string_view key)
+{
+    key = key.substr(0, key.find('_'));
+
+    // All the tokens before the layouts are numbers or sizes like 3x3.
+    auto pos = std::size_t{0};
+    while(pos < key.size())
+    {
+        if(std::isalpha(static_cast<unsigned char>(key[pos])) != 0)
+            return pos > 0 ? key.substr(pos) : std::string_view{};
+        const auto next = key.find('-', pos);
+        if(next == std::string_view::npos)
+            break;
+        pos = next + 1;
+    }
+
+    return {};
+}
+
+std::string FindDbShards::GetShardPath(const std::string& path, std::string_view shard)
+{
+    return RemoveTextExtension(path) + "." + std::string{shard} + ".txt";
+}
+
+std::string FindDbShards::GetListPath(const std::string& path)
+{
+    return RemoveTextExtension(path) + ".shards";
+}
+
+std::string FindDbShards::GetPath(std::string_view key) const
+{
+    if(!sharded)
+        return path;
+
+    const auto shard = GetShard(key);
+    if(shard.empty())
+        return path;
+    if(shards.find(shard) == shards.end())
+        return {};
+    return GetShardPath(path, shard);
+}
+
+void FindDbShards::Load()
+{
+    if(path.empty())
+        return;
+
+    const auto list_path = GetListPath(path);
+    auto list            = std::string{};
+
+    constexpr bool isEmbedded = MIOPEN_EMBED_DB;
+    // cppcheck-suppress knownConditionTrueFalse
+    if(!debug::rordb_embed_fs_override() && isEmbedded)
+    {
+#if MIOPEN_EMBED_DB
+        const auto filename = boost::filesystem::path(list_path).filename().string();
+        const auto it_p     = miopen_data().find(filename + ".o");
+        if(it_p == miopen_data().end())
+            return;
+        list.assign(it_p->second.first, it_p->second.second);
+#endif
+    }
+    else
+    {
+        auto file = std::ifstream{list_path};
+        if(!file)
+            return;
+        auto contents = std::ostringstream{};
+        contents << file.rdbuf();
+        list = contents.str();
+    }
+
+    auto input = std::istringstream{list};
+    auto shard = std::string{};
+    while(std::getline(input, shard))
+        if(!shard.empty())
+            shards.insert(shard);
+
+    sharded = true;
+    MIOPEN_LOG_I2("Find-db " << path << " is split into " << shards.size() << " shards");
+}
+
+} // namespace miopen
@@ -25,8 +25,10 @@
  *******************************************************************************/
 #include <cstdio>
 #include <miopen/version.h>
+#include <miopen/db_stats.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/kernel_cache.hpp>
 
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
@@ -114,3 +116,68 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+static_assert(miopen::LatencyStats::buckets == MIOPEN_STATISTICS_HISTOGRAM_BUCKETS,
+              "Histogram sizes mismatch");
+
+static void CopyStatistics(const miopen::LatencyStats& from, miopenLatencyStatistics_t& to)
+{
+    to.count   = from.count.load(std::memory_order_relaxed);
+    to.totalMs = from.total_ns.load(std::memory_order_relaxed) * 1e-6;
+    to.maxMs   = from.max_ns.load(std::memory_order_relaxed) * 1e-6;
+    for(std::size_t i = 0; i < from.histogram.size(); ++i)
+        to.histogram[i] = from.histogram[i].load(std::memory_order_relaxed);
+}
+
+static void CopyStatistics(const miopen::DbLayerStats& from, miopenDbStatistics_t& to)
+{
+    to.userHits   = from.user_hits.load(std::memory_order_relaxed);
+    to.systemHits = from.system_hits.load(std::memory_order_relaxed);
+    to.misses     = from.misses.load(std::memory_order_relaxed);
+    CopyStatistics(from.lookup, to.lookup);
+}
+
+extern "C" miopenStatus_t miopenGetStatistics(miopenStatistics_t* statistics)
+{
+    return miopen::try_([&] {
+        const auto& stats = miopen::GetDbStats();
+        auto& result      = miopen::deref(statistics);
+        CopyStatistics(stats.find_db, result.findDb);
+        CopyStatistics(stats.perf_db, result.perfDb);
+        CopyStatistics(stats.kern_db, result.kernDb);
+        CopyStatistics(stats.kernel_stores, result.kernelStores);
+        CopyStatistics(stats.compilations, result.compilations);
+        result.fallbackAi      = stats.fallback_ai.load(std::memory_order_relaxed);
+        result.fallbackNearest = stats.fallback_nearest.load(std::memory_order_relaxed);
+        result.fallbackWti     = stats.fallback_wti.load(std::memory_order_relaxed);
+        result.fallbackFailed  = stats.fallback_failed.load(std::memory_order_relaxed);
+    });
+}
+
+extern "C" miopenStatus_t miopenResetStatistics()
+{
+    return miopen::try_([&] { miopen::GetDbStats().Reset(); });
+}
+
+extern "C" miopenStatus_t miopenGetHandleCacheStatistics(miopenHandle_t handle,
+                                                         miopenHandleCacheStatistics_t* statistics)
+{
+    return miopen::try_([&] {
+        const auto& h           = miopen::deref(handle);
+        const auto programs     = h.GetKernelCacheStats();
+        const auto invokers     = h.GetInvokerCacheStats();
+        auto& result            = miopen::deref(statistics);
+        result.programs         = programs.programs;
+        result.programBytes     = programs.bytes;
+        result.programBudget    = programs.budget;
+        result.programEvictions = programs.evictions;
+        result.invokers         = invokers.invokers;
+        result.invokerBytes     = invokers.bytes;
+        result.invokerEvictions = invokers.evictions;
+    });
+}
+
+extern "C" miopenStatus_t miopenSetProgramCacheBudget(miopenHandle_t handle, size_t bytes)
+{
+    return miopen::try_([&] { miopen::deref(handle).SetProgramCacheBudget(bytes); });
+}
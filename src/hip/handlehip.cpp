@@ -28,6 +28,8 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -35,6 +37,7 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/program_registry.hpp>
 #include <miopen/rocm_features.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
@@ -326,7 +329,13 @@ Handle::Handle() : impl(std::make_unique<HandleImpl>())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    // The user dbs of the handle are named after its db basename. The queues of other handles
+    // are left to be written in the background.
+    if(DbWriteQueue::HasQueues())
+        DbWriteQueue::FlushAll(GetDbBasename());
+}
 
 // not MT safe
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
@@ -489,6 +498,12 @@ const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
+const std::vector<Kernel>& Handle::GetKernelsImpl(std::string_view algorithm,
+                                                  const ProblemKey& network_config) const
+{
+    return this->impl->cache.GetKernels(algorithm, network_config);
+}
+
 KernelInvoke Handle::Run(Kernel k) const
 {
     this->impl->set_ctx();
@@ -502,6 +517,19 @@ Program Handle::LoadProgram(const std::string& program_name,
                             std::string params,
                             bool is_kernel_str,
                             const std::string& kernel_src) const
+{
+    // Modules are shared by the handles of the same device only.
+    const auto device =
+        std::to_string(this->impl->device) + ' ' + this->GetTargetProperties().Name();
+    return ProgramRegistry::Get().GetOrLoad(device, program_name, params, [&]() {
+        return LoadProgramUnshared(program_name, params, is_kernel_str, kernel_src);
+    });
+}
+
+Program Handle::LoadProgramUnshared(const std::string& program_name,
+                                    std::string params,
+                                    bool is_kernel_str,
+                                    const std::string& kernel_src) const
 {
     this->impl->set_ctx();
     std::string arch_name = this->GetTargetProperties().Name();
@@ -535,9 +563,11 @@ Program Handle::LoadProgram(const std::string& program_name,
     // specific code object
     if(hsaco.empty())
     {
+        const auto start = std::chrono::steady_clock::now();
         CompileTimer ct;
         auto p = HIPOCProgram{
             program_name, params, is_kernel_str, this->GetTargetProperties(), kernel_src};
+        GetDbStats().compilations.AddSince(start);
         ct.Log("Kernel", is_kernel_str ? std::string() : program_name);
 
 // Save to cache
@@ -584,6 +614,20 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
+void Handle::ClearUnusedPrograms() const { this->impl->cache.ClearUnusedPrograms(); }
+
+void Handle::ScheduleClearUnusedPrograms() const
+{
+    this->impl->cache.ScheduleClearUnusedPrograms();
+}
+
+void Handle::SetProgramCacheBudget(std::size_t bytes) const
+{
+    this->impl->cache.SetProgramBudget(bytes);
+}
+
+KernelCacheStats Handle::GetKernelCacheStats() const { return this->impl->cache.GetStats(); }
+
 void Handle::Finish() const
 {
     this->impl->set_ctx();
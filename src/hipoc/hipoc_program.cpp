@@ -39,6 +39,7 @@
 #include <miopen/write_file.hpp>
 #include <miopen/env.hpp>
 #include <miopen/comgr.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/optional.hpp>
 
 #include <cstring>
@@ -184,11 +185,12 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
                                    const boost::filesystem::path& filespec)
     : program(program_name), hsaco_file(filespec)
 {
-    module = CreateModule(hsaco_file);
+    module           = CreateModule(hsaco_file);
+    code_object_size = boost::filesystem::file_size(hsaco_file);
 }
 
 HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name, const std::string& blob)
-    : program(program_name) ///, module(CreateModuleInMem(blob))
+    : program(program_name), code_object_size(blob.size()) ///, module(CreateModuleInMem(blob))
 {
     if(nullptr !=
        miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{})) /// \todo Finish off this spaghetti eventually.
@@ -206,14 +208,16 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
     BuildCodeObject(params, is_kernel_str, kernel_src);
     if(!binary.empty())
     {
-        module = CreateModuleInMem(binary);
+        module           = CreateModuleInMem(binary);
+        code_object_size = binary.size();
     }
     else
     {
         const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
         if(arch == nullptr)
         {
-            module = CreateModule(hsaco_file);
+            module           = CreateModule(hsaco_file);
+            code_object_size = boost::filesystem::file_size(hsaco_file);
         }
     }
 }
@@ -391,4 +395,9 @@ void HIPOCProgram::FreeCodeObjectFileStorage()
 
 bool HIPOCProgram::IsCodeObjectInMemory() const { return !impl->binary.empty(); };
 
+std::size_t HIPOCProgram::GetCodeObjectSize() const
+{
+    return impl == nullptr ? 0 : impl->code_object_size;
+}
+
 } // namespace miopen
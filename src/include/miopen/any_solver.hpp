@@ -70,6 +70,13 @@ struct AnySolver
         assert(ptr_value != nullptr);
         return ptr_value->GetAllSolutions(ctx, problem);
     };
+    /// Empty for the solvers which are not searched by GenericSearch.
+    TuningSpace GetTuningSpace(const ExecutionContext& ctx,
+                               const miopen::conv::ProblemDescription& problem) const
+    {
+        assert(ptr_value != nullptr);
+        return ptr_value->GetTuningSpace(ctx, problem);
+    };
     bool IsDynamic() const
     {
         assert(ptr_value != nullptr);
@@ -136,6 +143,9 @@ struct AnySolver
         virtual std::vector<ConvSolution>
         GetAllSolutions(const ExecutionContext& ctx,
                         const miopen::conv::ProblemDescription& problem) const                 = 0;
+        virtual TuningSpace
+        GetTuningSpace(const ExecutionContext& ctx,
+                       const miopen::conv::ProblemDescription& problem) const                  = 0;
         virtual bool IsDynamic() const                                                         = 0;
         virtual float GetWti(const ExecutionContext& ctx,
                              const miopen::conv::ProblemDescription& problem) const            = 0;
@@ -275,6 +285,32 @@ struct AnySolver
                                    std::integral_constant<bool, LegacySolver::Is>());
         }
 
+        // tunable solver, not legacy
+        TuningSpace GetTuningSpace(const ExecutionContext& ctx,
+                                   const miopen::conv::ProblemDescription& problem,
+                                   std::true_type,
+                                   std::false_type) const
+        {
+            return miopen::solver::GetTuningSpace(value, ctx, problem);
+        }
+        template <class Tunable, class Legacy>
+        TuningSpace GetTuningSpace(const ExecutionContext&,
+                                   const miopen::conv::ProblemDescription&,
+                                   Tunable,
+                                   Legacy) const
+        {
+            return {};
+        }
+
+        TuningSpace GetTuningSpace(const ExecutionContext& ctx,
+                                   const miopen::conv::ProblemDescription& problem) const override
+        {
+            return GetTuningSpace(ctx,
+                                  problem,
+                                  std::integral_constant<bool, TunableSolver::Is>(),
+                                  std::integral_constant<bool, LegacySolver::Is>());
+        }
+
         AnySolver_tmpl(T obj) : value(std::move(obj)){};
 
         bool IsApplicable(const ExecutionContext& ctx,
@@ -28,6 +28,7 @@
 
 #include <miopen/problem_description_base.hpp>
 #include <miopen/activ.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/tensor.hpp>
 
 #include <cassert>
@@ -177,6 +178,8 @@ struct ProblemDescription : ProblemDescriptionBase
     }
 
     NetworkConfig MakeNetworkConfig() const override;
+    /// Holds everything the network config is made of.
+    ProblemKey MakeProblemKey() const;
 
 private:
     Direction direction;
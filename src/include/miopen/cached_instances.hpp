@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CACHED_INSTANCES_HPP_
+#define GUARD_MIOPEN_CACHED_INSTANCES_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// Process-wide registry of objects which are never destroyed while the registry is in use,
+/// e.g. the per-file db instances returned by GetCached().
+///
+/// Lookups of already created objects read an immutable snapshot of the registry, so they
+/// neither block nor write to shared memory. Insertions are serialized, copy the current
+/// snapshot and publish the new one. Previous snapshots may still be read by other threads,
+/// thus they are kept until the registry is destroyed, which is cheap as there are only a few
+/// objects in each registry.
+template <class T>
+class CachedInstances
+{
+public:
+    T* Find(const std::string& key) const
+    {
+        const auto snapshot = current.load(std::memory_order_acquire);
+        if(snapshot == nullptr)
+            return nullptr;
+        const auto it = snapshot->find(key);
+        return it != snapshot->end() ? it->second : nullptr;
+    }
+
+    /// Returns the object registered under the key or the one returned by create(). The latter
+    /// is called under the registry mutex and becomes visible to other threads only after it
+    /// returns, so the object may be initialized there.
+    template <class TCreate>
+    T& Get(const std::string& key, TCreate&& create)
+    {
+        if(const auto found = Find(key))
+            return *found;
+
+        const std::lock_guard<std::mutex> lock{mutex};
+
+        if(const auto found = Find(key))
+            return *found;
+
+        T* const instance = create();
+        auto next = snapshots.empty() ? std::make_unique<Map>()
+                                      : std::make_unique<Map>(*snapshots.back());
+        next->emplace(key, instance);
+        current.store(next.get(), std::memory_order_release);
+        snapshots.push_back(std::move(next));
+        return *instance;
+    }
+
+private:
+    using Map = std::unordered_map<std::string, T*>;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<const Map>> snapshots;
+    std::atomic<const Map*> current{nullptr};
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CACHED_INSTANCES_HPP_
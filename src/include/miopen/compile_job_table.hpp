@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_JOB_TABLE_HPP_
+#define GUARD_MIOPEN_COMPILE_JOB_TABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+struct Handle;
+
+/// Process-wide table of the kernel compilations, keyed by a hash of the target, the kernel file
+/// and the compiler options. The perf configs of the same solver, as well as of different solvers,
+/// often produce identical programs which differ only in the kernel arguments, so each program is
+/// compiled only once during tuning. A compilation requested while the same one is in progress
+/// waits for it.
+class CompileJobTable
+{
+public:
+    struct Stats
+    {
+        uint64_t requested = 0; ///< Compilations requested.
+        uint64_t run       = 0; ///< Compilations run, including the failed ones.
+        uint64_t waited    = 0; ///< Requests which waited for the same compilation in progress.
+        uint64_t skipped   = 0; ///< Requests for the programs compiled before.
+
+        uint64_t Avoided() const { return waited + skipped; }
+    };
+
+    explicit CompileJobTable(std::size_t max_jobs_ = 65536) : max_jobs(max_jobs_) {}
+
+    static CompileJobTable& Get();
+
+    static uint64_t
+    MakeKey(const std::string& target, const std::string& program_name, const std::string& params);
+
+    /// Runs the compilation unless the same one is in progress or has completed before. A failed
+    /// compilation is not remembered, its exception is rethrown to the requests waiting for it.
+    /// \param remember False if the compiled program is not stored anywhere (e.g. the kernel cache
+    /// is disabled), then only the concurrent requests are merged.
+    void Run(uint64_t key, const std::function<void()>& compile, bool remember = true);
+
+    Stats GetStats() const;
+    void Clear();
+
+private:
+    mutable std::mutex mutex;
+    /// The futures of the completed jobs are ready.
+    std::unordered_map<uint64_t, std::shared_future<void>> jobs;
+    std::size_t max_jobs;
+    Stats stats;
+
+    void PruneUnsafe();
+};
+
+/// Compiles the program into the kernel cache, so the search can load it instead of compiling.
+void PrecompileProgram(const Handle& handle,
+                       const std::string& program_name,
+                       const std::string& params);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_JOB_TABLE_HPP_
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv/problem_description.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace conv {
+
+/// Phases of Prewarm(), times are in milliseconds. Kernel db lookup, decompression and module
+/// load are summed over the threads which load the kernels in parallel.
+struct PrewarmTimings
+{
+    std::size_t problems = 0; ///< Problems which solutions have been prepared.
+    std::size_t programs = 0; ///< Programs loaded into the kernel cache of the handle.
+    float db_lookup      = 0; ///< Find-db and perf-db lookups of the solutions.
+    float kernel_load    = 0; ///< Parallel loading of the programs (wall time).
+    float kern_db_lookup = 0; ///< Kernel db lookups.
+    float decompress     = 0; ///< Decompression and verification of the found kernels.
+    float module_load    = 0; ///< Rest of the program loading, including compilation on a miss.
+    float invokers       = 0; ///< Preparation of the invokers.
+    float total          = 0;
+};
+
+/// Selects the solutions of the problems as the immediate mode does, loads all kernels they need
+/// in parallel and registers the invokers in the handle, so that the first call for each of the
+/// problems does not have to. Problems which already have an invoker are skipped.
+PrewarmTimings Prewarm(Handle& handle, const std::vector<ProblemDescription>& problems);
+
+} // namespace conv
+} // namespace miopen
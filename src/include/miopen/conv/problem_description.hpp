@@ -38,10 +38,21 @@
 #include <miopen/sqlite_db.hpp>
 #endif
 
+#include <array>
+#include <cstdint>
+
 namespace miopen {
 
 struct ExecutionContext;
 
+namespace debug {
+
+/// Disables the per-thread cache of the text keys of the convolution problems, for measurements.
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+extern bool conv_problem_keys_cache_enabled;
+
+} // namespace debug
+
 std::string
 EncodeDataTypesForKey(miopenDataType_t in, miopenDataType_t weights, miopenDataType_t out);
 
@@ -384,18 +395,25 @@ struct ProblemDescription : ProblemDescriptionBase
 
     void HeuristicUpdateLayouts();
 
+    /// Canonical binary form of the problem. Holds everything the network config and the db key
+    /// are made of, so problems with equal encodings have equal text keys.
+    using Encoding = std::array<int64_t, 34>;
+
+    const Encoding& GetEncoding() const { return encoding; }
+
+    /// 64-bit hash of the encoding, computed once per problem. The text keys of the recently
+    /// used problems are looked up by it, and formatted only for the new ones.
+    uint64_t GetFingerprint() const { return fingerprint; }
+
     void MakeNetworkConfig(std::string& conf_key) const;
 
-    NetworkConfig MakeNetworkConfig() const override
-    {
-        std::string ret;
-        MakeNetworkConfig(ret);
-        return NetworkConfig{ret};
-    }
+    NetworkConfig MakeNetworkConfig() const override;
 
     // Todo: remove after fixing fin
     [[deprecated]] NetworkConfig BuildConfKey() const { return MakeNetworkConfig(); }
 
+    /// Returns the db key.
+    std::string Serialize() const;
     void Serialize(std::ostream& stream) const;
 
     friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
@@ -457,6 +475,12 @@ private:
     std::string out_layout;
     Direction direction = Direction::Forward;
     int bias            = 0;
+    Encoding encoding{};
+    uint64_t fingerprint = 0;
+
+    void UpdateFingerprint();
+    std::string FormatNetworkConfig() const;
+    std::string FormatKey() const;
 };
 
 } // namespace conv
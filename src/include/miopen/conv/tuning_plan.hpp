@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/conv/problem_description.hpp>
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace conv {
+
+/// Costs used to estimate the time of a search, in milliseconds.
+struct TuningCostModel
+{
+    float compile_ms = 1000; ///< Build of one program.
+    float measure_ms = 10;   ///< Measurement of one config, including the warm-up run.
+};
+
+/// Search space of a tunable solver for a problem.
+struct SolverTuningPlan
+{
+    std::string solver;
+    bool applicable           = false;
+    bool tunable              = false;
+    std::size_t primary       = 0;
+    std::size_t spare         = 0;
+    std::size_t searched      = 0; ///< Configs GenericSearch would measure.
+    std::size_t kernel_builds = 0; ///< Distinct programs of the searched configs.
+    float estimated_ms        = 0;
+    std::string error; ///< Why the search space could not be enumerated.
+};
+
+struct ProblemTuningPlan
+{
+    std::string problem; ///< Perf-db key of the problem.
+    std::vector<SolverTuningPlan> solvers;
+    std::size_t kernel_builds = 0; ///< Distinct programs of all solvers.
+    float estimated_ms        = 0;
+};
+
+struct TuningPlan
+{
+    TuningCostModel model;
+    std::size_t threads        = 0;
+    std::size_t iterations_max = 0;
+    float time_max_ms          = 0;
+    std::vector<ProblemTuningPlan> problems;
+    std::size_t kernel_builds = 0; ///< Distinct programs of all problems.
+    float estimated_ms        = 0;
+
+    void WriteJson(std::ostream& stream) const;
+};
+
+/// Estimated time of a search which builds kernel_builds programs in parallel and measures searched
+/// configs one by one, limited by time_max_ms as GenericSearch is.
+float EstimateTuningTime(std::size_t kernel_builds,
+                         std::size_t searched,
+                         const TuningCostModel& model,
+                         std::size_t threads,
+                         float time_max_ms);
+
+/// Enumerates the search spaces of all applicable convolution solvers for each of the problems,
+/// without compiling or running any kernel, e.g. on the HIPNOGPU backend, and estimates how long
+/// tuning them would take.
+TuningPlan PlanTuning(Handle& handle,
+                      const std::vector<ProblemDescription>& problems,
+                      const TuningCostModel& model);
+
+} // namespace conv
+} // namespace miopen
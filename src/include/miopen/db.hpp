@@ -27,6 +27,9 @@
 #define GUARD_MIOPEN_DB_HPP_
 
 #include <miopen/db_record.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/db_write_queue.hpp>
+#include <miopen/perf_field.hpp>
 #include <miopen/rank.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
@@ -34,7 +37,14 @@
 #include <boost/optional/optional.hpp>
 
 #include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace boost {
 namespace filesystem {
@@ -50,16 +60,51 @@ struct RecordPositions
     std::streamoff end   = -1;
 };
 
+/// Identity and size of a db file. A rewrite of the file (e.g. by compaction in another process)
+/// replaces the inode, while appends only make the file bigger. Without inodes (Windows) the id
+/// is always 0, thus only shrinking of the file can be detected.
+struct DbFileState
+{
+    std::uint64_t id      = 0;
+    std::streamoff size   = -1;
+    std::int64_t modified = 0;
+};
+
+/// Returns the default state (negative size) if the file does not exist.
+DbFileState GetDbFileState(const std::string& filename);
+
+class KernDb;
 class LockFile;
+class PlainTextDbIndex;
 
 constexpr bool DisableUserDbFileIO = MIOPEN_DISABLE_USERDB;
 
+namespace debug {
+
+/// For unit tests. Overrides MIOPEN_USER_DB_LOG_STRUCTURED when set.
+extern boost::optional<bool>& user_db_log_structured_override();
+
+} // namespace debug
+
 /// No instance of this class should be used from several threads at the same time.
+///
+/// In the log-structured mode (MIOPEN_USER_DB_LOG_STRUCTURED=1) changed records are appended to
+/// the end of the file instead of rewriting it, and removed ones are marked by an empty record
+/// ("KEY="). The last record with a key wins. The file is compacted back to the plain format
+/// (one record per key) by a background thread when the overwritten data outgrows the live data.
+/// Until then a marker file next to the db tells the instances in the plain mode to take the last
+/// record with a key, and to compact the file before they change it.
+///
+/// Lookups in this mode go through an in-memory index of record positions which is shared by all
+/// instances opened for the same file, and is only extended by appended data when the file grows.
+/// Otherwise the file is scanned, as the whole tail of the file is rewritten on every change.
 class PlainTextDb
 {
 public:
     PlainTextDb(const std::string& filename_, bool is_system = false);
 
+    static bool IsLogStructured();
+
     /// Searches db for provided key and returns found record or none if key not found in database
     boost::optional<DbRecord> FindRecord(const std::string& key);
 
@@ -143,6 +188,14 @@ public:
         return record->GetValues(id, values);
     }
 
+    /// Rewrites the file keeping only the latest version of each record.
+    ///
+    /// Returns true if compaction was successful or not required, false otherwise.
+    bool Compact();
+
+    /// Blocks until the compactions scheduled by the changes of the dbs are finished.
+    static void WaitForCompaction();
+
 protected:
     LockFile& GetLockFile() { return lock_file; }
     const std::string& GetFileName() const { return filename; }
@@ -151,13 +204,21 @@ protected:
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
+    bool CompactUnsafe();
+    bool PrepareWriteUnsafe();
 
 private:
     std::string filename;
     LockFile& lock_file;
+    PlainTextDbIndex& index;
     const bool warning_if_unreadable;
 
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
+    bool AppendUnsafe(const DbRecord& record, const RecordPositions* pos);
+    boost::optional<DbRecord> ScanRecordUnsafe(std::istream& file,
+                                               const std::string& key,
+                                               RecordPositions* pos,
+                                               bool last_wins) const;
 
     template <class T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
@@ -185,24 +246,114 @@ TRet GetDbInstance(const std::string& path, bool is_system = true)
     return GetDbInstance<TDb>(rank<1>{}, path, is_system);
 }
 
+/// Returned by BeginDbBatch() for dbs which write all changes right away.
+struct NoDbBatch
+{
+};
+
+template <class TDb>
+auto BeginDbBatch(rank<1>, TDb& db) -> decltype(db.BeginBatch())
+{
+    return db.BeginBatch();
+}
+
+template <class TDb>
+NoDbBatch BeginDbBatch(rank<0>, TDb&)
+{
+    return {};
+}
+
+/// Groups the changes made to the db until the returned object is destroyed, if the db supports
+/// it (e.g. commits them in one transaction).
+template <class TDb>
+auto BeginDbBatch(TDb& db)
+{
+    return BeginDbBatch(rank<1>{}, db);
+}
+
+/// Returns the queue of asynchronous writes to the user db file at the path. The changes are
+/// written through the instance returned by GetDbInstance<TDb>(path, false).
+template <class TDb>
+DbWriteQueue& GetDbWriteQueue(const std::string& path)
+{
+    auto& queue = DbWriteQueue::Get(path, [path]() -> std::shared_ptr<void> {
+        decltype(auto) db = GetDbInstance<TDb>(path, false);
+        using Batch       = decltype(BeginDbBatch(db));
+        return std::make_shared<Batch>(BeginDbBatch(db));
+    });
+
+    // The cache of the db instances of the type has been created with the queue, so the handler
+    // stops the queues before it is destroyed. One handler per type is enough for that.
+    static std::once_flag stop_at_exit;
+    std::call_once(stop_at_exit, []() { DbWriteQueue::StopAllAtExit(); });
+    return queue;
+}
+
+template <class TDb>
+void StoreRecordAsync(DbWriteQueue& queue, const DbRecord& record)
+{
+    queue.Store(record, [path = queue.GetPath(), record]() {
+        decltype(auto) db = GetDbInstance<TDb>(path, false);
+        return db.StoreRecord(record);
+    });
+}
+
+/// The queued changes are keyed by the DbRecord of the problem, which requires it to be
+/// serializable. The changes of other problems are written directly.
+template <class T, class = void>
+struct HasDbRecordKey : std::false_type
+{
+};
+
+template <class T>
+struct HasDbRecordKey<
+    T,
+    std::void_t<decltype(std::declval<const T&>().Serialize(std::declval<std::ostream&>()))>>
+    : std::true_type
+{
+};
+
+template <class TDb, class T, class V>
+boost::optional<DbRecord> UpdateAsync(DbWriteQueue& queue,
+                                      const T& problem_config,
+                                      const std::string& id,
+                                      const V& values)
+{
+    auto record = DbRecord{problem_config};
+    record.SetValues(id, values);
+    queue.Update(record, id, [path = queue.GetPath(), problem_config, id, values]() {
+        decltype(auto) db = GetDbInstance<TDb>(path, false);
+        return bool(db.Update(problem_config, id, values));
+    });
+    return record;
+}
+
 template <class TInstalled, class TUser, bool merge_records>
 class MultiFileDb
 {
 public:
-    MultiFileDb(const std::string& installed_path, const std::string& user_path)
+    /// Lookups are counted in the stats, if any.
+    MultiFileDb(const std::string& installed_path,
+                const std::string& user_path,
+                DbLayerStats* stats_ = nullptr)
         : _installed(GetDbInstance<TInstalled>(installed_path, true))
 #if !MIOPEN_DISABLE_USERDB
           ,
-          _user(GetDbInstance<TUser>(user_path, false))
+          _user(GetDbInstance<TUser>(user_path, false)),
+          _queue(GetWriteQueue(user_path))
 #endif
+          ,
+          stats(stats_)
     {
     }
 
     template <bool merge = merge_records, std::enable_if_t<merge>* = nullptr, typename... U>
     auto FindRecord(const U&... args)
     {
-        auto users     = _user.FindRecord(args...);
-        auto installed = _installed.FindRecord(args...);
+        const auto start = std::chrono::steady_clock::now();
+        auto users       = FindUserRecord(args...);
+        auto installed   = _installed.FindRecord(args...);
+        CountLookup(users.is_initialized(), installed.is_initialized(), start);
 
         if(users && installed)
         {
@@ -219,48 +370,112 @@ public:
     template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, typename... U>
     auto FindRecord(const U&... args)
     {
-        auto users = _user.FindRecord(args...);
-        return users ? users : _installed.FindRecord(args...);
+        const auto start = std::chrono::steady_clock::now();
+        auto users       = FindUserRecord(args...);
+        if(users)
+        {
+            CountLookup(true, false, start);
+            return users;
+        }
+        auto installed = _installed.FindRecord(args...);
+        CountLookup(false, installed.is_initialized(), start);
+        return installed;
+    }
+
+    /// Same as FindRecord, but returns the values decoded as FindDbData. The installed db shares
+    /// them rather than parses and decodes the record again if it keeps the decoded records (see
+    /// ReadonlyRamDb::FindDecodedRecord).
+    template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, class TProblem>
+    std::shared_ptr<const FindDbValues> FindDecodedRecord(const TProblem& problem)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto users = FindUserRecord(problem);
+        if(users)
+        {
+            CountLookup(true, false, start);
+            return std::make_shared<const FindDbValues>(users->template Decode<FindDbData>());
+        }
+        auto installed = FindDecoded(rank<1>{}, _installed, problem);
+        CountLookup(false, installed != nullptr, start);
+        return installed;
+    }
+
+    bool StoreRecord(const DbRecord& record)
+    {
+        if(_queue == nullptr)
+            return _user.StoreRecord(record);
+        StoreRecordAsync<TUser>(*_queue, record);
+        return true;
     }
 
     template <typename... U>
     auto StoreRecord(const U&... args)
     {
+        FlushQueue();
         return _user.StoreRecord(args...);
     }
 
     template <typename... U>
     auto UpdateRecord(U&... args)
     {
+        FlushQueue();
         return _user.UpdateRecord(args...);
     }
 
     template <typename... U>
     auto RemoveRecord(const U&... args)
     {
+        FlushQueue();
         return _user.RemoveRecord(args...);
     }
 
-    template <typename... U>
-    auto Update(const U&... args)
+    template <class T, class V>
+    auto Update(const T& problem_config, const std::string& id, const V& values)
     {
-        return _user.Update(args...);
+        if constexpr(is_queued<T>)
+        {
+            if(_queue != nullptr)
+                return UpdateAsync<TUser>(*_queue, problem_config, id, values);
+        }
+        else
+        {
+            FlushQueue();
+        }
+        return _user.Update(problem_config, id, values);
     }
 
     template <typename... U>
     auto Load(U&... args)
     {
+        if(_queue != nullptr)
+            return LoadQueued(args...);
+        const auto start = std::chrono::steady_clock::now();
         if(_user.Load(args...))
+        {
+            CountLookup(true, false, start);
             return true;
-        return _installed.Load(args...);
+        }
+        const bool found = _installed.Load(args...);
+        CountLookup(false, found, start);
+        return found;
     }
 
     template <typename... U>
     auto Remove(const U&... args)
     {
+        FlushQueue();
         return _user.Remove(args...);
     }
 
+    auto BeginBatch()
+    {
+#if !MIOPEN_DISABLE_USERDB
+        return BeginDbBatch(_user);
+#else
+        return NoDbBatch{};
+#endif
+    }
+
 private:
     template <class TDb, class TRet = decltype(TDb::GetCached("", true))>
     static TRet GetDbInstance(rank<1>, const std::string& path, bool warn_if_unreadable)
@@ -280,10 +495,96 @@ private:
         return GetDbInstance<TDb>(rank<1>{}, path, warn_if_unreadable);
     }
 
+    template <class TDb, class TProblem>
+    static auto FindDecoded(rank<1>, TDb& db, const TProblem& problem)
+        -> decltype(db.FindDecodedRecord(problem), std::shared_ptr<const FindDbValues>{})
+    {
+        // Such dbs are cached for the lifetime of the process (see GetCached()), so the values
+        // are not owned.
+        const auto values = db.FindDecodedRecord(problem);
+        if(values == nullptr)
+            return nullptr;
+        return {std::shared_ptr<const FindDbValues>{}, values};
+    }
+
+    template <class TDb, class TProblem>
+    static std::shared_ptr<const FindDbValues>
+    FindDecoded(rank<0>, TDb& db, const TProblem& problem)
+    {
+        const auto record = db.FindRecord(problem);
+        if(!record)
+            return nullptr;
+        return std::make_shared<const FindDbValues>(record->template Decode<FindDbData>());
+    }
+
+    /// Kernel dbs store binaries rather than records, their writes are never queued.
+    static constexpr bool is_queueable = !std::is_same<TUser, KernDb>{};
+
+    /// Whether the changes of the records with the keys go through the queue.
+    template <class... U>
+    static constexpr bool is_queued =
+        is_queueable && ((std::is_same<U, std::string>{} || HasDbRecordKey<U>{}) && ...);
+
+    static DbWriteQueue* GetWriteQueue(const std::string& user_path)
+    {
+        if constexpr(is_queueable)
+        {
+            if(DbWriteQueue::IsEnabled())
+                return &GetDbWriteQueue<TUser>(user_path);
+        }
+        std::ignore = user_path;
+        return nullptr;
+    }
+
+    /// The user db with the changes which are still in the write queue.
+    template <typename... U>
+    auto FindUserRecord(const U&... args)
+    {
+        auto record = _user.FindRecord(args...);
+        if constexpr(is_queued<U...>)
+        {
+            if(_queue != nullptr)
+                _queue->Overlay(DbWriteQueue::GetKey(args...), record);
+        }
+        return record;
+    }
+
+    template <class T, class V>
+    bool LoadQueued(const T& problem_config, const std::string& id, V& values)
+    {
+        const auto start  = std::chrono::steady_clock::now();
+        const auto record = FindUserRecord(problem_config);
+        if(record && record->GetValues(id, values))
+        {
+            CountLookup(true, false, start);
+            return true;
+        }
+        const bool found = _installed.Load(problem_config, id, values);
+        CountLookup(false, found, start);
+        return found;
+    }
+
+    void CountLookup(bool user_hit, bool system_hit, std::chrono::steady_clock::time_point start)
+    {
+        if(stats != nullptr)
+            stats->Count(user_hit, system_hit, start);
+    }
+
+    /// Changes written directly have to follow the queued ones.
+    void FlushQueue()
+    {
+        if(_queue != nullptr)
+            _queue->Flush();
+    }
+
     decltype(MultiFileDb::GetDbInstance<TInstalled>("", true)) _installed;
 #if !MIOPEN_DISABLE_USERDB
     decltype(MultiFileDb::GetDbInstance<TUser>("", false)) _user;
+    DbWriteQueue* _queue;
+#else
+    DbWriteQueue* _queue = nullptr;
 #endif
+    DbLayerStats* stats;
 };
 
 template <class TInnerDb>
@@ -301,6 +602,12 @@ public:
         return Measure("FindRecord", [&]() { return inner.FindRecord(args...); });
     }
 
+    template <typename... U>
+    auto FindDecodedRecord(const U&... args)
+    {
+        return Measure("FindDecodedRecord", [&]() { return inner.FindDecodedRecord(args...); });
+    }
+
     template <typename... U>
     auto StoreRecord(U&... record)
     {
@@ -337,6 +644,8 @@ public:
         return Measure("Remove", [&]() { return inner.Remove(args...); });
     }
 
+    auto BeginBatch() { return BeginDbBatch(inner); }
+
 private:
     TInnerDb inner;
 
@@ -29,12 +29,16 @@
 #include <miopen/config.h>
 
 #include <miopen/logger.hpp>
+#include <miopen/rank.hpp>
 
 #include <cassert>
 #include <istream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
@@ -161,15 +165,28 @@ private:
     std::unordered_map<std::string, std::string> map;
 
     template <class T>
-    static // 'static' is for calling from ctor
-        std::string
-        Serialize(const T& data)
+    static auto Serialize(rank<1>, const T& data) -> decltype(std::string{data.Serialize()})
+    {
+        return data.Serialize();
+    }
+
+    template <class T>
+    static std::string Serialize(rank<0>, const T& data)
     {
         std::ostringstream ss;
         data.Serialize(ss);
         return ss.str();
     }
 
+    /// Types which cache their keys provide "std::string Serialize() const" as well.
+    template <class T>
+    static // 'static' is for calling from ctor
+        std::string
+        Serialize(const T& data)
+    {
+        return Serialize(rank<1>{}, data);
+    }
+
     bool ParseContents(std::istream& contents);
     void WriteContents(std::ostream& stream) const;
     void WriteIdsAndValues(std::ostream& stream) const;
@@ -178,11 +195,9 @@ private:
 
     DbRecord(const std::string& key_) : key(key_) {}
 
-    bool ParseContents(const std::string& contents)
-    {
-        auto ss = std::istringstream(contents);
-        return ParseContents(ss);
-    }
+    /// Parses the contents in place, without copying them to a stream.
+    bool ParseContents(std::string_view contents);
+    bool ParseItem(std::string_view id_and_values);
 
 public:
     DbRecord() : key(""){};
@@ -246,9 +261,18 @@ public:
         return *this;
     }
 
+    /// Deserializes all VALUES of the record at once.
+    template <class TValue>
+    std::vector<std::pair<std::string, TValue>> Decode() const
+    {
+        const auto range = As<TValue>();
+        return {range.begin(), range.end()};
+    }
+
     friend class PlainTextDb;
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
+    friend class ReadonlyMappedDb;
     friend class RamDb;
 };
 
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_STATS_HPP_
+#define GUARD_MIOPEN_DB_STATS_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace miopen {
+
+/// Number of operations and a histogram of their latencies with power of 2 buckets: bucket i
+/// counts the operations which took less than 2^i microseconds, the last one counts all longer.
+struct LatencyStats
+{
+    static constexpr std::size_t buckets = 24;
+
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+    std::array<std::atomic<uint64_t>, buckets> histogram{};
+
+    void Add(std::chrono::nanoseconds time);
+    void AddSince(std::chrono::steady_clock::time_point start)
+    {
+        Add(std::chrono::steady_clock::now() - start);
+    }
+    void Reset();
+};
+
+/// Lookups of a db with the user and the system layers, e.g. MultiFileDb.
+struct DbLayerStats
+{
+    std::atomic<uint64_t> user_hits{0};
+    std::atomic<uint64_t> system_hits{0};
+    std::atomic<uint64_t> misses{0};
+    LatencyStats lookup;
+
+    void Count(bool user_hit, bool system_hit, std::chrono::steady_clock::time_point start);
+    void Reset();
+};
+
+/// Process-wide statistics of the db lookups, kernel compilations and immediate mode fallbacks,
+/// used to detect deployments which miss the dbs. Counters are updated with relaxed atomics.
+struct DbStats
+{
+    DbLayerStats find_db;
+    DbLayerStats perf_db;
+    DbLayerStats kern_db;
+    /// Kernels saved to the kernel cache.
+    LatencyStats kernel_stores;
+    /// Kernels compiled because they were not found in the kernel cache.
+    LatencyStats compilations;
+
+    std::atomic<uint64_t> fallback_ai{0};
+    std::atomic<uint64_t> fallback_nearest{0};
+    std::atomic<uint64_t> fallback_wti{0};
+    std::atomic<uint64_t> fallback_failed{0};
+
+    void Reset();
+    void WriteJson(std::ostream& stream) const;
+};
+
+/// Statistics are written as JSON to the file set by MIOPEN_DB_STATISTICS_FILE at exit.
+DbStats& GetDbStats();
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_STATS_HPP_
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
+#define GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
+
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace miopen {
+
+namespace debug {
+
+/// For unit tests. Overrides MIOPEN_USER_DB_ASYNC_WRITES when set.
+extern boost::optional<bool>& user_db_async_writes_override();
+
+} // namespace debug
+
+/// Changes of a user db file which are written by a background thread, so that Find and tuning
+/// do not wait for the file lock and disk I/O. Enabled by MIOPEN_USER_DB_ASYNC_WRITES=1, see
+/// GetDbWriteQueue() in db.hpp.
+///
+/// Changes of the same record (or of the same id within a record) which have not been written yet
+/// are coalesced, only the latest is written. Lookups made through the queue see the pending
+/// changes. The queue is bounded: a writer waits for the background thread when it is full.
+/// The queues of the user dbs of a handle are flushed when it is destroyed, all queues at exit.
+class DbWriteQueue
+{
+public:
+    static bool IsEnabled();
+
+    using BatchFactory = std::function<std::shared_ptr<void>()>;
+
+    /// Returns the queue of the user db file at the path, creating it on the first use. Each time
+    /// the background thread writes the pending changes, it keeps the object returned by
+    /// begin_batch alive until all of them are written.
+    static DbWriteQueue& Get(const std::string& path, const BatchFactory& begin_batch);
+
+    /// Registers an exit handler which stops all queues, writing their pending changes. Static
+    /// objects created before the registration are destroyed after the handler runs.
+    static void StopAllAtExit();
+
+    /// Returns nullptr if the queue of the path has not been created.
+    static DbWriteQueue* Find(const std::string& path);
+
+    const std::string& GetPath() const { return path; }
+
+    /// Blocks until all changes queued before the call are written.
+    void Flush();
+    static void FlushAll();
+    /// Only the queues of the files whose names start with the prefix, e.g. the user dbs of a
+    /// handle, which are named after Handle::GetDbBasename().
+    static void FlushAll(const std::string& name_prefix);
+
+    /// False until the first queue is created, i.e. if the writes are not asynchronous.
+    static bool HasQueues();
+
+    /// The record replaces the one with the same key. `write` stores it to the db.
+    void Store(const DbRecord& record, std::function<bool()> write);
+    /// The values under the id are set in the record with the same key.
+    void Update(const DbRecord& values, const std::string& id, std::function<bool()> write);
+
+    /// Applies the pending changes of the record with the key to the one read from the db.
+    void Overlay(const std::string& key, boost::optional<DbRecord>& record) const;
+
+    struct Stats
+    {
+        std::size_t queued  = 0; ///< Changes passed to Store() and Update().
+        std::size_t written = 0; ///< Changes written to the db, after coalescing.
+    };
+
+    Stats GetStats() const;
+
+    static std::string GetKey(const std::string& key) { return key; }
+
+    template <class T>
+    static std::string GetKey(const T& problem_config)
+    {
+        return DbRecord{problem_config}.GetKey();
+    }
+
+    DbWriteQueue(const DbWriteQueue&) = delete;
+    DbWriteQueue& operator=(const DbWriteQueue&) = delete;
+    ~DbWriteQueue();
+
+private:
+    struct Change
+    {
+        std::uint64_t sequence;
+        DbRecord record;
+        /// Empty if the record is replaced as a whole.
+        std::string id;
+        std::function<bool()> write;
+    };
+
+    /// Keyed by the record key and the id, so that the changes of a record are adjacent.
+    using Changes = std::map<std::pair<std::string, std::string>, Change>;
+
+    std::string path;
+    BatchFactory begin_batch;
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::condition_variable written;
+    Changes pending;
+    Changes in_flight;
+    std::uint64_t next_sequence    = 1;
+    std::uint64_t written_sequence = 0;
+    Stats stats;
+    bool stopping = false;
+    std::thread thread;
+
+    DbWriteQueue(std::string path_, BatchFactory begin_batch_);
+
+    void Enqueue(const DbRecord& record, const std::string& id, std::function<bool()> write);
+    void Run();
+    void Stop();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
@@ -31,14 +31,19 @@
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_stats.hpp>
 #include <miopen/env.hpp>
+#include <miopen/find_db_shards.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/ramdb.hpp>
+#include <miopen/readonlymappeddb.hpp>
 #include <miopen/readonlyramdb.hpp>
 
 #include <boost/optional.hpp>
 
+#include <chrono>
 #include <functional>
+#include <memory>
 #include <vector>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_FIND_DB)
@@ -52,7 +57,11 @@ template <class TDb>
 class FindDbRecord_t;
 
 #if MIOPEN_DEBUG_FIND_DB_CACHING
+#if MIOPEN_FIND_DB_BINARY
+using SystemFindDb = ReadonlyMappedDb;
+#else
 using SystemFindDb = ReadonlyRamDb;
+#endif
 using UserFindDb   = RamDb;
 #else
 using SystemFindDb = PlainTextDb;
@@ -93,18 +102,20 @@ public:
                    is_immediate_t<TTestDb>        = 0)
         : path(debug::testing_find_db_path_override() ? *debug::testing_find_db_path_override()
                                                       : GetUserPath(handle, path_suffix)),
-          installed_path(debug::testing_find_db_path_override()
-                             ? *debug::testing_find_db_path_override()
-                             : GetInstalledPath(handle, path_suffix)),
+          installed_path(GetSystemShardPath(handle, problem, path_suffix)),
           db(boost::make_optional<DbTimer<TDb>>(debug::testing_find_db_enabled &&
                                                     !IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}),
-                                                DbTimer<TDb>{installed_path, path}))
+                                                DbTimer<TDb>{installed_path,
+                                                             path,
+                                                             &GetDbStats().find_db}))
     {
         if(!db.is_initialized())
             return;
 
-        content = db->FindRecord(problem);
-        in_sync = content.is_initialized();
+        // The immediate mode only reads the record, so the decoded values of the system db are
+        // shared rather than copied.
+        values  = db->FindDecodedRecord(problem);
+        in_sync = values != nullptr;
     }
 
     template <class TProblemDescription, class TTestDb = TDb>
@@ -125,23 +136,36 @@ public:
         if(!db.is_initialized())
             return;
 
-        content = db->FindRecord(problem);
+        // Stores of the immediate mode records are queued by MultiFileDb itself.
+        if(DbWriteQueue::IsEnabled())
+            queue = &GetDbWriteQueue<UserFindDb>(path);
+
+        const auto start = std::chrono::steady_clock::now();
+        content          = db->FindRecord(problem);
+        if(queue != nullptr)
+            queue->Overlay(DbWriteQueue::GetKey(problem), content);
         in_sync = content.is_initialized();
+        if(in_sync)
+            values = std::make_shared<const FindDbValues>(content->Decode<FindDbData>());
+        GetDbStats().find_db.Count(in_sync, false, start);
     }
 
     ~FindDbRecord_t()
     {
         if(!db.is_initialized() || !content.is_initialized() || in_sync)
             return;
+        if(queue != nullptr)
+        {
+            StoreRecordAsync<UserFindDb>(*queue, content.get());
+            return;
+        }
         if(!db->StoreRecord(content.get()))
             MIOPEN_LOG_E("Failed to store record to find-db at <" << path << ">");
     }
 
-    auto begin() const { return content->As<FindDbData>().begin(); }
-    auto begin() { return content->As<FindDbData>().begin(); }
-    auto end() const { return content->As<FindDbData>().end(); }
-    auto end() { return content->As<FindDbData>().end(); }
-    bool empty() const { return !content.is_initialized(); }
+    auto begin() const { return values->begin(); }
+    auto end() const { return values->end(); }
+    bool empty() const { return values == nullptr; }
 
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
@@ -170,11 +194,37 @@ public:
         return ret;
     }
 
+    /// Path of the system find-db used for the handle.
+    static std::string GetSystemPath(Handle& handle, const std::string& path_suffix = "")
+    {
+        return debug::testing_find_db_path_override() ? *debug::testing_find_db_path_override()
+                                                      : GetInstalledPath(handle, path_suffix);
+    }
+
+    /// Path of the system find-db holding the record of the problem, which is a shard of the db
+    /// if it is split (see FindDbShards).
+    template <class TProblemDescription>
+    static std::string GetSystemShardPath(Handle& handle,
+                                          const TProblemDescription& problem,
+                                          const std::string& path_suffix = "")
+    {
+        auto path          = GetSystemPath(handle, path_suffix);
+        const auto& shards = FindDbShards::GetCached(path);
+        // The key of the problem is only serialized to pick a shard.
+        if(!shards.IsSharded())
+            return path;
+        return shards.GetPath(DbRecord{problem}.GetKey());
+    }
+
 private:
     std::string path;
     std::string installed_path;
     boost::optional<DbTimer<TDb>> db;
+    DbWriteQueue* queue = nullptr;
+    /// Loaded or regenerated record, which is stored to the db if it is not in sync.
     boost::optional<DbRecord> content{boost::none};
+    /// Values of the loaded record.
+    std::shared_ptr<const FindDbValues> values;
     bool in_sync = false;
 
     static std::string GetInstalledPath(Handle& handle, const std::string& path_suffix);
@@ -186,7 +236,8 @@ private:
     bool Validate(Handle& handle, const NetworkConfig& config) const;
     void CopyTo(std::vector<PerfField>& to) const;
 
-    void LogFindDbItem(const std::pair<std::string, FindDbData>& item) const;
+    void LogFindDbItem(const std::pair<std::string, FindDbData>& item,
+                       const NetworkConfig& config) const;
 };
 
 extern template class FindDbRecord_t<FindDb>;
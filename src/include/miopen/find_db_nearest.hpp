@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FIND_DB_NEAREST_HPP_
+#define GUARD_MIOPEN_FIND_DB_NEAREST_HPP_
+
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// Features of a convolution problem, parsed from its find-db key.
+struct FindDbKeyFeatures
+{
+    /// Everything that must match exactly: filter size, pads, strides, dilations, bias, layouts,
+    /// data types, direction and the optional part of the key (group count, cast types).
+    std::string bucket;
+    /// log2 of the input channels, output channels, batch size and input depth, height, width.
+    std::array<double, 6> sizes;
+    /// Number of multiply-accumulates divided by the filter size, which is the same within the
+    /// bucket.
+    double work;
+
+    static boost::optional<FindDbKeyFeatures> Parse(const std::string& key);
+
+    double Distance(const FindDbKeyFeatures& other) const;
+};
+
+/// Index of the find-db keys, used to estimate the solvers for a problem which is not in the
+/// find-db from the records of the most similar problems that are there.
+///
+/// Only the problems which differ in the tensor sizes are considered similar. Within the same
+/// bucket the distance is measured between the logarithms of the sizes, so the problems which
+/// differ twice in size are equally similar regardless of the size itself.
+class FindDbNearest
+{
+public:
+    struct Neighbour
+    {
+        std::string key;
+        double distance;
+        /// Work of the queried problem divided by the work of this one.
+        double work_ratio;
+    };
+
+    struct Estimate
+    {
+        std::string solver;
+        std::string algorithm;
+        /// Expected time, ms.
+        float time;
+    };
+
+    /// Returns false if the key can't be parsed.
+    bool Add(const std::string& key);
+    std::size_t GetSize() const { return size; }
+
+    /// Returns up to count nearest keys, the nearest first.
+    std::vector<Neighbour> Find(const std::string& key, std::size_t count) const;
+
+    /// Ranks the solvers found in the records of the neighbours, the fastest first.
+    ///
+    /// Each record votes with the time of the solver relative to the best one in the record,
+    /// weighted by the similarity of the problem. Records which miss a solver do not vote for it.
+    /// The expected time is the ranking score applied to the best time of the nearest record,
+    /// scaled by the work ratio.
+    static std::vector<Estimate>
+    Rank(const std::vector<Neighbour>& neighbours,
+         const std::function<boost::optional<DbRecord>(const std::string&)>& load);
+
+    /// Index of the system find-db at the path. Built on the first use and shared by all
+    /// handles. Empty if the system find-db is not cached in memory.
+    static const FindDbNearest& GetCached(const std::string& path);
+
+    /// Ranks the solvers for the key from up to count nearest records of the system find-db.
+    static std::vector<Estimate>
+    GetEstimates(const std::string& path, const std::string& key, std::size_t count);
+
+private:
+    struct Point
+    {
+        std::string key;
+        FindDbKeyFeatures features;
+    };
+
+    std::unordered_map<std::string, std::vector<Point>> buckets;
+    std::size_t size = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_DB_NEAREST_HPP_
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FIND_DB_SHARDS_HPP_
+#define GUARD_MIOPEN_FIND_DB_SHARDS_HPP_
+
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace miopen {
+
+/// The system find-db may be split into shards by the layouts, data types and direction of the
+/// problems, so that a process only loads the records of the kinds of problems it runs.
+///
+/// The records of the shard are stored in <db>.<shard>.txt next to the <db>.txt, e.g.
+/// gfx906_60.HIP.fdb.NCHW-FP16-F.txt, and the names of all the shards are listed in
+/// <db>.shards. The db is treated as sharded only if the list exists.
+class FindDbShards
+{
+public:
+    /// Reads the list of the shards of the db at most once per process.
+    static const FindDbShards& GetCached(const std::string& path);
+
+    /// Returns the shard of the record, which is the part of the key after the tensor sizes and
+    /// convolution parameters, up to the optional part: e.g. "NCHW-FP16-F" for
+    /// 64-56-56-3x3-64-56-56-8-1x1-1x1-1x1-0-NCHW-FP16-F_g2. Empty if the key has no such part.
+    static std::string_view GetShard(std::string_view key);
+    static std::string GetShardPath(const std::string& path, std::string_view shard);
+    static std::string GetListPath(const std::string& path);
+
+    bool IsSharded() const { return sharded; }
+
+    /// Returns the path of the db holding the record under the key: the path of the shard,
+    /// an empty path if there is no such shard, or the path of the whole db if it is not sharded
+    /// or the key has no shard.
+    std::string GetPath(std::string_view key) const;
+
+private:
+    std::string path;
+    bool sharded = false;
+    std::set<std::string, std::less<>> shards;
+
+    void Load();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_DB_SHARDS_HPP_
@@ -29,13 +29,18 @@
 
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
+#include <miopen/db.hpp>
 #include <miopen/execution_context.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/problem_key.hpp>
+#include <miopen/rank.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/tuning_journal.hpp>
 
 #include <limits>
+#include <memory>
 #include <vector>
 
 namespace miopen {
@@ -121,7 +126,9 @@ auto FindSolutionImpl(rank<1>,
             try
             {
                 auto c = s.Search(context, problem, invoke_ctx);
-                db.Update(problem, s.SolverDbId(), c);
+                // The workers of a distributed search leave it to the merge.
+                if(!solver::IsTuningWorker())
+                    db.Update(problem, s.SolverDbId(), c);
                 return s.GetSolution(context, problem, c);
             }
             catch(const miopen::Exception& ex)
@@ -185,6 +192,8 @@ struct SolverContainer
         std::vector<Solution> ss;
         std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
+        // Tuning results of all solvers are committed to the perf-db at once.
+        [[maybe_unused]] const auto batch = BeginDbBatch(db);
         miopen::each_args(
             [&](auto solver) {
                 if(count >= limit)
@@ -354,9 +363,9 @@ struct SolverContainer
                           const AlgorithmName& algo,
                           const AnyInvokeParams& invoke_params) const
     {
-        const auto network_config = problem.MakeNetworkConfig();
+        const auto network_config = GetPrimitiveNetworkConfig(rank<1>{}, problem);
 
-        if(const auto existingInvoker = handle.GetInvoker(network_config, boost::none, algo))
+        if(const auto existingInvoker = handle.GetInvoker(*network_config, boost::none, algo))
         {
             (*existingInvoker)(handle, invoke_params);
             return;
@@ -372,9 +381,27 @@ struct SolverContainer
         if(!sln.invoker_factory)
             MIOPEN_THROW(miopenStatusInternalError, "Invoker missing in solver " + sln.solver_id);
         const auto invoker = handle.PrepareInvoker(*sln.invoker_factory, sln.construction_params);
-        handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
+        handle.RegisterInvoker(invoker, *network_config, sln.solver_id, algo);
         invoker(handle, invoke_params);
     }
+
+private:
+    // The primitives which can be described by a ProblemKey format their network configs only once
+    // per thread.
+    template <class Problem>
+    static auto GetPrimitiveNetworkConfig(rank<1>, const Problem& problem)
+        -> decltype(problem.MakeProblemKey(), std::shared_ptr<const NetworkConfig>{})
+    {
+        return GetNetworkConfig(problem.MakeProblemKey(),
+                                [&]() { return problem.MakeNetworkConfig(); });
+    }
+
+    template <class Problem>
+    static std::shared_ptr<const NetworkConfig> GetPrimitiveNetworkConfig(rank<0>,
+                                                                          const Problem& problem)
+    {
+        return std::make_shared<const NetworkConfig>(problem.MakeNetworkConfig());
+    }
 };
 
 } // namespace solver
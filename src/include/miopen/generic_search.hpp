@@ -28,8 +28,10 @@
 #define GUARD_MIOPEN_GENERIC_SEARCH_HPP_
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/compile_job_table.hpp>
 #include <miopen/config.h>
 #include <miopen/conv_solution.hpp>
+#include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/execution_context.hpp>
 #include <miopen/handle.hpp>
@@ -39,8 +41,15 @@
 #include <miopen/type_traits.hpp>
 #include <miopen/mt_queue.hpp>
 #include <miopen/generic_search_controls.hpp>
+#include <miopen/tuning_journal.hpp>
+#include <miopen/tuning_strategy.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include <cstdlib>
 #include <limits>
@@ -48,6 +57,10 @@
 #include <chrono>
 #include <cassert>
 #include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
 
 namespace miopen {
 namespace solver {
@@ -303,46 +316,106 @@ std::size_t GetTuningIterationsMax();
 std::chrono::milliseconds GetTuningTimeMax(); // returns the max allowed time in milliseconds
 std::size_t GetTuningThreadsMax();
 
+/// Search space of a solver for a problem, enumerated without compiling or running anything.
+struct TuningSpace
+{
+    std::size_t primary  = 0;
+    std::size_t spare    = 0;
+    std::size_t searched = 0; ///< Configs GenericSearch would measure.
+    /// Distinct programs (kernel file, compiler options) of the searched configs.
+    std::set<std::pair<std::string, std::string>> programs;
+};
+
+template <class Solver, class Context, class Problem>
+TuningSpace GetTuningSpace(const Solver s, const Context& context_, const Problem& problem)
+{
+    auto context                  = context_;
+    context.is_for_generic_search = true;
+
+    using PerformanceConfig = decltype(s.GetDefaultPerformanceConfig(context, problem));
+    const ComputedContainer<PerformanceConfig, Context, Problem> primary(context, problem);
+    const ComputedContainer<PerformanceConfig, Context, Problem> spare(context, problem, true);
+
+    auto space    = TuningSpace{};
+    space.primary = std::distance(primary.begin(), primary.end());
+    space.spare   = std::distance(spare.begin(), spare.end());
+
+    const auto add_programs = [&](const PerformanceConfig& config) {
+        for(const auto& kernel : s.GetSolution(context, problem, config).construction_params)
+            space.programs.emplace(kernel.kernel_file, kernel.comp_options);
+    };
+
+    if(space.primary == 0 && space.spare == 0)
+    {
+        // The search falls back to the default config.
+        space.searched = 1;
+        add_programs(s.GetDefaultPerformanceConfig(context, problem));
+        return space;
+    }
+
+    // The search measures a random subset if the number of iterations is limited, the programs are
+    // counted for the first configs instead.
+    space.searched = std::min(space.primary != 0 ? space.primary : space.spare,
+                              GetTuningIterationsMax());
+    auto n_configs = std::size_t{0};
+    for(const auto& config : space.primary != 0 ? primary : spare)
+    {
+        if(n_configs++ == space.searched)
+            break;
+        add_programs(config);
+    }
+    return space;
+}
+
+/// Compiles the kernels of every total_threads-th config of the batch, starting from thread_index,
+/// and queues their solutions for the measurement. The end of each agent is signaled by an item
+/// with the flag set.
 template <typename PerformanceConfig, typename Solver, typename Context, typename Problem>
 void CompileAgent(size_t thread_index,
                   size_t total_threads,
                   const Solver& s,
                   const Context& context,
                   const Problem& problem,
-                  std::vector<PerformanceConfig>& data,
-                  ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>>& comp_queue)
+                  const std::vector<PerformanceConfig>& data,
+                  std::chrono::steady_clock::time_point deadline,
+                  const std::atomic<bool>& stopped,
+                  ThreadSafeQueue<std::tuple<std::size_t, ConvSolution, bool>>& comp_queue)
 {
-    const auto start_time =
-        std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now());
-    const auto data_size   = data.size();
-    const auto time_budget = GetTuningTimeMax();
-    const auto& profile_h  = context.GetStream();
-    // start the counter
+    const auto data_size  = data.size();
+    const auto& profile_h = context.GetStream();
     for(auto idx = thread_index; idx < data_size; idx += total_threads)
     {
+        if(stopped)
+        {
+            MIOPEN_LOG_I2("Thread: " << thread_index << " Done, search stopped");
+            break;
+        }
         // Check if we are out of time
-        const auto current_time = std::chrono::time_point_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now());
-        if(current_time - start_time > time_budget)
+        if(std::chrono::steady_clock::now() > deadline)
         {
             MIOPEN_LOG_I2("Thread: " << thread_index << " Done, exhausted time budget");
-            auto tmp = std::make_tuple<PerformanceConfig, ConvSolution, bool>({}, {}, true);
-            comp_queue.push(std::move(tmp));
             break;
         }
-        auto& current_config          = data.at(idx);
-        ConvSolution current_solution = s.GetSolution(context, problem, current_config);
+        ConvSolution current_solution = s.GetSolution(context, problem, data[idx]);
         for(const auto& kernel : current_solution.construction_params)
         {
             if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
                 continue;
-            std::ignore = profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
+            try
+            {
+                PrecompileProgram(profile_h, kernel.kernel_file, kernel.comp_options);
+            }
+            catch(const std::exception& ex)
+            {
+                // The measurement fails for this config.
+                MIOPEN_LOG_W("Thread: " << thread_index << " Failed to compile "
+                                        << kernel.kernel_file << ": " << ex.what());
+            }
         }
-        auto tup = std::make_tuple<PerformanceConfig, ConvSolution, bool>(
-            std::move(current_config), std::move(current_solution), false);
-        comp_queue.push(std::move(tup));
+        comp_queue.push(std::make_tuple(idx, std::move(current_solution), false));
     }
     MIOPEN_LOG_I2("Thread: " << thread_index << " Done, completed tuning");
+    comp_queue.push(std::make_tuple(std::size_t{0}, ConvSolution{}, true));
 }
 
 template <class Solver, class Context, class Problem>
@@ -377,12 +450,29 @@ auto GenericSearch(const Solver s,
     // For random access
     std::vector<PerformanceConfig> all_configs;
     std::copy(tmp_all_configs.begin(), tmp_all_configs.end(), std::back_inserter(all_configs));
-    // shuffle the configs
-    std::random_device rd{};
-    auto rng = std::default_random_engine{rd()};
-    std::shuffle(all_configs.begin(), all_configs.end(), rng);
+
+    const auto compile_only = IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{});
+    auto session =
+        compile_only ? TuningSession{}
+                     : OpenTuningSession(context, DbRecord{problem}.GetKey(), s.SolverDbId());
+    if(session.IsWorker() && !all_configs.empty())
+    {
+        // A worker of the distributed search measures its share of the configs, selected by their
+        // indices in the search space.
+        std::vector<PerformanceConfig> owned;
+        for(auto i = std::size_t{0}; i < all_configs.size(); ++i)
+        {
+            if(session.Owns(i))
+                owned.push_back(std::move(all_configs[i]));
+        }
+        if(owned.empty())
+        {
+            MIOPEN_LOG_W("No configs left for this tuning worker");
+            return s.GetDefaultPerformanceConfig(context, problem);
+        }
+        all_configs = std::move(owned);
+    }
     std::size_t n_runs_total = std::min(all_configs.size(), GetTuningIterationsMax());
-    all_configs.resize(n_runs_total);
 
     if(all_configs.empty())
     {
@@ -408,45 +498,116 @@ auto GenericSearch(const Solver s,
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
-    const auto total_threads = GetTuningThreadsMax();
-
-    ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>> solution_queue;
-    std::vector<std::thread> compile_agents;
-    compile_agents.reserve(total_threads);
-    for(auto idx = 0; idx < total_threads; ++idx)
+    const auto compile_stats = CompileJobTable::Get().GetStats();
+    const auto total_threads = std::max<std::size_t>(GetTuningThreadsMax(), 1);
+    const auto deadline      = std::chrono::steady_clock::now() + GetTuningTimeMax();
+    // Without the measurements only the random order makes sense.
+    const auto strategy = compile_only
+                              ? std::unique_ptr<TuningStrategy>{new RandomTuningStrategy{}}
+                              : MakeTuningStrategy(total_threads);
+    strategy->Init(all_configs.size(),
+                   [&](std::size_t i) { return GetTuningFeatures(all_configs[i]); });
+    auto early_stop = MakeTuningEarlyStop();
+
+    size_t n_current = 0;
+    std::atomic<bool> stopped{false};
+
+    const auto serialize = [](const PerformanceConfig& config) {
+        std::ostringstream ss;
+        config.Serialize(ss);
+        return ss.str();
+    };
+    if(session.HasEntries())
     {
-        compile_agents.emplace_back(CompileAgent<PerformanceConfig, Solver, Context, Problem>,
-                                    idx,
-                                    total_threads,
-                                    std::cref(s),
-                                    std::cref(context),
-                                    std::cref(problem),
-                                    std::ref(all_configs),
-                                    std::ref(solution_queue));
+        // Resume the interrupted search, or merge the results of the workers of the distributed
+        // one: the configs measured before are skipped.
+        std::vector<std::string> serialized;
+        serialized.reserve(all_configs.size());
+        std::transform(all_configs.begin(),
+                       all_configs.end(),
+                       std::back_inserter(serialized),
+                       serialize);
+        for(const auto& measurement : session.Restore(serialized))
+        {
+            if(n_current >= n_runs_total)
+                break;
+            strategy->Restore(measurement.index, measurement.time);
+            if(measurement.time)
+            {
+                is_passed = true;
+                if(*measurement.time < best_time)
+                {
+                    best_config = all_configs[measurement.index];
+                    best_time   = *measurement.time;
+                    n_best      = n_current;
+                }
+            }
+            else
+            {
+                ++n_failed;
+            }
+            ++n_current;
+            if(early_stop.Update(measurement.time))
+                stopped = true;
+        }
+        MIOPEN_LOG_W("Resuming search from " << session.GetPath() << ", " << n_current
+                                             << " configs measured before, best " << best_time
+                                             << ' ' << best_config);
     }
 
-    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+    bool exhausted = false;
+    // The configs are compiled in parallel by batches proposed by the strategy, and measured as
+    // soon as they are compiled.
+    while(!stopped && n_current < n_runs_total && std::chrono::steady_clock::now() <= deadline)
     {
-        size_t n_current       = 0;
-        auto threads_remaining = total_threads;
-        while(true)
+        const auto proposal = strategy->Propose(n_runs_total - n_current);
+        if(proposal.empty())
+        {
+            exhausted = true;
+            break;
+        }
+        std::vector<PerformanceConfig> batch;
+        batch.reserve(proposal.size());
+        for(const auto index : proposal)
+            batch.push_back(all_configs[index]);
+
+        ThreadSafeQueue<std::tuple<std::size_t, ConvSolution, bool>> solution_queue;
+        const auto n_agents = std::min(total_threads, batch.size());
+        std::vector<std::thread> compile_agents;
+        compile_agents.reserve(n_agents);
+        for(auto idx = std::size_t{0}; idx < n_agents; ++idx)
+        {
+            compile_agents.emplace_back(CompileAgent<PerformanceConfig, Solver, Context, Problem>,
+                                        idx,
+                                        n_agents,
+                                        std::cref(s),
+                                        std::cref(context),
+                                        std::cref(problem),
+                                        std::cref(batch),
+                                        deadline,
+                                        std::cref(stopped),
+                                        std::ref(solution_queue));
+        }
+
+        auto agents_remaining = n_agents;
+        while(agents_remaining > 0)
         {
-            if(n_current >= n_runs_total)
-                break;
             MIOPEN_LOG_I2("Waiting for item in queue");
-            const auto kinder     = solution_queue.pop();
-            auto current_config   = std::get<0>(kinder);
-            auto current_solution = std::get<1>(kinder);
+            const auto kinder            = solution_queue.pop();
+            const auto& current_config   = batch[std::get<0>(kinder)];
+            const auto& current_solution = std::get<1>(kinder);
 
             if(std::get<2>(kinder))
             {
-                threads_remaining--;
-                if(threads_remaining == 0)
-                    break;
-                else
-                {
-                    continue;
-                }
+                --agents_remaining;
+                continue;
+            }
+
+            if(compile_only || stopped)
+            {
+                for(const auto& kernelInfo : current_solution.construction_params)
+                    profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+                continue;
             }
 
             float elapsed_time = 0.0f;
@@ -554,18 +715,36 @@ auto GenericSearch(const Solver s,
                               n_runs_total,
                               current_config);
             ++n_current;
+
+            const auto measured =
+                ret == 0 ? boost::optional<float>{elapsed_time} : boost::optional<float>{};
+            session.Append(serialize(current_config), measured);
+            strategy->Report(proposal[std::get<0>(kinder)], measured);
+            if(early_stop.Update(measured))
+            {
+                MIOPEN_LOG_W("Search has converged after " << n_current << " configs");
+                stopped = true;
+            }
+        }
+
+        for(auto& agent : compile_agents)
+            agent.join();
+
+        if(compile_only)
+        {
+            MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
+                         "Running kernels on GPU is disabled. Search skipped");
         }
-    }
-    else
-    {
-        MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
-                     "Running kernels on GPU is disabled. Search skipped");
     }
 
-    for(auto& agent : compile_agents)
-        agent.join();
+    // An incomplete search, e.g. the one which has run out of time, is continued by the next one.
+    if(exhausted || stopped || n_current >= n_runs_total)
+        session.Complete();
 
-    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
+    const auto compiled = CompileJobTable::Get().GetStats();
+    MIOPEN_LOG_I("Kernel compilations: " << compiled.run - compile_stats.run << ", avoided: "
+                                         << compiled.Avoided() - compile_stats.Avoided());
+    MIOPEN_LOG_W("Done: " << n_current << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best << ' ' << best_time << ' ' << best_config);
 
     if(!is_passed)
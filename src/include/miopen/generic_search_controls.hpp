@@ -34,6 +34,11 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_ITERATIONS_MAX)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_TIME_MS_MAX)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_STRATEGY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_EARLY_STOP)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_CHECKPOINT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_JOURNAL_DIR)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_SHARD)
 
 } // namespace solver
 } // namespace miopen
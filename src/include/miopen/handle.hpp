@@ -34,6 +34,7 @@
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
 #include <miopen/object.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/allocator.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/solver_id.hpp>
@@ -46,6 +47,7 @@
 #include <cstring>
 #include <ios>
 #include <sstream>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -66,6 +68,7 @@
 namespace miopen {
 
 struct HandleImpl;
+struct KernelCacheStats;
 #if MIOPEN_USE_MIOPENGEMM
 struct GemmGeometry;
 using GemmKey = std::pair<std::string, std::string>;
@@ -119,6 +122,12 @@ struct Handle : miopenHandle
         return this->GetKernelsImpl(algorithm, network_config) |
                boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
     }
+    /// Does not format the network config when the kernels were looked up by the key before.
+    auto GetKernels(std::string_view algorithm, const ProblemKey& network_config) const
+    {
+        return this->GetKernelsImpl(algorithm, network_config) |
+               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+    }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
     {
         auto ks = this->GetKernelsImpl(algorithm, network_config);
@@ -133,7 +142,11 @@ struct Handle : miopenHandle
     KernelInvoke Run(Kernel k) const;
     const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
                                               const std::string& network_config) const;
+    const std::vector<Kernel>& GetKernelsImpl(std::string_view algorithm,
+                                              const ProblemKey& network_config) const;
 
+    /// Loads the program from the kernel db or compiles it. On HIP the programs already loaded by
+    /// another handle on the same device are shared.
     Program LoadProgram(const std::string& program_name,
                         std::string params,
                         bool is_kernel_str,
@@ -142,6 +155,13 @@ struct Handle : miopenHandle
     bool HasProgram(const std::string& program_name, const std::string& params) const;
     void ClearProgram(const std::string& program_name, const std::string& params) const;
     void AddProgram(Program prog, const std::string& program_name, const std::string& params) const;
+    /// Releases the programs which are not used by any kernel or invoker anymore.
+    void ClearUnusedPrograms() const;
+    /// Releases the unused programs when the next program is loaded, may be called concurrently.
+    void ScheduleClearUnusedPrograms() const;
+    /// Limits the code object sizes of the cached programs, 0 is unlimited.
+    void SetProgramCacheBudget(std::size_t bytes) const;
+    KernelCacheStats GetKernelCacheStats() const;
 
     void Finish() const;
     void Flush() const;
@@ -166,6 +186,10 @@ struct Handle : miopenHandle
 
 private:
     std::string GetDeviceNameImpl() const;
+    Program LoadProgramUnshared(const std::string& program_name,
+                                std::string params,
+                                bool is_kernel_str,
+                                const std::string& kernel_src) const;
 
 public:
     std::ostream& Print(std::ostream& os) const;
@@ -237,12 +261,16 @@ public:
                          const std::string& solver,
                          const boost::optional<AlgorithmName>& algo = boost::none)
     {
-        invokers.Register({config, solver}, invoker);
-        if(algo.has_value())
-            invokers.SetAsFound1_0(config, *algo, solver);
+        auto found_1_0_algorithm = boost::optional<std::string>{};
+        if(algo)
+            found_1_0_algorithm = algo->ToString();
+        // The evicted invokers may have been the last users of some programs. The invokers are
+        // registered concurrently, so the programs are released later by the kernel cache.
+        if(invokers.Register(config, solver, invoker, found_1_0_algorithm) > 0)
+            ScheduleClearUnusedPrograms();
     }
 
-    boost::optional<const Invoker&>
+    boost::optional<Invoker>
     GetInvoker(const NetworkConfig& config,
                const boost::optional<solver::Id>& solver,
                const boost::optional<AlgorithmName>& algo = boost::none) const
@@ -253,19 +281,21 @@ public:
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            return invokers.Get(config, solver->ToString());
         }
         MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
                                                           << algo->ToString());
-        return invokers.GetFound1_0(config, *algo);
+        return invokers.GetFound1_0(config, algo->ToString());
     }
 
-    boost::optional<const std::string&> GetFound1_0SolverId(const NetworkConfig& config,
-                                                            const AlgorithmName& algo) const
+    boost::optional<std::string> GetFound1_0SolverId(const NetworkConfig& config,
+                                                     const AlgorithmName& algo) const
     {
         return invokers.GetFound1_0SolverId(config, algo);
     }
 
+    InvokerCache::Stats GetInvokerCacheStats() const { return invokers.GetStats(); }
+
 #if MIOPEN_USE_ROCBLAS
     const rocblas_handle_ptr& rhandle() const;
 
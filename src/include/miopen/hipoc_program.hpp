@@ -62,6 +62,8 @@ struct HIPOCProgram
     /// \return True if CO blob resides in-memory.
     /// False if CO resides on filesystem.
     bool IsCodeObjectInMemory() const;
+    /// \return Size of the code object, 0 for an empty program.
+    std::size_t GetCodeObjectSize() const;
     void FreeCodeObjectFileStorage();
 };
 } // namespace miopen
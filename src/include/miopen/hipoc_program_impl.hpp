@@ -55,6 +55,8 @@ struct HIPOCProgramImpl
     hipModulePtr module;
     boost::optional<TmpDir> dir;
     std::vector<char> binary;
+    /// Size of the code object the module was created from, kept after the storage is freed.
+    std::size_t code_object_size = 0;
 
 #if !MIOPEN_USE_COMGR
     void
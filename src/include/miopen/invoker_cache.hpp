@@ -28,35 +28,65 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/names.hpp>
 
 #include <boost/optional.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
-#include <utility>
+#include <unordered_map>
+#include <vector>
 
 namespace miopen {
 
+/// Thread-safe cache of the invokers. Configs are distributed over shards by their hash, each shard
+/// has its own lock. The cache can be bounded by a number of invokers, then the least recently used
+/// configs are evicted along with all their invokers. The capacity is enforced per shard, so the
+/// cache holds at most (capacity / shards), rounded up, invokers in each shard.
 class InvokerCache
 {
 public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    struct Stats
+    {
+        uint64_t hits      = 0;
+        uint64_t misses    = 0;
+        uint64_t evictions = 0; ///< Number of evicted invokers.
+        std::size_t invokers = 0;
+        /// Approximate size of the cache: keys, solver ids and invoker objects. The memory held by
+        /// the kernels captured by the invokers is not included.
+        std::size_t bytes = 0;
+    };
 
-    boost::optional<const Invoker&> operator[](const Key& key) const;
+    /// The capacity is taken from MIOPEN_DEBUG_INVOKER_CACHE_CAPACITY, 0 (default) is unlimited.
+    InvokerCache();
+    explicit InvokerCache(std::size_t capacity_);
+
+    boost::optional<Invoker> Get(const NetworkConfig& network_config,
+                                 const std::string& solver_id) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
-                                                const std::string& algorithm) const;
-    boost::optional<const std::string&> GetFound1_0SolverId(const std::string& network_config,
-                                                            const std::string& algorithm) const;
+    boost::optional<Invoker> GetFound1_0(const NetworkConfig& network_config,
+                                         const std::string& algorithm) const;
+    boost::optional<std::string> GetFound1_0SolverId(const NetworkConfig& network_config,
+                                                     const std::string& algorithm) const;
 
-    void Register(const Key& key, const Invoker& invoker);
+    /// \return Number of invokers evicted to fit the new one.
+    std::size_t Register(const NetworkConfig& network_config,
+                         const std::string& solver_id,
+                         const Invoker& invoker,
+                         const boost::optional<std::string>& found_1_0_algorithm = boost::none);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
+    void SetAsFound1_0(const NetworkConfig& network_config,
                        const std::string& algorithm,
                        const std::string& solver_id);
 
+    std::size_t GetCapacity() const { return capacity; }
+    Stats GetStats() const;
+
 private:
     struct Item
     {
@@ -65,10 +95,31 @@ private:
         std::map<std::string, std::string> found_1_0;
         // solver_id -> invoker
         std::map<std::string, Invoker> invokers;
+        std::list<const NetworkConfig*>::iterator lru_position;
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    struct Shard
+    {
+        std::mutex mutex;
+        // network_config -> Item, hashed by the hash computed along with the config
+        std::unordered_map<NetworkConfig, Item, NetworkConfig::Hash> items;
+        // Keys of the items, the most recently used first
+        std::list<const NetworkConfig*> lru;
+        std::size_t invokers = 0;
+        std::size_t bytes    = 0;
+        uint64_t hits        = 0;
+        uint64_t misses      = 0;
+        uint64_t evictions   = 0;
+    };
+
+    std::size_t capacity;
+    std::size_t shard_capacity;
+    mutable std::vector<Shard> shards;
+
+    Shard& GetShard(const NetworkConfig& network_config) const;
+    static std::size_t GetSize(const NetworkConfig& network_config, const Item& item);
+    /// Shall be called with the shard locked. The item touched last is never evicted.
+    static std::size_t Evict(Shard& shard, std::size_t max_invokers);
 };
 
 } // namespace miopen
@@ -32,15 +32,18 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
-#include <miopen/md5.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <chrono>
 #include <thread>
+#include <tuple>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -49,6 +52,41 @@ class path;
 } // namespace boost
 
 namespace miopen {
+/// Compression of the kernel binaries, stored in the `codec` column of the kernel db. Rows written
+/// before the column was introduced are compressed with bzip2, unless uncompressed_size is 0.
+enum class KernDbCodec : int64_t
+{
+    None  = 0,
+    Bzip2 = 1,
+    Zstd  = 2,
+};
+
+/// Hash of the uncompressed kernel binary, stored in the `hash_type` column of the kernel db to
+/// detect corruption. Rows written before the column was introduced use md5, new rows XXH3-128.
+/// Older hashes stay readable.
+enum class KernDbHash : int64_t
+{
+    Md5      = 0,
+    XXHash64 = 1,
+    XXH3_128 = 2,
+};
+
+/// Codec used for new records: zstd if available, can be overridden by
+/// MIOPEN_DEBUG_KERN_DB_CODEC=none|bzip2|zstd.
+KernDbCodec GetKernDbCodec();
+
+/// Time spent in kernel db lookups and in decompression of the found kernels (including
+/// verification), used to report the phases of kernel loading.
+struct KernDbTimes
+{
+    uint64_t lookup_ns     = 0;
+    uint64_t decompress_ns = 0;
+};
+
+/// Times of the calling thread only, so that a caller can measure its own loads by the
+/// difference, whatever the other threads do meanwhile.
+KernDbTimes& GetKernDbTimes();
+
 struct KernelConfig
 {
     static std::string table_name() { return "kern_db"; }
@@ -69,41 +107,60 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` INT NOT NULL DEFAULT 1"
+           << ",`hash_type` INT NOT NULL DEFAULT 0"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
            << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);";
         return ss.str();
     }
-    std::string Where() const
+    std::tuple<std::string, std::vector<std::string>> WhereClause() const
     {
-        std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
-        return ss.str();
+        return {"(kernel_name = ?) AND (kernel_args = ?)", {kernel_name, kernel_args}};
     }
 };
 
 class KernDb : public SQLiteBase<KernDb>
 {
+    KernDbCodec codec;
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    /// System dbs generated before the codec and hash_type columns were introduced do not have
+    /// them.
+    bool has_codec     = false;
+    bool has_hash_type = false;
+
+    std::string
+    Decompress(KernDbCodec blob_codec, const std::string& blob, unsigned int size) const;
+    static std::string ComputeHash(KernDbHash hash_type, const std::string& blob);
+
+    static void AddTime(uint64_t& total,
+                        std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end)
+    {
+        total += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
 
 public:
     KernDb(const std::string& filename_, bool is_system);
+    KernDb(const std::string& filename_, bool is_system_, KernDbCodec codec_);
     // This constructor is only intended for testing
     KernDb(const std::string& filename_,
            bool is_system_,
            std::function<std::string(std::string, bool*)> compress_fn_,
-           std::function<std::string(std::string, unsigned int)> decompress_fn_);
+           std::function<std::string(std::string, unsigned int)> decompress_fn_,
+           KernDbCodec codec_ = KernDbCodec::Bzip2);
     template <typename T>
     bool RemoveRecordUnsafe(const T& problem_config)
     {
         if(filename.empty())
             return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto del_query = "DELETE FROM " + T::table_name() + " WHERE " + clause + ";";
+        auto stmt      = SQLite::Statement{sql, del_query, values};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
             return true;
@@ -119,30 +176,42 @@ public:
     {
         if(filename.empty())
             return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto select_query = std::string{"SELECT kernel_blob, kernel_hash, uncompressed_size, "} +
+                            (has_codec ? "codec, " : "1, ") +
+                            (has_hash_type ? "hash_type" : "0") + " FROM " + T::table_name() +
+                            " WHERE " + clause + ";";
+        const auto start = std::chrono::steady_clock::now();
+        auto stmt        = SQLite::Statement{sql, select_query, values};
         // only one result field
         // assert one row
         auto rc = stmt.Step(sql);
         if(rc == SQLITE_ROW)
         {
             auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
+            auto hash                      = stmt.ColumnText(1);
             auto uncompressed_size         = stmt.ColumnInt64(2);
+            auto blob_codec                = static_cast<KernDbCodec>(stmt.ColumnInt64(3));
+            auto hash_type                 = static_cast<KernDbHash>(stmt.ColumnInt64(4));
+            const auto found               = std::chrono::steady_clock::now();
             std::string& decompressed_blob = compressed_blob;
             if(uncompressed_size != 0)
             {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
+                decompressed_blob = Decompress(blob_codec, compressed_blob, uncompressed_size);
             }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
+            if(ComputeHash(hash_type, decompressed_blob) != hash)
                 MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+            AddTime(GetKernDbTimes().lookup_ns, start, found);
+            AddTime(GetKernDbTimes().decompress_ns, found, std::chrono::steady_clock::now());
             return decompressed_blob;
         }
         else if(rc == SQLITE_DONE)
+        {
+            AddTime(GetKernDbTimes().lookup_ns, start, std::chrono::steady_clock::now());
             return boost::none;
+        }
         else
             MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
         return boost::none;
@@ -155,8 +224,8 @@ public:
             return false;
         auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
                             "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
+                            "uncompressed_size, codec, hash_type) VALUES(?, ?, ?, ?, ?, ?, ?);";
+        auto hash              = ComputeHash(KernDbHash::XXH3_128, problem_config.kernel_blob);
         auto uncompressed_size = problem_config.kernel_blob.size();
         bool success           = false;
         auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
@@ -167,13 +236,16 @@ public:
         {
             stmt.BindBlob(3, problem_config.kernel_blob);
             stmt.BindInt64(5, 0);
+            stmt.BindInt64(6, static_cast<int64_t>(KernDbCodec::None));
         }
         else
         {
             stmt.BindBlob(3, compressed_blob);
             stmt.BindInt64(5, uncompressed_size);
+            stmt.BindInt64(6, static_cast<int64_t>(codec));
         }
-        stmt.BindText(4, md5_sum);
+        stmt.BindText(4, hash);
+        stmt.BindInt64(7, static_cast<int64_t>(KernDbHash::XXH3_128));
 
         auto rc = stmt.Step(sql);
         if(rc != SQLITE_DONE)
@@ -46,23 +46,58 @@
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <miopen/problem_key.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace miopen {
 
+struct KernelCacheStats
+{
+    std::size_t programs = 0;
+    /// Total size of the code objects of the cached programs.
+    std::size_t bytes = 0;
+    /// Part of the bytes taken by the programs referenced outside the cache, not charged.
+    std::size_t used_bytes = 0;
+    /// Limit of the bytes of the programs referenced only by the cache, 0 if unlimited.
+    std::size_t budget = 0;
+    uint64_t evictions = 0;
+    /// Problem keys whose kernels are found without formatting the network config.
+    std::size_t indexed_keys = 0;
+};
+
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * The programs can be limited by a budget of the total size of their code objects. Only the
+ * programs referenced by the cache alone, or by its named kernels, are charged, as evicting the
+ * others would not release them: the programs used by the invokers, and the ones the
+ * ProgramRegistry shares with the caches of other handles. When the budget is exceeded, the least
+ * recently used of the charged programs are evicted along with their named kernels. A program is
+ * used when it is loaded and when its named kernels are found; the calls of the invokers are not
+ * tracked. A shared program is charged once the other handles drop it, and a program of the
+ * invokers once they are evicted.
  */
 class KernelCache
 {
 
 public:
-    using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using Key = std::pair<std::string, std::string>;
+
+    struct KernelItem
+    {
+        std::vector<Kernel> kernels;
+        uint64_t last_use = 0;
+    };
+
+    using KernelMap = std::unordered_map<Key, KernelItem, SimpleHash>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -82,17 +117,62 @@ public:
 
     const std::vector<Kernel>& GetKernels(const std::string& algorithm,
                                           const std::string& network_config);
+    /// Finds the kernels added with the network config network_config.ToString(). The config is
+    /// formatted until the kernels are found by the key, the later lookups do not format it.
+    const std::vector<Kernel>& GetKernels(std::string_view algorithm,
+                                          const ProblemKey& network_config);
 
     bool HasProgram(const std::string& name, const std::string& params) const;
     void ClearProgram(const std::string& name, const std::string& params);
+    /// Removes the programs which are referenced only by the cache.
+    /// \return Number of removed programs.
+    std::size_t ClearUnusedPrograms();
+    /// Makes the next program insertion or named kernel addition clear the unused programs. It
+    /// is the only member which may be called concurrently with the others.
+    void ScheduleClearUnusedPrograms() { clear_unused_pending = true; }
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
 
+    /// Sets the limit of the code object sizes of the programs, 0 is unlimited, and evicts the
+    /// programs to fit it.
+    void SetProgramBudget(std::size_t bytes);
+    KernelCacheStats GetStats() const;
+
+    /// The budget is taken from MIOPEN_DEBUG_PROGRAM_CACHE_BUDGET_MB.
     KernelCache();
 
 private:
+    struct ProgramItem
+    {
+        Program program;
+        std::size_t size  = 0;
+        uint64_t last_use = 0;
+    };
+
+    using ProgramMap = std::unordered_map<Key, ProgramItem, SimpleHash>;
+
+    /// Kernels of the problem keys found before, by the algorithm. The items are removed from
+    /// the index along with the kernel_map items, so the pointers stay valid.
+    using KernelIndex =
+        std::unordered_map<ProblemKey,
+                           std::vector<std::pair<std::string, KernelItem*>>,
+                           ProblemKey::Hash>;
+
     KernelMap kernel_map;
+    KernelIndex kernel_index;
     ProgramMap program_map;
+    std::size_t program_budget;
+    std::size_t program_bytes = 0;
+    uint64_t tick             = 0;
+    uint64_t evictions        = 0;
+    std::atomic<bool> clear_unused_pending{false};
+
+    void ClearPendingPrograms();
+    void InsertProgram(Key key, Program prog);
+    ProgramMap::iterator EraseProgram(ProgramMap::iterator it);
+    /// Removes the named kernels of the programs, by the program identities.
+    void EraseKernels(const std::unordered_set<const void*>& programs);
+    void EvictPrograms();
 };
 
 } // namespace miopen
@@ -26,19 +26,46 @@
 
 #pragma once
 
+#include <miopen/xxhash.hpp>
+
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace miopen {
 
 struct NetworkConfig
 {
-    NetworkConfig() = default;
-    explicit NetworkConfig(const std::string& value_) : value(value_) {}
+    NetworkConfig() : NetworkConfig(std::string{}) {}
+    explicit NetworkConfig(const std::string& value_)
+        : value(value_), hash(xxhash64(value.data(), value.size()))
+    {
+    }
+    /// For the callers which keep the hash along with the value. It shall be the same as computed
+    /// by the constructor above.
+    NetworkConfig(const std::string& value_, uint64_t hash_) : value(value_), hash(hash_) {}
     operator std::string() const { return value; }
     const std::string& ToString() const { return value; }
+    /// Computed once, so the config is looked up in hash maps without rehashing the value.
+    uint64_t GetHash() const { return hash; }
+
+    bool operator==(const NetworkConfig& other) const
+    {
+        return hash == other.hash && value == other.value;
+    }
+    bool operator!=(const NetworkConfig& other) const { return !(*this == other); }
+
+    struct Hash
+    {
+        std::size_t operator()(const NetworkConfig& config) const
+        {
+            return static_cast<std::size_t>(config.GetHash());
+        }
+    };
 
 private:
     std::string value;
+    uint64_t hash;
 };
 
 struct AlgorithmName
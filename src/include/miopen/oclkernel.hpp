@@ -170,6 +170,7 @@ public:
 
     inline const std::vector<size_t>& GetLocalDims() const { return ldims; }
     inline const std::vector<size_t>& GetGlobalDims() const { return gdims; }
+    inline const SharedProgramPtr& GetProgram() const { return program; }
 
 private:
     SharedProgramPtr program;
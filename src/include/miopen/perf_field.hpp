@@ -32,6 +32,8 @@
 #include <cstddef>
 #include <ostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
@@ -73,6 +75,9 @@ struct FindDbData : solver::Serializable<FindDbData>
     }
 };
 
+/// Values of a find-db record decoded at once, by solver id.
+using FindDbValues = std::vector<std::pair<std::string, FindDbData>>;
+
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_PERF_FIELD_HPP_
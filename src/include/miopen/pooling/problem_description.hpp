@@ -27,6 +27,7 @@
 #pragma once
 
 #include <miopen/problem_description_base.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/pooling.hpp>
 
@@ -101,6 +102,8 @@ struct ProblemDescription
     }
 
     NetworkConfig MakeNetworkConfig() const;
+    /// Holds everything the network config is made of.
+    ProblemKey MakeProblemKey() const;
 
 private:
     Direction direction;
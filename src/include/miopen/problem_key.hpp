@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PROBLEM_KEY_HPP_
+#define GUARD_MIOPEN_PROBLEM_KEY_HPP_
+
+#include <miopen/errors.hpp>
+#include <miopen/names.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace miopen {
+
+/// Binary form of the network config of a problem: the integer fields the kernels or invokers of
+/// the problem depend on, stored in a fixed-size array. Unlike the text configs, the key is filled,
+/// hashed and compared without heap allocations, so the kernels and invokers built before are
+/// found without formatting the config on every call.
+class ProblemKey
+{
+public:
+    static constexpr std::size_t max_size = 80;
+
+    /// \param name_ Identifies the primitive which fills the key, so the keys of different
+    /// primitives with equal fields are different. Shall outlive the key, e.g. a string literal.
+    explicit ProblemKey(const char* name_) : name(name_) {}
+
+    template <class T>
+    ProblemKey& Add(T value)
+    {
+        if(size == max_size)
+            MIOPEN_THROW(miopenStatusInternalError,
+                         std::string{"Problem key is too long: "} + name);
+        fields[size++] = static_cast<int64_t>(value);
+        return *this;
+    }
+
+    /// Adds the number of the values followed by the values, so the adjacent ranges can not be
+    /// confused with each other.
+    template <class Range>
+    ProblemKey& AddRange(const Range& values)
+    {
+        Add(values.size());
+        for(const auto& value : values)
+            Add(value);
+        return *this;
+    }
+
+    const char* GetName() const { return name; }
+    std::size_t GetSize() const { return size; }
+    uint64_t GetHash() const;
+
+    /// Formats the fields. It is used as the text network config of the kernels added by the key,
+    /// so it is not intended to be parsed.
+    std::string ToString() const;
+
+    bool operator==(const ProblemKey& other) const;
+    bool operator!=(const ProblemKey& other) const { return !(*this == other); }
+
+    struct Hash
+    {
+        std::size_t operator()(const ProblemKey& key) const
+        {
+            return static_cast<std::size_t>(key.GetHash());
+        }
+    };
+
+private:
+    const char* name;
+    std::size_t size = 0;
+    std::array<int64_t, max_size> fields{};
+};
+
+/// Returns the network config of the problem identified by the key. It is made by make_config the
+/// first time the key is seen on the calling thread, and then taken from a per thread cache.
+std::shared_ptr<const NetworkConfig>
+GetNetworkConfig(const ProblemKey& key, const std::function<NetworkConfig()>& make_config);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PROBLEM_KEY_HPP_
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PROGRAM_REGISTRY_HPP_
+#define GUARD_MIOPEN_PROGRAM_REGISTRY_HPP_
+
+#include <miopen/config.h>
+
+#if MIOPEN_BACKEND_HIP
+
+#include <miopen/hipoc_program.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace miopen {
+
+/// Process-wide registry of the loaded programs, so the handles on the same device share one copy
+/// of each module instead of loading it from the kernel db (or compiling it) per handle. Only weak
+/// references are kept: a program is released when the last handle cache or kernel using it drops
+/// it. Concurrent loads of the same program wait for the first one.
+class ProgramRegistry
+{
+public:
+    struct Stats
+    {
+        uint64_t loads       = 0; ///< Programs loaded by the handles.
+        uint64_t hits        = 0; ///< Programs shared with another handle.
+        std::size_t programs = 0; ///< Programs alive.
+    };
+
+    static ProgramRegistry& Get();
+
+    /// \param device Identifies the device the modules are loaded to.
+    /// \param loader Called to load the program if it is not registered.
+    HIPOCProgram GetOrLoad(const std::string& device,
+                           const std::string& program_name,
+                           const std::string& params,
+                           const std::function<HIPOCProgram()>& loader);
+
+    Stats GetStats() const;
+
+private:
+    using Key = std::tuple<std::string, std::string, std::string>;
+
+    struct Entry
+    {
+        std::weak_ptr<HIPOCProgramImpl> program;
+        std::shared_future<HIPOCProgram> loading;
+    };
+
+    mutable std::mutex mutex;
+    std::map<Key, Entry> entries;
+    std::size_t prune_threshold = 64;
+    uint64_t loads              = 0;
+    uint64_t hits               = 0;
+
+    void PruneUnsafe();
+};
+
+} // namespace miopen
+
+#endif
+#endif // GUARD_MIOPEN_PROGRAM_REGISTRY_HPP_
@@ -30,8 +30,10 @@
 
 #include <boost/optional.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <map>
+#include <memory>
 #include <string>
 #include <sstream>
 
@@ -43,6 +45,14 @@ namespace miopen {
 
 using ramdb_clock = std::chrono::steady_clock;
 
+namespace debug {
+
+/// For unit tests which change the db file behind the back of RamDb. Overrides the interval
+/// between the checks of the file by the readers, see RamDb::FindRecord().
+extern boost::optional<std::chrono::milliseconds>& ramdb_check_interval_override();
+
+} // namespace debug
+
 class LockFile;
 
 class RamDb : protected PlainTextDb
@@ -60,6 +70,14 @@ public:
     RamDb& operator=(const RamDb&) = delete;
     RamDb& operator=(RamDb&&) = delete;
 
+    /// Number of times the cache has been synchronized with the file changed by someone else.
+    /// Full reloads include the initial one, incremental ones only parse the appended records.
+    struct ReloadStats
+    {
+        std::size_t full        = 0;
+        std::size_t incremental = 0;
+    };
+
     static std::string GetTimeFilePath(const std::string& path);
     static RamDb& GetCached(const std::string& path, bool is_system);
 
@@ -71,6 +89,10 @@ public:
         return GetCached(path, is_system);
     }
 
+    ReloadStats GetReloadStats() const { return {full_reloads, incremental_reloads}; }
+
+    /// Does not block when the file has not been changed by someone else. The file is checked
+    /// for such changes at most once per 100 ms, own changes are visible right away.
     boost::optional<DbRecord> FindRecord(const std::string& problem);
 
     template <class TProblem>
@@ -128,16 +150,86 @@ private:
         std::string content;
     };
 
+    using Cache = std::map<std::string, CacheItem>;
+    /// boost::none for the removed records.
+    using Changes = std::map<std::string, boost::optional<CacheItem>>;
+
+    /// Immutable view of the cache published after every change of it. Reads take the file
+    /// lock only when the db file is newer than the snapshot.
+    ///
+    /// A copy of the cache is shared by the snapshots along with the changes made since. It is
+    /// copied again when the changes outnumber the square root of its size, so a change costs
+    /// O(sqrt(N)) instead of a copy of the whole cache.
+    struct Snapshot
+    {
+        Snapshot(ramdb_clock::time_point read_time_,
+                 std::shared_ptr<const Cache> base_,
+                 Changes changes_,
+                 bool is_empty_,
+                 ramdb_clock::time_point checked_until_)
+            : read_time(read_time_),
+              base(std::move(base_)),
+              changes(std::move(changes_)),
+              is_empty(is_empty_),
+              checked_until(checked_until_.time_since_epoch().count())
+        {
+        }
+
+        ramdb_clock::time_point read_time;
+        std::shared_ptr<const Cache> base;
+        Changes changes;
+        bool is_empty;
+        /// Time before which the file is not checked again, as ramdb_clock::rep.
+        mutable std::atomic<ramdb_clock::rep> checked_until;
+    };
+
+    // The cache and the read time are only accessed under the file lock, as well as the parts
+    // of the last snapshot.
     ramdb_clock::time_point file_read_time;
-    std::map<std::string, CacheItem> cache;
+    Cache cache;
+    std::shared_ptr<const Cache> published_cache;
+    Changes published_changes;
+
+    /// Distinguishes the instances which may get the same address, as each thread keeps the
+    /// last snapshot of every instance it has read.
+    const std::size_t instance_id;
+    std::atomic<std::size_t> snapshot_version{0};
+    /// Accessed atomically. Threads only load it when the version changes, as loads of an atomic
+    /// shared_ptr are serialized.
+    std::shared_ptr<const Snapshot> snapshot;
+
+    // Part of the file which is reflected by the cache. The tail is used to make sure that
+    // the file has only been appended to since, as an inode number may be reused after a rewrite.
+    DbFileState file_state;
+    std::string file_tail;
+    int file_lines = 0;
+
+    std::atomic<std::size_t> full_reloads{0};
+    std::atomic<std::size_t> incremental_reloads{0};
 
     boost::optional<miopen::DbRecord> FindRecordUnsafe(const std::string& problem);
-
+    boost::optional<miopen::DbRecord> FindRecordIn(const Snapshot& current,
+                                                   const std::string& problem) const;
+    boost::optional<miopen::DbRecord> ParseRecord(const std::string& problem,
+                                                  const CacheItem& item) const;
+
+    const Snapshot& GetSnapshot() const;
+    /// Publishes the whole cache.
+    void PublishUnsafe();
+    /// Publishes the change of the record with the key.
+    void PublishUnsafe(const std::string& key);
+    void StoreSnapshotUnsafe();
+    bool IsCurrent(const Snapshot& current) const;
+    bool IsCurrent(ramdb_clock::time_point read_time, bool is_empty) const;
     bool ValidateUnsafe();
     void Prefetch();
+    void ReloadUnsafe();
+    void ParseUnsafe(std::istream& file);
+    void UpdateFileStateUnsafe(std::istream& file);
 
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
-    void UpdateCacheEntryUnsafe(const DbRecord& record);
+    void UpdateCacheEntryUnsafe(const DbRecord& record, bool is_valid);
+    static std::string GetCacheContents(const DbRecord& record);
 #endif
 };
 
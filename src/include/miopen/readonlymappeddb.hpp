@@ -0,0 +1,176 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_MLOPEN_READONLYMAPPEDDB_HPP
+#define MIOPEN_GUARD_MLOPEN_READONLYMAPPEDDB_HPP
+
+#include <miopen/db_record.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miopen {
+
+namespace debug {
+extern boost::optional<bool>& find_db_shared_memory_override();
+} // namespace debug
+
+/// Read-only system db backed by a binary image of a text db.
+///
+/// Image layout (native byte order):
+///   Header | Entry[record_count] sorted by key | arena of keys and contents
+///
+/// The image is produced offline from a *.fdb.txt file (see ConvertTextDb()) and is
+/// memory-mapped on first use, so opening it costs the same regardless of the db size
+/// and lookups do not copy keys. The image records the size, the modification time and the
+/// XXH3-64 of the contents of the text db it has been built from. The text db is hashed only
+/// if its modification time differs, e.g. for the copy in the build tree. If the image is missing
+/// or stale, the same layout is built in memory from the text db, so lookups always go through
+/// one code path.
+///
+/// With MIOPEN_FIND_DB_SHARED_MEMORY enabled, the image built from the text db is published in
+/// a POSIX shared memory segment instead, so the other processes on the node map it rather than
+/// build their own copies. The segment records the size and the modification time of the text
+/// db and is replaced when they change.
+class ReadonlyMappedDb
+{
+public:
+    static ReadonlyMappedDb& GetCached(const std::string& path, bool warn_if_unreadable);
+
+    /// Path of the image which corresponds to the text db: "*.txt" becomes "*.bin",
+    /// any other name just gets ".bin" appended.
+    static std::string GetImagePath(const std::string& path);
+
+    /// Builds the image from the text db and writes it to the image_path.
+    ///
+    /// Returns false if the text db can't be read or the image can't be written.
+    static bool ConvertTextDb(const std::string& text_path, const std::string& image_path);
+
+    boost::optional<DbRecord> FindRecord(const std::string& problem) const;
+
+    template <class TProblem>
+    boost::optional<DbRecord> FindRecord(const TProblem& problem) const
+    {
+        const auto key = DbRecord::Serialize(problem);
+        return FindRecord(key);
+    }
+
+    template <class TProblem, class TValue>
+    bool Load(const TProblem& problem, const std::string& id, TValue& value) const
+    {
+        const auto record = FindRecord(problem);
+        if(!record)
+            return false;
+        return record->GetValues(id, value);
+    }
+
+    static bool IsSharedMemoryEnabled();
+
+    /// Name of the shared memory segment with the image of the text db.
+    static std::string GetSharedMemoryName(const std::string& path);
+
+    std::size_t GetSize() const;
+
+    /// Calls the visitor for the key of each record, in the order of the keys.
+    void VisitKeys(const std::function<void(std::string_view)>& visitor) const;
+    bool IsMapped() const { return region.get_address() != nullptr; }
+    bool IsShared() const { return shared; }
+    /// Id of the process which has published the shared image, 0 if it is not shared.
+    std::uint32_t GetSharedImagePublisher() const { return shared_publisher; }
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t entry_size;
+        std::uint64_t record_count;
+        std::uint64_t source_size;
+        std::int64_t source_time;  ///< Modification time of the text db.
+        std::uint64_t source_hash; ///< XXH3-64 of the contents of the text db.
+        std::uint64_t index_offset;
+        std::uint64_t arena_offset;
+        std::uint64_t arena_size;
+    };
+
+    struct Entry
+    {
+        std::uint64_t key_offset;
+        std::uint64_t content_offset;
+        std::uint32_t key_size;
+        std::uint32_t content_size;
+        std::uint32_t line;
+        std::uint32_t reserved;
+    };
+
+private:
+    std::string db_path;
+    boost::interprocess::file_mapping file;
+    boost::interprocess::shared_memory_object shared_memory;
+    boost::interprocess::mapped_region region;
+    bool shared                   = false;
+    std::uint32_t shared_publisher = 0;
+    std::vector<char> storage;
+    const Header* header = nullptr;
+    const Entry* index   = nullptr;
+    const char* arena    = nullptr;
+
+    ReadonlyMappedDb(std::string path) : db_path(std::move(path)) {}
+    ReadonlyMappedDb(const ReadonlyMappedDb&) = delete;
+    ReadonlyMappedDb& operator=(const ReadonlyMappedDb&) = delete;
+
+    std::string_view GetKey(const Entry& entry) const;
+    std::string_view GetContent(const Entry& entry) const;
+
+    void Prefetch(bool warn_if_unreadable);
+    bool Map(const std::string& image_path, std::uint64_t source_size, std::int64_t source_time);
+    bool MapShared(std::uint64_t source_size, std::int64_t source_time);
+    bool OpenShared(const std::string& name, std::uint64_t source_size, std::int64_t source_time);
+    bool PublishShared(const std::string& name,
+                       std::uint64_t source_size,
+                       std::int64_t source_time) const;
+    bool Attach(const char* data,
+                std::size_t size,
+                std::uint64_t source_size,
+                std::int64_t source_time);
+    static void BuildImage(std::istream& input_stream,
+                           std::uint64_t source_size,
+                           std::int64_t source_time,
+                           std::uint64_t source_hash,
+                           std::vector<char>& image,
+                           const std::string& db_path);
+};
+
+} // namespace miopen
+
+#endif
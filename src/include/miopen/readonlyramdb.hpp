@@ -27,12 +27,18 @@
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
 #include <miopen/db_record.hpp>
+#include <miopen/perf_field.hpp>
 
 #include <boost/optional.hpp>
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <vector>
 
 namespace miopen {
 
@@ -47,28 +53,33 @@ public:
 
     static ReadonlyRamDb& GetCached(const std::string& path, bool warn_if_unreadable);
 
-    boost::optional<DbRecord> FindRecord(const std::string& problem) const
-    {
-        MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        const auto it = cache.find(problem);
+    /// Returns the record parsed from the payload under the key. The payload is parsed on the
+    /// first lookup only, all following lookups share the same immutable record, which lives as
+    /// long as the db.
+    const DbRecord* GetRecord(const std::string& problem) const;
 
-        if(it == cache.end())
-            return boost::none;
+    template <class TProblem>
+    const DbRecord* GetRecord(const TProblem& problem) const
+    {
+        return GetRecord(DbRecord::Serialize(problem));
+    }
 
-        auto record = DbRecord{problem};
+    /// Returns the values of the record decoded as FindDbData. They are decoded on the first
+    /// lookup only and live as long as the db, like the record.
+    const FindDbValues* FindDecodedRecord(const std::string& problem) const;
 
-        MIOPEN_LOG_I2("Key match: " << problem);
-        MIOPEN_LOG_I2("Contents found: " << it->second.content);
+    template <class TProblem>
+    const FindDbValues* FindDecodedRecord(const TProblem& problem) const
+    {
+        return FindDecodedRecord(DbRecord::Serialize(problem));
+    }
 
-        if(!record.ParseContents(it->second.content))
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: "
-                         << problem << " form file " << db_path << "#" << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
+    boost::optional<DbRecord> FindRecord(const std::string& problem) const
+    {
+        const auto record = GetRecord(problem);
+        if(!record)
             return boost::none;
-        }
-
-        return record;
+        return *record;
     }
 
     template <class TProblem>
@@ -81,31 +92,66 @@ public:
     template <class TProblem, class TValue>
     bool Load(const TProblem& problem, const std::string& id, TValue& value) const
     {
-        const auto record = FindRecord(problem);
-        if(!record)
+        const auto record = GetRecord(problem);
+        if(record == nullptr)
             return false;
         return record->GetValues(id, value);
     }
 
+    /// Keys and payloads are views into the db text, which is either the read-only section of the
+    /// embedded db or the file contents owned by the db. Both outlive the cache.
     struct CacheItem
     {
         int line;
-        std::string content;
+        std::string_view content;
+        /// Filled on the first lookup and owned by the item. A plain atomic pointer, unlike an
+        /// atomic shared_ptr, is read without locks or reference counting.
+        mutable std::atomic<const DbRecord*> record{nullptr};
+        /// Same for the values decoded as FindDbData.
+        mutable std::atomic<const FindDbValues*> find_db_values{nullptr};
+
+        CacheItem(int line_, std::string_view content_) : line(line_), content(content_) {}
+        CacheItem(CacheItem&& other) noexcept
+            : line(other.line),
+              content(other.content),
+              record(other.record.exchange(nullptr)),
+              find_db_values(other.find_db_values.exchange(nullptr))
+        {
+        }
+        CacheItem(const CacheItem&) = delete;
+        CacheItem& operator=(const CacheItem&) = delete;
+        CacheItem& operator=(CacheItem&&) = delete;
+        ~CacheItem()
+        {
+            delete record.load();
+            delete find_db_values.load();
+        }
     };
 
-    const std::unordered_map<std::string, CacheItem>& GetCacheMap() const { return cache; }
+    const std::unordered_map<std::string_view, CacheItem>& GetCacheMap() const { return cache; }
+
+    /// Calls the visitor for the key of each record, in no particular order.
+    void VisitKeys(const std::function<void(std::string_view)>& visitor) const
+    {
+        for(const auto& item : cache)
+            visitor(item.first);
+    }
 
 private:
     std::string db_path;
-    std::unordered_map<std::string, CacheItem> cache;
+    /// Contents of the db file. Empty when the db is embedded, the views then point directly to
+    /// the embedded data. A vector keeps its buffer when moved, unlike a short string.
+    std::vector<char> storage;
+    std::unordered_map<std::string_view, CacheItem> cache;
 
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
     ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
     ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
 
+    const DbRecord* GetRecord(const std::string& problem, const CacheItem& item) const;
     void Prefetch(bool warn_if_unreadable);
-    void ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable);
+    void ParseAndLoadDb(std::string_view data);
 };
 
 } // namespace miopen
@@ -31,6 +31,7 @@
 #error "MIOPEN_ENABLE_SQLITE = Off"
 #endif
 
+#include <miopen/cached_instances.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/db.hpp>
 #include <miopen/manage_ptr.hpp>
@@ -171,6 +172,8 @@ class SQLite
     std::unique_ptr<impl> pImpl;
 
 public:
+    /// Statements are prepared once per connection and query, and are reused after the
+    /// Statement object is destroyed. Thus queries should bind values instead of embedding them.
     class Statement
     {
         class impl;
@@ -195,6 +198,24 @@ public:
         int BindInt64(int idx, int64_t);
     };
 
+    /// Defers the statements queued by Queue() on the thread which has begun the batch until its
+    /// outermost batch of the connection ends, then runs all of them in one transaction.
+    /// Statements queued by other threads are not deferred.
+    class Batch
+    {
+        const SQLite* sql = nullptr;
+        std::thread::id owner;
+
+    public:
+        Batch() = default;
+        Batch(const SQLite& sql_);
+        ~Batch();
+        Batch(Batch&& other) noexcept : sql(other.sql), owner(other.owner) { other.sql = nullptr; }
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+        Batch& operator=(Batch&&) = delete;
+    };
+
     using result_type = std::vector<std::unordered_map<std::string, std::string>>;
     SQLite();
     SQLite(const std::string& filename_, bool is_system);
@@ -208,6 +229,16 @@ public:
     int Retry(std::function<int()>) const;
     static int Retry(std::function<int()> f, std::string filename);
     std::string ErrorMessage() const;
+
+    /// Whether the calling thread has begun a batch.
+    bool InBatch() const;
+    void Queue(std::string query, std::vector<std::string> vals) const;
+    /// Runs the statements queued by the calling thread in one transaction. All of them are rolled
+    /// back and dropped on failure. They stay queued if the transaction cannot be started.
+    bool Flush() const;
+
+private:
+    bool Flush(std::thread::id thread) const;
 };
 
 template <typename Derived>
@@ -374,6 +405,15 @@ public:
         return reinterpret_cast<Derived*>(this)->LoadUnsafe(args...);
     }
 
+    /// Writes made until the returned object is destroyed are committed in one transaction.
+    /// They are not visible to lookups before that.
+    inline SQLite::Batch BeginBatch()
+    {
+        if((!is_system && DisableUserDbFileIO) || dbInvalid)
+            return {};
+        return SQLite::Batch{sql};
+    }
+
     std::string filename;
     bool dbInvalid;
     SQLite sql;
@@ -383,19 +423,15 @@ public:
 template <typename Derived>
 Derived& SQLiteBase<Derived>::GetCached(const std::string& path, bool is_system)
 {
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    const std::lock_guard<std::mutex> lock{mutex};
-
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
     static auto instances = std::map<std::string, Derived>{};
-    const auto it         = instances.find(path);
-
-    if(it != instances.end())
-        return it->second;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto lookup = CachedInstances<Derived>{};
 
-    instances.emplace(path, Derived{path, is_system});
-    return instances.at(path);
+    // The instances are owned by the map, which is only modified under the lookup mutex.
+    return lookup.Get(path, [&]() {
+        return &instances.emplace(path, Derived{path, is_system}).first->second;
+    });
 }
 
 class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
@@ -469,15 +505,32 @@ public:
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
-        // clang-format off
-        auto select_query =
-            "SELECT solver, params "
-            "FROM perf_db "
-            "INNER JOIN " + problem_config.table_name() + " "
-            "ON perf_db.config = " + problem_config.table_name() +".id "
-            "WHERE "
-            "( " + clause + " );";
-        // clang-format on
+        std::string select_query;
+        if(solvers.empty())
+        {
+            // clang-format off
+            select_query =
+                "SELECT solver, params "
+                "FROM perf_db "
+                "INNER JOIN " + problem_config.table_name() + " "
+                "ON perf_db.config = " + problem_config.table_name() +".id "
+                "WHERE "
+                "( " + clause + " );";
+            // clang-format on
+        }
+        else
+        {
+            // clang-format off
+            select_query =
+                "SELECT solver, params "
+                "FROM perf_db "
+                "WHERE solver IN ( " + solvers_placeholders + " ) "
+                "AND config = ("
+                "SELECT id FROM " + problem_config.table_name() + " "
+                "WHERE ( " + clause + " ) );";
+            // clang-format on
+            values.insert(values.begin(), solvers.begin(), solvers.end());
+        }
         auto stmt = SQLite::Statement{sql, select_query, values};
         DbRecord rec;
         while(true)
@@ -503,7 +556,7 @@ public:
     template <class T>
     inline bool RemoveUnsafe(const T& problem_config, const std::string& id)
     {
-        if(dbInvalid)
+        if(dbInvalid || !sql.Flush())
             return false;
         std::string clause;
         std::vector<std::string> values;
@@ -514,8 +567,9 @@ public:
             "WHERE config IN ("
             "SELECT id FROM config WHERE ( "
             + clause + " ) )"
-            "AND solver == '" +  id + "' ;";
+            "AND solver == ? ;";
         // clang-format on
+        values.push_back(id);
         auto stmt = SQLite::Statement{sql, query, values};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
@@ -541,13 +595,7 @@ public:
             std::string clause;
             std::vector<std::string> vals;
             std::tie(clause, vals) = problem_config.InsertQuery();
-            auto stmt              = SQLite::Statement{sql, clause, vals};
-            auto rc                = stmt.Step(sql);
-            if(rc != SQLITE_DONE)
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "Failed to insert config: " + sql.ErrorMessage());
-            auto cnt = sql.Changes();
-            MIOPEN_LOG_I2(cnt << " rows updated");
+            sql.Queue(std::move(clause), std::move(vals));
         }
 
         // UPSERT perf values
@@ -568,14 +616,14 @@ public:
             // clang-format on
             vals.push_back(id);
             vals.push_back(params.str());
-            auto stmt = SQLite::Statement{sql, query, vals};
-            auto rc   = stmt.Step(sql);
-            if(rc != SQLITE_DONE)
-            {
-                MIOPEN_LOG_E("Failed to insert performance record in the database: " +
-                             sql.ErrorMessage());
-                return boost::none;
-            }
+            sql.Queue(std::move(query), std::move(vals));
+        }
+
+        // Both statements are committed together, either now or at the end of the batch.
+        if(!sql.InBatch() && !sql.Flush())
+        {
+            MIOPEN_LOG_E("Failed to insert performance record in the database");
+            return boost::none;
         }
         DbRecord record;
         record.SetValues(id, values);
@@ -598,6 +646,8 @@ public:
     {
         if(dbInvalid)
             return true;
+        if(!sql.Flush())
+            return false;
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
@@ -636,5 +686,11 @@ public:
             return false;
         return record->GetValues(id, values);
     }
+
+private:
+    /// Solvers present in a read-only db. Shipped dbs have no index on perf_db.config, so
+    /// lookups enumerate the solvers to use the (solver, config) index instead of a full scan.
+    std::vector<std::string> solvers;
+    std::string solvers_placeholders;
 };
 } // namespace miopen
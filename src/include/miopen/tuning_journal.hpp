@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNING_JOURNAL_HPP_
+#define GUARD_MIOPEN_TUNING_JOURNAL_HPP_
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct ExecutionContext;
+
+namespace solver {
+
+/// Append-only log of the perf configs measured by GenericSearch for one problem and solver, which
+/// allows an interrupted search to be resumed without measuring them again. The first line of the
+/// file is the key of the search, each next one is a "config;time" pair, where the time is "failed"
+/// for the configs which have failed. An incomplete last line is ignored.
+class TuningJournal
+{
+public:
+    struct Entry
+    {
+        std::string config;
+        boost::optional<float> time;
+    };
+
+    /// Disabled journal, nothing is loaded or stored.
+    TuningJournal() = default;
+    /// Loads the entries of the file if it belongs to the same search. Otherwise the file is
+    /// overwritten by the first append.
+    TuningJournal(boost::filesystem::path path_, std::string key_);
+
+    bool IsEnabled() const { return !path.empty(); }
+    const boost::filesystem::path& GetPath() const { return path; }
+    /// Measurements of the earlier searches, in order.
+    const std::vector<Entry>& GetEntries() const { return entries; }
+
+    /// Writes the entry through to the file, so it survives a kill of the process.
+    void Append(const std::string& config, boost::optional<float> time);
+    /// Removes the file once the search is complete.
+    void Remove();
+
+private:
+    boost::filesystem::path path;
+    std::string key;
+    std::vector<Entry> entries;
+    bool loaded               = false;
+    bool terminated           = true;
+    std::size_t complete_size = 0;
+    std::ofstream file;
+};
+
+/// Part of a search distributed across processes, set by MIOPEN_DEBUG_TUNING_SHARD. Each of the
+/// `count` workers ("index/count") measures the configs whose index in the search space modulo
+/// count is its index, and keeps its journal. The merge ("merge/count") collects the measurements
+/// from the journals of all workers, measures the configs none of them has, and returns the best
+/// one to be stored to the perf-db.
+struct TuningShard
+{
+    std::size_t index = 0;
+    std::size_t count = 1;
+    bool merge        = false;
+};
+
+boost::optional<TuningShard> ParseTuningShard(const std::string& value);
+/// None if MIOPEN_DEBUG_TUNING_SHARD is not set.
+boost::optional<TuningShard> GetTuningShard();
+inline bool IsTuningWorker()
+{
+    const auto shard = GetTuningShard();
+    return shard && !shard->merge;
+}
+
+/// Journals of one search: the one it appends to, and the ones of the workers in case of a merge.
+class TuningSession
+{
+public:
+    struct Measurement
+    {
+        std::size_t index;
+        boost::optional<float> time;
+    };
+
+    /// Disabled session, nothing is restored or stored.
+    TuningSession() = default;
+    TuningSession(const boost::filesystem::path& directory,
+                  const std::string& key,
+                  boost::optional<TuningShard> shard_ = boost::none);
+
+    bool IsWorker() const { return shard && !shard->merge; }
+    /// Whether the config with the given index in the search space is measured by this process.
+    bool Owns(std::size_t index) const
+    {
+        return !IsWorker() || index % shard->count == shard->index;
+    }
+    const boost::filesystem::path& GetPath() const { return journal.GetPath(); }
+    bool HasEntries() const;
+
+    /// Measurements of the given configs found in the journals, at most one per config.
+    std::vector<Measurement> Restore(const std::vector<std::string>& configs) const;
+    void Append(const std::string& config, boost::optional<float> time)
+    {
+        journal.Append(config, time);
+    }
+    /// Removes the journals once the search is complete, except for the journal of a worker, which
+    /// is left for the merge.
+    void Complete();
+
+private:
+    boost::optional<TuningShard> shard;
+    TuningJournal journal;
+    std::vector<TuningJournal> worker_journals;
+};
+
+/// Session of the search in MIOPEN_DEBUG_TUNING_JOURNAL_DIR, by default in the "tuning"
+/// subdirectory of the user db. Disabled if there is no such directory or
+/// MIOPEN_DEBUG_TUNING_CHECKPOINT=0, which is not allowed for the distributed searches.
+TuningSession OpenTuningSession(const ExecutionContext& context,
+                                const std::string& problem,
+                                const std::string& solver);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TUNING_JOURNAL_HPP_
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNING_STRATEGY_HPP_
+#define GUARD_MIOPEN_TUNING_STRATEGY_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Chooses the perf configs measured by GenericSearch. The configs are referred to by their indices
+/// in the search space, and the strategies which need more see them as vectors of numeric features.
+struct TuningStrategy
+{
+    using GetFeatures = std::function<std::vector<double>(std::size_t)>;
+
+    virtual ~TuningStrategy() = default;
+
+    virtual void Init(std::size_t size, const GetFeatures& get_features) = 0;
+    /// Reports the time of a config measured by an earlier search, before the first proposal.
+    /// Such configs are not proposed.
+    virtual void Restore(std::size_t index, boost::optional<float> time) = 0;
+    /// Returns up to max_count configs to be measured next, none of them proposed before. All of
+    /// them are reported before the next call. The search ends when none are returned.
+    virtual std::vector<std::size_t> Propose(std::size_t max_count) = 0;
+    /// Reports the time of a proposed config, none if it has failed.
+    virtual void Report(std::size_t index, boost::optional<float> time) = 0;
+};
+
+/// Proposes all configs at once, in a random order.
+class RandomTuningStrategy : public TuningStrategy
+{
+public:
+    explicit RandomTuningStrategy(uint64_t seed = std::random_device{}()) : rng(seed) {}
+
+    void Init(std::size_t size, const GetFeatures& get_features) override;
+    void Restore(std::size_t index, boost::optional<float>) override { restored[index] = true; }
+    std::vector<std::size_t> Propose(std::size_t max_count) override;
+    void Report(std::size_t, boost::optional<float>) override {}
+
+private:
+    std::mt19937_64 rng;
+    std::vector<std::size_t> order;
+    std::vector<bool> restored;
+    std::size_t proposed = 0;
+};
+
+/// Fits a Gaussian process to the logarithms of the measured times and proposes the configs with
+/// the largest expected improvement over the best one, in batches for the parallel compilation.
+/// The first batch is random.
+class ModelTuningStrategy : public TuningStrategy
+{
+public:
+    explicit ModelTuningStrategy(uint64_t seed = std::random_device{}(),
+                                 std::size_t batch_size_ = 8)
+        : rng(seed), batch_size(batch_size_)
+    {
+    }
+
+    void Init(std::size_t size, const GetFeatures& get_features) override;
+    void Restore(std::size_t index, boost::optional<float> time) override;
+    std::vector<std::size_t> Propose(std::size_t max_count) override;
+    void Report(std::size_t index, boost::optional<float> time) override;
+
+private:
+    struct Model;
+
+    std::mt19937_64 rng;
+    std::size_t batch_size;
+    std::size_t initial_samples = 0;
+    /// Scaled to [0, 1], the dimensions which are the same for all configs are dropped.
+    std::vector<std::vector<double>> features;
+    std::vector<std::size_t> remaining;
+    /// Restored configs which are still in the remaining ones.
+    std::vector<bool> restored;
+    std::vector<std::size_t> measured;
+    /// Logarithms of the times, failed configs are NaN.
+    std::vector<double> log_times;
+
+    std::vector<std::size_t> ProposeRandom(std::size_t count);
+    Model Fit() const;
+};
+
+/// Stops the search when the best time has not improved by min_improvement (relative) during the
+/// last `patience` measurements. Disabled if patience is 0.
+class TuningEarlyStop
+{
+public:
+    explicit TuningEarlyStop(std::size_t patience_, double min_improvement_ = 0.01)
+        : patience(patience_), min_improvement(min_improvement_)
+    {
+    }
+
+    /// \return true if the search shall stop.
+    bool Update(boost::optional<float> time);
+
+private:
+    std::size_t patience;
+    double min_improvement;
+    std::size_t measured         = 0;
+    std::size_t last_improvement = 0;
+    float best                   = std::numeric_limits<float>::max();
+};
+
+/// Selected by MIOPEN_DEBUG_TUNING_STRATEGY=random|model, random is the default. The model proposes
+/// at least as many configs at once as there are parallel compilations.
+std::unique_ptr<TuningStrategy> MakeTuningStrategy(std::size_t parallelism);
+/// Patience is taken from MIOPEN_DEBUG_TUNING_EARLY_STOP, 0 (default) disables the early stop.
+TuningEarlyStop MakeTuningEarlyStop();
+
+/// Numbers of a serialized perf config, the words (e.g. kernel names) are hashed.
+std::vector<double> ParseTuningFeatures(const std::string& serialized);
+
+template <class PerformanceConfig>
+std::vector<double> GetTuningFeatures(const PerformanceConfig& config)
+{
+    std::ostringstream ss;
+    ss << config;
+    return ParseTuningFeatures(ss.str());
+}
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TUNING_STRATEGY_HPP_
@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_XXHASH_HPP_
+#define GUARD_MIOPEN_XXHASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+/// Non-cryptographic hashes of the xxHash family (https://github.com/Cyan4973/xxHash), several
+/// times faster than md5. Intended for integrity checks and cache keys which do not have to stay
+/// compatible with the md5 based ones.
+///
+/// XXH64. Short keys which are only kept in memory use it.
+uint64_t xxhash64(const void* data, std::size_t size, uint64_t seed = 0);
+
+/// Returns the hash as 16 hex digits.
+std::string xxhash64(const std::string& s);
+
+struct xxhash128_t
+{
+    uint64_t low;
+    uint64_t high;
+};
+
+/// XXH3, the same values as XXH3_64bits_withSeed() and XXH3_128bits_withSeed() of the reference
+/// implementation. Faster than XXH64 on large inputs, such as kernel binaries and text dbs, as the
+/// eight independent lanes of its stripes are processed with SSE2 on x86-64.
+uint64_t xxh3_64(const void* data, std::size_t size, uint64_t seed = 0);
+xxhash128_t xxh3_128(const void* data, std::size_t size, uint64_t seed = 0);
+
+/// Returns the 128-bit hash as 32 hex digits, the high half first. Same width as md5, for cache
+/// file names.
+std::string xxh3_128(const std::string& s);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_XXHASH_HPP_
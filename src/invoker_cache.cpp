@@ -25,34 +25,105 @@
  *******************************************************************************/
 
 #include <miopen/invoker_cache.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 
+#include <algorithm>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_INVOKER_CACHE_CAPACITY)
+
 namespace miopen {
 
-boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
+namespace {
+constexpr std::size_t max_shards = 16;
+} // namespace
+
+InvokerCache::InvokerCache()
+    : InvokerCache(static_cast<std::size_t>(Value(MIOPEN_DEBUG_INVOKER_CACHE_CAPACITY{})))
+{
+}
+
+InvokerCache::InvokerCache(std::size_t capacity_)
+    : capacity(capacity_),
+      shard_capacity(0),
+      shards(capacity == 0 ? max_shards : std::min(capacity, max_shards))
+{
+    if(capacity != 0)
+        shard_capacity = (capacity + shards.size() - 1) / shards.size();
+}
+
+InvokerCache::Shard& InvokerCache::GetShard(const NetworkConfig& network_config) const
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
+    return shards[network_config.GetHash() % shards.size()];
+}
+
+std::size_t InvokerCache::GetSize(const NetworkConfig& network_config, const Item& item)
+{
+    auto size = sizeof(Item) + network_config.ToString().size();
+    for(const auto& invoker : item.invokers)
+        size += invoker.first.size() + sizeof(Invoker);
+    for(const auto& found : item.found_1_0)
+        size += found.first.size() + found.second.size();
+    return size;
+}
+
+std::size_t InvokerCache::Evict(Shard& shard, std::size_t max_invokers)
+{
+    auto evicted = std::size_t{0};
+    while(shard.invokers > max_invokers && shard.lru.size() > 1)
+    {
+        const auto item = shard.items.find(*shard.lru.back());
+        MIOPEN_LOG_I2("Evicting " << item->second.invokers.size() << " invokers for "
+                                  << item->first.ToString());
+        evicted += item->second.invokers.size();
+        shard.invokers -= item->second.invokers.size();
+        shard.bytes -= GetSize(item->first, item->second);
+        shard.lru.pop_back();
+        shard.items.erase(item);
+    }
+    shard.evictions += evicted;
+    return evicted;
+}
+
+boost::optional<Invoker> InvokerCache::Get(const NetworkConfig& network_config,
+                                           const std::string& solver_id) const
+{
+    auto& shard     = GetShard(network_config);
+    const auto lock = std::lock_guard<std::mutex>{shard.mutex};
+    const auto item = shard.items.find(network_config);
+    if(item == shard.items.end())
+    {
+        ++shard.misses;
         return boost::none;
+    }
     const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
+    const auto invoker        = item_invokers.find(solver_id);
     if(invoker == item_invokers.end())
+    {
+        ++shard.misses;
         return boost::none;
+    }
+    ++shard.hits;
+    shard.lru.splice(shard.lru.begin(), shard.lru, item->second.lru_position);
     return invoker->second;
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
-                                                          const std::string& algorithm) const
+boost::optional<Invoker> InvokerCache::GetFound1_0(const NetworkConfig& network_config,
+                                                   const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    auto& shard     = GetShard(network_config);
+    const auto lock = std::lock_guard<std::mutex>{shard.mutex};
+    const auto item = shard.items.find(network_config);
+    if(item == shard.items.end())
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
+        ++shard.misses;
+        MIOPEN_LOG_I2("No invokers found for " << network_config.ToString());
         return boost::none;
     }
     if(item->second.found_1_0.empty())
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
+        ++shard.misses;
+        MIOPEN_LOG_I2("Invokers found for " << network_config.ToString()
                                             << " but there is no find 1.0 result.");
         return boost::none;
     }
@@ -61,30 +132,36 @@ boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& net
     const auto found_1_0_id   = found_1_0_ids.find(algorithm);
     if(found_1_0_id == found_1_0_ids.end())
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
+        ++shard.misses;
+        MIOPEN_LOG_I2("Invokers found for " << network_config.ToString()
+                                            << " but there is no one with an algorithm "
+                                            << algorithm);
         return boost::none;
     }
     const auto invoker = item_invokers.find(found_1_0_id->second);
     if(invoker == item_invokers.end())
         MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
+                     " was registered for " + network_config.ToString());
+    ++shard.hits;
+    shard.lru.splice(shard.lru.begin(), shard.lru, item->second.lru_position);
     return invoker->second;
 }
 
-boost::optional<const std::string&>
-InvokerCache::GetFound1_0SolverId(const std::string& network_config,
+boost::optional<std::string>
+InvokerCache::GetFound1_0SolverId(const NetworkConfig& network_config,
                                   const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    auto& shard     = GetShard(network_config);
+    const auto lock = std::lock_guard<std::mutex>{shard.mutex};
+    const auto item = shard.items.find(network_config);
+    if(item == shard.items.end())
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
+        MIOPEN_LOG_I2("No invokers found for " << network_config.ToString());
         return boost::none;
     }
     if(item->second.found_1_0.empty())
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
+        MIOPEN_LOG_I2("Invokers found for " << network_config.ToString()
                                             << " but there is no find 1.0 result.");
         return boost::none;
     }
@@ -92,33 +169,61 @@ InvokerCache::GetFound1_0SolverId(const std::string& network_config,
     const auto found_1_0_id   = found_1_0_ids.find(algorithm);
     if(found_1_0_id == found_1_0_ids.end())
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
+        MIOPEN_LOG_I2("Invokers found for " << network_config.ToString()
+                                            << " but there is no one with an algorithm "
+                                            << algorithm);
         return boost::none;
     }
     return found_1_0_id->second;
 }
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+std::size_t InvokerCache::Register(const NetworkConfig& network_config,
+                                   const std::string& solver_id,
+                                   const Invoker& invoker,
+                                   const boost::optional<std::string>& found_1_0_algorithm)
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
+    auto& shard     = GetShard(network_config);
+    const auto lock = std::lock_guard<std::mutex>{shard.mutex};
+    auto inserted   = shard.items.emplace(network_config, Item{});
+    auto& item      = inserted.first->second;
+    if(inserted.second)
+    {
+        shard.lru.push_front(&inserted.first->first);
+        item.lru_position = shard.lru.begin();
+    }
     else
     {
-        auto& item = invokers.insert({key.first, Item{}}).first->second;
-        item.invokers.insert({key.second, invoker});
+        shard.lru.splice(shard.lru.begin(), shard.lru, item.lru_position);
+        shard.bytes -= GetSize(network_config, item);
     }
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+
+    const auto count = item.invokers.size();
+    item.invokers.insert({solver_id, invoker});
+    shard.invokers += item.invokers.size() - count;
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << network_config.ToString()
+                                                      << " and solver " << solver_id);
+    if(found_1_0_algorithm)
+    {
+        item.found_1_0[*found_1_0_algorithm] = solver_id;
+        MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for "
+                                << *found_1_0_algorithm << " in " << network_config.ToString());
+    }
+    shard.bytes += GetSize(network_config, item);
+
+    if(shard_capacity == 0)
+        return 0;
+    return Evict(shard, shard_capacity);
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
+void InvokerCache::SetAsFound1_0(const NetworkConfig& network_config,
                                  const std::string& algorithm,
                                  const std::string& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
+    auto& shard     = GetShard(network_config);
+    const auto lock = std::lock_guard<std::mutex>{shard.mutex};
+    const auto item = shard.items.find(network_config);
+    if(item == shard.items.end())
+        MIOPEN_THROW("No invoker was registered for " + network_config.ToString());
 
     {
         // Validating at find time
@@ -126,12 +231,29 @@ void InvokerCache::SetAsFound1_0(const std::string& network_config,
         const auto invoker        = item_invokers.find(solver_id);
         if(invoker == item_invokers.end())
             MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
+                         network_config.ToString());
     }
 
+    shard.bytes -= GetSize(item->first, item->second);
     item->second.found_1_0[algorithm] = solver_id;
+    shard.bytes += GetSize(item->first, item->second);
     MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
-                            << " in " << network_config);
+                            << " in " << network_config.ToString());
+}
+
+InvokerCache::Stats InvokerCache::GetStats() const
+{
+    auto stats = Stats{};
+    for(auto& shard : shards)
+    {
+        const auto lock = std::lock_guard<std::mutex>{shard.mutex};
+        stats.hits += shard.hits;
+        stats.misses += shard.misses;
+        stats.evictions += shard.evictions;
+        stats.invokers += shard.invokers;
+        stats.bytes += shard.bytes;
+    }
+    return stats;
 }
 
 } // namespace miopen
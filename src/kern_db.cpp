@@ -24,18 +24,115 @@
  *
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
+#include <miopen/env.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/xxhash.hpp>
+
+#if MIOPEN_USE_ZSTD
+#include <miopen/zstd.hpp>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_KERN_DB_CODEC)
 
 namespace miopen {
+KernDbCodec GetKernDbCodec()
+{
+    const auto value = GetStringEnv(MIOPEN_DEBUG_KERN_DB_CODEC{});
+    if(value != nullptr)
+    {
+        const auto name = std::string{value};
+        if(name == "none")
+            return KernDbCodec::None;
+        if(name == "bzip2")
+            return KernDbCodec::Bzip2;
+#if MIOPEN_USE_ZSTD
+        if(name == "zstd")
+            return KernDbCodec::Zstd;
+#endif
+        MIOPEN_LOG_W("Unsupported MIOPEN_DEBUG_KERN_DB_CODEC value: " << name);
+    }
+#if MIOPEN_USE_ZSTD
+    return KernDbCodec::Zstd;
+#else
+    return KernDbCodec::Bzip2;
+#endif
+}
+
+KernDbTimes& GetKernDbTimes()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    thread_local KernDbTimes times;
+    return times;
+}
+
+static std::string StoreUncompressed(std::string s, bool* compressed)
+{
+    if(compressed != nullptr)
+        *compressed = false;
+    return s;
+}
+
+static std::string DecompressBlob(KernDbCodec codec, std::string s, unsigned int size)
+{
+    switch(codec)
+    {
+    case KernDbCodec::None: return s;
+    case KernDbCodec::Bzip2: return decompress(std::move(s), size);
+    case KernDbCodec::Zstd:
+#if MIOPEN_USE_ZSTD
+        return zstd::decompress(s, size);
+#else
+        MIOPEN_THROW(miopenStatusNotImplemented, "Kernel db record is compressed with zstd");
+#endif
+    }
+    MIOPEN_THROW(miopenStatusInternalError,
+                 "Unknown kernel db codec: " + std::to_string(static_cast<int64_t>(codec)));
+}
+
+static std::function<std::string(std::string, bool*)> GetCompressFn(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::None: return StoreUncompressed;
+    case KernDbCodec::Bzip2: return [](std::string s, bool* compressed) {
+        return compress(std::move(s), compressed);
+    };
+    case KernDbCodec::Zstd:
+#if MIOPEN_USE_ZSTD
+        return [](std::string s, bool* compressed) { return zstd::compress(s, compressed); };
+#else
+        break;
+#endif
+    }
+    MIOPEN_THROW(miopenStatusInternalError,
+                 "Unsupported kernel db codec: " + std::to_string(static_cast<int64_t>(codec)));
+}
+
 KernDb::KernDb(const std::string& filename_, bool is_system_)
-    : KernDb(filename_, is_system_, compress, decompress)
+    : KernDb(filename_, is_system_, GetKernDbCodec())
+{
+}
+
+KernDb::KernDb(const std::string& filename_, bool is_system_, KernDbCodec codec_)
+    : KernDb(filename_,
+             is_system_,
+             GetCompressFn(codec_),
+             [codec_](std::string s, unsigned int size) {
+                 return DecompressBlob(codec_, std::move(s), size);
+             },
+             codec_)
 {
 }
 
 KernDb::KernDb(const std::string& filename_,
                bool is_system_,
                std::function<std::string(std::string, bool*)> compress_fn_,
-               std::function<std::string(std::string, unsigned int)> decompress_fn_)
-    : SQLiteBase(filename_, is_system_), compress_fn(compress_fn_), decompress_fn(decompress_fn_)
+               std::function<std::string(std::string, unsigned int)> decompress_fn_,
+               KernDbCodec codec_)
+    : SQLiteBase(filename_, is_system_),
+      codec(codec_),
+      compress_fn(compress_fn_),
+      decompress_fn(decompress_fn_)
 {
     if(!is_system && DisableUserDbFileIO)
         return;
@@ -52,6 +149,15 @@ KernDb::KernDb(const std::string& filename_,
     {
         const std::string create_table = KernelConfig::CreateQuery();
         sql.Exec(create_table);
+        // Columns added after the table was introduced.
+        const auto added_columns = std::vector<std::pair<std::string, std::string>>{
+            {"codec", "INT NOT NULL DEFAULT 1"}, {"hash_type", "INT NOT NULL DEFAULT 0"}};
+        for(const auto& column : added_columns)
+        {
+            if(!CheckTableColumns(KernelConfig::table_name(), {column.first}))
+                sql.Exec("ALTER TABLE `" + KernelConfig::table_name() + "` ADD COLUMN `" +
+                         column.first + "` " + column.second + ";");
+        }
         MIOPEN_LOG_I2("Database created successfully");
     }
     if(!CheckTableColumns(KernelConfig::table_name(), KernelConfig::FieldNames()))
@@ -62,6 +168,28 @@ KernDb::KernDb(const std::string& filename_,
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
     }
+    has_codec     = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    has_hash_type = CheckTableColumns(KernelConfig::table_name(), {"hash_type"});
+}
+
+std::string KernDb::ComputeHash(KernDbHash hash_type, const std::string& blob)
+{
+    switch(hash_type)
+    {
+    case KernDbHash::Md5: return md5(blob);
+    case KernDbHash::XXHash64: return xxhash64(blob);
+    case KernDbHash::XXH3_128: return xxh3_128(blob);
+    }
+    MIOPEN_THROW(miopenStatusInternalError,
+                 "Unknown kernel db hash: " + std::to_string(static_cast<int64_t>(hash_type)));
+}
+
+std::string
+KernDb::Decompress(KernDbCodec blob_codec, const std::string& blob, unsigned int size) const
+{
+    if(blob_codec == codec)
+        return decompress_fn(blob, size);
+    return DecompressBlob(blob_codec, blob, size);
 }
 
 } // namespace miopen
@@ -45,10 +45,14 @@
 #include <miopen/logger.hpp>
 #include <miopen/stringutils.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <unordered_map>
+#include <unordered_set>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PROGRAM_CACHE_BUDGET_MB)
 
 namespace miopen {
 
@@ -61,9 +65,10 @@ const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
     const auto it = kernel_map.find(key);
     if(it != kernel_map.end())
     {
-        MIOPEN_LOG_I2(it->second.size()
+        MIOPEN_LOG_I2(it->second.kernels.size()
                       << " kernels for key: " << key.first << " \"" << key.second << '\"');
-        return it->second;
+        it->second.last_use = ++tick;
+        return it->second.kernels;
     }
 
     static const std::vector<Kernel> empty{};
@@ -71,6 +76,42 @@ const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
     return empty;
 }
 
+const std::vector<Kernel>& KernelCache::GetKernels(std::string_view algorithm,
+                                                   const ProblemKey& network_config)
+{
+    const auto indexed = kernel_index.find(network_config);
+    if(indexed != kernel_index.end())
+    {
+        for(const auto& kernels : indexed->second)
+        {
+            if(kernels.first == algorithm)
+            {
+                MIOPEN_LOG_I2(kernels.second->kernels.size()
+                              << " kernels for key: " << algorithm << " \""
+                              << network_config.ToString() << '\"');
+                kernels.second->last_use = ++tick;
+                return kernels.second->kernels;
+            }
+        }
+    }
+
+    auto key      = std::make_pair(std::string{algorithm}, network_config.ToString());
+    const auto it = kernel_map.find(key);
+    if(it == kernel_map.end())
+    {
+        static const std::vector<Kernel> empty{};
+        MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
+        return empty;
+    }
+
+    MIOPEN_LOG_I2(it->second.kernels.size()
+                  << " kernels for key: " << key.first << " \"" << key.second << '\"');
+    // Only the hits are indexed, so the misses of a search probing many configs do not grow it.
+    kernel_index[network_config].emplace_back(std::move(key.first), &it->second);
+    it->second.last_use = ++tick;
+    return it->second.kernels;
+}
+
 bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
 {
     const auto key = std::make_pair(name, params);
@@ -79,16 +120,226 @@ bool KernelCache::HasProgram(const std::string& name, const std::string& params)
 
 void KernelCache::ClearProgram(const std::string& name, const std::string& params)
 {
-    if(HasProgram(name, params))
+    const auto it = program_map.find(std::make_pair(name, params));
+    if(it != program_map.end())
+        EraseProgram(it);
+}
+
+#if MIOPEN_BACKEND_OPENCL
+static long GetUseCount(const Program& program) { return program.use_count(); }
+
+static const void* GetProgramId(const Program& program) { return program.get(); }
+
+static const Program& GetKernelProgram(const Kernel& kernel) { return kernel.GetProgram(); }
+
+static std::size_t GetProgramSize(const Program& program)
+{
+    // The programs are built for a single device.
+    auto size = std::size_t{0};
+    if(clGetProgramInfo(program.get(), CL_PROGRAM_BINARY_SIZES, sizeof(size), &size, nullptr) !=
+       CL_SUCCESS)
+        return 0;
+    return size;
+}
+#else
+static long GetUseCount(const Program& program) { return program.impl.use_count(); }
+
+static const void* GetProgramId(const Program& program) { return program.impl.get(); }
+
+static const Program& GetKernelProgram(const Kernel& kernel) { return kernel.program; }
+
+static std::size_t GetProgramSize(const Program& program) { return program.GetCodeObjectSize(); }
+#endif
+
+namespace {
+
+struct KernelReferences
+{
+    long count        = 0;
+    uint64_t last_use = 0;
+};
+
+} // namespace
+
+/// References to the programs from the named kernels, and when the kernels were last used.
+static std::unordered_map<const void*, KernelReferences>
+GetKernelReferences(const KernelCache::KernelMap& kernel_map)
+{
+    auto references = std::unordered_map<const void*, KernelReferences>{};
+    for(const auto& item : kernel_map)
     {
-        const auto key = std::make_pair(name, params);
-        program_map.erase(key);
+        for(const auto& kernel : item.second.kernels)
+        {
+            const auto program = GetProgramId(GetKernelProgram(kernel));
+            if(program == nullptr)
+                continue;
+            auto& reference = references[program];
+            ++reference.count;
+            reference.last_use = std::max(reference.last_use, item.second.last_use);
+        }
     }
+    return references;
+}
+
+/// Whether the program is referenced by anything but the cache and its named kernels.
+static bool IsUsed(const Program& program,
+                   const std::unordered_map<const void*, KernelReferences>& references)
+{
+    const auto found = references.find(GetProgramId(program));
+    return GetUseCount(program) > 1 + (found != references.end() ? found->second.count : 0);
+}
+
+KernelCache::ProgramMap::iterator KernelCache::EraseProgram(ProgramMap::iterator it)
+{
+    program_bytes -= it->second.size;
+    return program_map.erase(it);
+}
+
+void KernelCache::ClearPendingPrograms()
+{
+    if(clear_unused_pending.exchange(false))
+        ClearUnusedPrograms();
+}
+
+void KernelCache::InsertProgram(Key key, Program prog)
+{
+    ClearPendingPrograms();
+    const auto size = GetProgramSize(prog);
+    auto& item      = program_map[std::move(key)];
+    program_bytes   = program_bytes - item.size + size;
+    item            = {std::move(prog), size, ++tick};
+    EvictPrograms();
+}
+
+void KernelCache::EraseKernels(const std::unordered_set<const void*>& programs)
+{
+    auto erased = std::unordered_set<const KernelItem*>{};
+    for(auto it = kernel_map.begin(); it != kernel_map.end();)
+    {
+        const auto& kernels = it->second.kernels;
+        if(std::any_of(kernels.begin(), kernels.end(), [&](const Kernel& kernel) {
+               return programs.count(GetProgramId(GetKernelProgram(kernel))) > 0;
+           }))
+        {
+            MIOPEN_LOG_I2("Evicting kernels: " << it->first.first << " \"" << it->first.second
+                                               << '\"');
+            erased.insert(&it->second);
+            it = kernel_map.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    if(erased.empty())
+        return;
+
+    for(auto it = kernel_index.begin(); it != kernel_index.end();)
+    {
+        auto& indexed = it->second;
+        indexed.erase(std::remove_if(indexed.begin(),
+                                     indexed.end(),
+                                     [&](auto&& kernels) { return erased.count(kernels.second); }),
+                      indexed.end());
+        if(indexed.empty())
+            it = kernel_index.erase(it);
+        else
+            ++it;
+    }
+}
+
+void KernelCache::EvictPrograms()
+{
+    if(program_budget == 0 || program_bytes <= program_budget)
+        return;
+
+    // Only the programs referenced by the cache alone, or by its named kernels, are charged: the
+    // others are held by the invokers, or by other handles through the ProgramRegistry, so
+    // evicting them frees nothing.
+    const auto references = GetKernelReferences(kernel_map);
+    auto unused           = std::vector<std::pair<ProgramMap::iterator, uint64_t>>{};
+    auto unused_bytes     = std::size_t{0};
+    for(auto it = program_map.begin(); it != program_map.end(); ++it)
+    {
+        if(IsUsed(it->second.program, references))
+            continue;
+        const auto found = references.find(GetProgramId(it->second.program));
+        const auto last_use =
+            std::max(it->second.last_use, found != references.end() ? found->second.last_use : 0);
+        unused.emplace_back(it, last_use);
+        unused_bytes += it->second.size;
+    }
+    if(unused_bytes <= program_budget)
+        return;
+
+    std::sort(unused.begin(), unused.end(), [](auto&& left, auto&& right) {
+        return left.second < right.second;
+    });
+
+    auto evicted = std::unordered_set<const void*>{};
+    for(const auto& item : unused)
+    {
+        if(unused_bytes <= program_budget)
+            break;
+        const auto it = item.first;
+        MIOPEN_LOG_I2("Evicting program: " << it->first.first << " \"" << it->first.second
+                                           << "\", " << it->second.size << " bytes");
+        unused_bytes -= it->second.size;
+        evicted.insert(GetProgramId(it->second.program));
+        EraseProgram(it);
+        ++evictions;
+    }
+    // The named kernels keep the programs alive, they are rebuilt when needed.
+    EraseKernels(evicted);
+}
+
+std::size_t KernelCache::ClearUnusedPrograms()
+{
+    auto cleared = std::size_t{0};
+    for(auto it = program_map.begin(); it != program_map.end();)
+    {
+        if(GetUseCount(it->second.program) == 1)
+        {
+            MIOPEN_LOG_I2("Clearing unused program: " << it->first.first << " \""
+                                                      << it->first.second << '\"');
+            it = EraseProgram(it);
+            ++cleared;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    evictions += cleared;
+    return cleared;
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    InsertProgram(std::make_pair(program_name, std::move(params)), std::move(prog));
+}
+
+void KernelCache::SetProgramBudget(std::size_t bytes)
+{
+    program_budget = bytes;
+    EvictPrograms();
+}
+
+KernelCacheStats KernelCache::GetStats() const
+{
+    auto stats         = KernelCacheStats{};
+    stats.programs     = program_map.size();
+    stats.bytes        = program_bytes;
+    stats.budget       = program_budget;
+    stats.evictions    = evictions;
+    stats.indexed_keys = kernel_index.size();
+    const auto references = GetKernelReferences(kernel_map);
+    for(const auto& item : program_map)
+    {
+        if(IsUsed(item.second.program, references))
+            stats.used_bytes += item.second.size;
+    }
+    return stats;
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -112,7 +363,8 @@ Kernel KernelCache::AddKernel(const Handle& h,
     auto program_it = program_map.find(std::make_pair(program_name, params));
     if(program_it != program_map.end())
     {
-        program = program_it->second;
+        program                     = program_it->second.program;
+        program_it->second.last_use = ++tick;
     }
     else
     {
@@ -120,7 +372,7 @@ Kernel KernelCache::AddKernel(const Handle& h,
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
         program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        InsertProgram(std::make_pair(program_name, params), program);
     }
 
     Kernel kernel{};
@@ -143,7 +395,10 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
 void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
 {
-    auto&& v = kernel_map[key];
+    ClearPendingPrograms();
+    auto&& item   = kernel_map[key];
+    item.last_use = ++tick;
+    auto&& v      = item.kernels;
     if(cache_index >= v.size())
     {
         v.resize(cache_index + 1);
@@ -158,7 +413,7 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
         MIOPEN_THROW("Network config or algorithm empty.");
     }
     const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v                                      = this->kernel_map[key];
+    auto&& v                                      = this->kernel_map[key].kernels;
     if(!v.empty())
     {
         MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
@@ -166,6 +421,10 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
     v.clear();
 }
 
-KernelCache::KernelCache() {}
+KernelCache::KernelCache()
+    : program_budget(
+          static_cast<std::size_t>(Value(MIOPEN_DEBUG_PROGRAM_CACHE_BUDGET_MB{})) * 1024 * 1024)
+{
+}
 
 } // namespace miopen
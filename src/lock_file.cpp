@@ -24,10 +24,11 @@
  *
  *******************************************************************************/
 
+#include <miopen/cached_instances.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
-#include <miopen/md5.hpp>
+#include <miopen/xxhash.hpp>
 
 namespace fs = boost::filesystem;
 
@@ -53,7 +54,7 @@ std::string LockFilePath(const fs::path& filename_)
             fs::create_directories(directory);
             fs::permissions(directory, fs::all_all);
         }
-        const auto hash = md5(filename_.parent_path().string());
+        const auto hash = xxhash64(filename_.parent_path().string());
         const auto file = directory / (hash + "_" + filename_.filename().string() + ".lock");
 
         return file.string();
@@ -92,19 +93,14 @@ LockFile::LockFile(const char* path_, PassKey) : path(path_)
 LockFile& LockFile::Get(const char* path)
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    std::lock_guard<std::mutex> lock(mutex);
+    static auto lookup = CachedInstances<LockFile>{};
 
-    { // To guarantee that construction won't be called if not required.
-        auto found = LockFiles().find(path);
-
-        if(found != LockFiles().end())
-            return found->second;
-    }
-
-    auto emplaced = LockFiles().emplace(std::piecewise_construct,
-                                        std::forward_as_tuple(path),
-                                        std::forward_as_tuple(path, PassKey{}));
-    return emplaced.first->second;
+    // The lock files are owned by LockFiles(), which is only modified under the lookup mutex.
+    return lookup.Get(path, [&]() {
+        auto emplaced = LockFiles().emplace(std::piecewise_construct,
+                                            std::forward_as_tuple(path),
+                                            std::forward_as_tuple(path, PassKey{}));
+        return &emplaced.first->second;
+    });
 }
 } // namespace miopen
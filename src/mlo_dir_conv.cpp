@@ -60,7 +60,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_IMPLICIT_GEMM_FIND_ALL_SOLUTIONS)
 
 miopen::PerformanceDb miopen::GetDb(const miopen::ExecutionContext& ctx)
 {
-    return {ctx.GetPerfDbPath(), ctx.GetUserPerfDbPath()};
+    return {ctx.GetPerfDbPath(), ctx.GetUserPerfDbPath(), &GetDbStats().perf_db};
 }
 
 static auto GetGemmSolvers()
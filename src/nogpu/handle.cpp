@@ -28,6 +28,8 @@
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
 #include <miopen/binary_cache.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -35,6 +37,7 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/program_registry.hpp>
 #include <miopen/timer.hpp>
 #include <miopen/hipoc_program.hpp>
 
@@ -66,7 +69,13 @@ Handle::Handle() : impl(new HandleImpl())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    // The user dbs of the handle are named after its db basename. The queues of other handles
+    // are left to be written in the background.
+    if(DbWriteQueue::HasQueues())
+        DbWriteQueue::FlushAll(GetDbBasename());
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t /* streamID */) const {}
 
@@ -158,18 +167,49 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
+void Handle::ClearUnusedPrograms() const { this->impl->cache.ClearUnusedPrograms(); }
+
+void Handle::ScheduleClearUnusedPrograms() const
+{
+    this->impl->cache.ScheduleClearUnusedPrograms();
+}
+
+void Handle::SetProgramCacheBudget(std::size_t bytes) const
+{
+    this->impl->cache.SetProgramBudget(bytes);
+}
+
+KernelCacheStats Handle::GetKernelCacheStats() const { return this->impl->cache.GetStats(); }
+
 const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
                                                   const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
+const std::vector<Kernel>& Handle::GetKernelsImpl(std::string_view algorithm,
+                                                  const ProblemKey& network_config) const
+{
+    return this->impl->cache.GetKernels(algorithm, network_config);
+}
+
 KernelInvoke Handle::Run(Kernel /* k */) const { return {}; }
 
 Program Handle::LoadProgram(const std::string& program_name,
                             std::string params,
                             bool is_kernel_str,
                             const std::string& kernel_src) const
+{
+    return ProgramRegistry::Get().GetOrLoad(
+        this->GetTargetProperties().Name(), program_name, params, [&]() {
+            return LoadProgramUnshared(program_name, params, is_kernel_str, kernel_src);
+        });
+}
+
+Program Handle::LoadProgramUnshared(const std::string& program_name,
+                                    std::string params,
+                                    bool is_kernel_str,
+                                    const std::string& kernel_src) const
 {
     if(!miopen::EndsWith(program_name, ".mlir"))
     {
@@ -189,7 +229,12 @@ Program Handle::LoadProgram(const std::string& program_name,
     if(hsaco.empty())
     {
         // avoid the constructor since it implicitly calls the HIP API
+        const auto start = std::chrono::steady_clock::now();
         pgmImpl->BuildCodeObject(params, is_kernel_str, kernel_src);
+        GetDbStats().compilations.AddSince(start);
+        pgmImpl->code_object_size = p.IsCodeObjectInMemory()
+                                        ? pgmImpl->binary.size()
+                                        : boost::filesystem::file_size(pgmImpl->hsaco_file);
 // auto p = HIPOCProgram{
 //     program_name, params, is_kernel_str, this->GetTargetProperties(), kernel_src};
 
@@ -214,7 +259,8 @@ Program Handle::LoadProgram(const std::string& program_name,
     }
     else
     {
-        pgmImpl->binary = std::vector<char>(hsaco.begin(), hsaco.end());
+        pgmImpl->binary           = std::vector<char>(hsaco.begin(), hsaco.end());
+        pgmImpl->code_object_size = pgmImpl->binary.size();
         // return HIPOCProgram{program_name, hsaco};
     }
     return p;
@@ -31,8 +31,10 @@
 #include <miopen/convolution.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_stats.hpp>
 #include <miopen/env.hpp>
 #include <miopen/find_db.hpp>
+#include <miopen/find_db_nearest.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/invoker.hpp>
@@ -64,6 +66,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_TENSOR_PATH)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FORCE_IMMED_MODE_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_NEAREST)
 
 static inline bool IsValidFilterChannelNumber(const TensorDescriptor& x,
                                               const TensorDescriptor& w,
@@ -565,6 +568,24 @@ std::size_t ConvolutionDescriptor::GetSolutionCount(const ExecutionContext& ctx,
     return GetSolutionCountFallback(ctx, problem);
 }
 
+namespace {
+
+std::function<int(const std::string&)> GetAlgoResolver(conv::Direction direction)
+{
+    switch(direction)
+    {
+    case conv::Direction::Forward: return &StringToConvolutionFwdAlgo;
+    case conv::Direction::BackwardData: return &StringToConvolutionBwdDataAlgo;
+    case conv::Direction::BackwardWeights: return &StringToConvolutionBwdWeightsAlgo;
+    }
+    MIOPEN_THROW(miopenStatusInternalError);
+}
+
+/// Number of the nearest find-db records the fallback estimates the solvers from.
+constexpr std::size_t nearest_fallback_records = 3;
+
+} // namespace
+
 struct SolutionTimeComparator
 {
     bool operator()(const miopenConvSolution_t& lhs, const miopenConvSolution_t& rhs) const
@@ -632,12 +653,49 @@ ConvolutionDescriptor::GetSolutionsFallback(const ExecutionContext& ctx,
                     ai_time(idx), sol.GetWorkspaceSize(ctx, problem), solver_id.Value(), algo});
                 ++idx;
             }
+            if(!interim.empty())
+                ++GetDbStats().fallback_ai;
         }
     }
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
 
+    // Nearest find-db records Fallback
+    // Solvers measured for the most similar problems recorded in the system find-db.
+    if(interim.empty() && !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_NEAREST{}) &&
+       debug::testing_find_db_enabled && !miopen::IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}))
+    {
+        const auto path      = FindDbRecord::GetSystemShardPath(ctx.GetStream(), problem);
+        const auto estimates = FindDbNearest::GetEstimates(
+            path, DbRecord{problem}.GetKey(), nearest_fallback_records);
+        if(!estimates.empty())
+        {
+            MIOPEN_LOG_I2("Using nearest find-db records Fallback");
+            const auto algo_resolver = GetAlgoResolver(problem.GetDirection());
+            for(const auto& estimate : estimates)
+            {
+                const auto solver_id = solver::Id{estimate.solver};
+                if(!solver_id.IsValid())
+                    continue;
+                const auto algo =
+                    static_cast<miopenConvAlgorithm_t>(algo_resolver(estimate.algorithm));
+                if(conv::IsAlgorithmDisabled(algo))
+                    continue;
+                // Unlike the other fallbacks, non-dynamic solvers are allowed, as they are
+                // for the exact find-db records.
+                const auto& s = solver_id.GetSolver();
+                if(s.IsEmpty() || !s.IsApplicable(ctx, problem))
+                    continue;
+                interim.emplace_back(miopenConvSolution_t{
+                    estimate.time, s.GetWorkspaceSize(ctx, problem), solver_id.Value(), algo});
+            }
+            if(!interim.empty())
+                ++GetDbStats().fallback_nearest;
+        }
+    }
+
     // WTI Fallback
-    // if TunaNet is not enabled or produces no applicable solvers then fallback to WTI
+    // if TunaNet and the nearest records are not available or produce no applicable solvers
+    // then fallback to WTI
     if(interim.empty())
     {
         MIOPEN_LOG_I2("Using WTI Fallback");
@@ -667,6 +725,7 @@ ConvolutionDescriptor::GetSolutionsFallback(const ExecutionContext& ctx,
             interim.emplace_back(miopenConvSolution_t{
                 wti2time(wti), s.GetWorkspaceSize(ctx, problem), solver_id.Value(), algo});
         }
+        ++(interim.empty() ? GetDbStats().fallback_failed : GetDbStats().fallback_wti);
     }
     MIOPEN_LOG_I2("maxSolutionCount = " << maxSolutionCount << ", available = " << interim.size());
     for(const auto& s : interim)
@@ -685,16 +744,7 @@ std::vector<miopenConvSolution_t> GetSolutions(const ExecutionContext& ctx,
                                                const conv::ProblemDescription& problem,
                                                const size_t maxSolutionCount)
 {
-    auto algo_resolver = std::function<int(const std::string&)>{};
-
-    switch(problem.GetDirection())
-    {
-    case conv::Direction::Forward: algo_resolver = &StringToConvolutionFwdAlgo; break;
-    case conv::Direction::BackwardData: algo_resolver = &StringToConvolutionBwdDataAlgo; break;
-    case conv::Direction::BackwardWeights:
-        algo_resolver = &StringToConvolutionBwdWeightsAlgo;
-        break;
-    }
+    const auto algo_resolver = GetAlgoResolver(problem.GetDirection());
 
     const FindDbRecord fdb_record{ctx.GetStream(), problem};
 
@@ -28,6 +28,8 @@
 
 #include <miopen/binary_cache.hpp>
 #include <miopen/config.h>
+#include <miopen/db_stats.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle_lock.hpp>
@@ -271,7 +273,13 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+Handle::~Handle()
+{
+    // The user dbs of the handle are named after its db basename. The queues of other handles
+    // are left to be written in the background. Moved-from handles have no device.
+    if(impl != nullptr && DbWriteQueue::HasQueues())
+        DbWriteQueue::FlushAll(GetDbBasename());
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -375,6 +383,12 @@ const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
+const std::vector<Kernel>& Handle::GetKernelsImpl(std::string_view algorithm,
+                                                  const ProblemKey& network_config) const
+{
+    return this->impl->cache.GetKernels(algorithm, network_config);
+}
+
 KernelInvoke Handle::Run(Kernel k) const
 {
     auto q = this->GetStream();
@@ -403,6 +417,7 @@ Program Handle::LoadProgram(const std::string& program_name,
                                     is_kernel_str);
     if(hsaco.empty())
     {
+        const auto start = std::chrono::steady_clock::now();
         CompileTimer ct;
         auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
                                      miopen::GetDevice(this->GetStream()),
@@ -411,6 +426,7 @@ Program Handle::LoadProgram(const std::string& program_name,
                                      params,
                                      is_kernel_str,
                                      kernel_src);
+        GetDbStats().compilations.AddSince(start);
         ct.Log("Kernel", is_kernel_str ? std::string() : program_name);
 
 // Save to cache
@@ -448,6 +464,20 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
+void Handle::ClearUnusedPrograms() const { this->impl->cache.ClearUnusedPrograms(); }
+
+void Handle::ScheduleClearUnusedPrograms() const
+{
+    this->impl->cache.ScheduleClearUnusedPrograms();
+}
+
+void Handle::SetProgramCacheBudget(std::size_t bytes) const
+{
+    this->impl->cache.SetProgramBudget(bytes);
+}
+
+KernelCacheStats Handle::GetKernelCacheStats() const { return this->impl->cache.GetStats(); }
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -32,6 +32,7 @@
 #include <miopen/visit_float.hpp>
 #include <miopen/util.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/problem_key.hpp>
 #include <algorithm>
 #include <cassert>
 #include <numeric>
@@ -174,10 +175,8 @@ void OpTensor3d(const Handle& handle,
 
     size_t local_threads = 256;
 
-    std::string network_config{};
-
-    network_config = std::to_string(bTensorDesc.GetType()) + "-" +
-                     std::to_string(aTensorDesc.GetType()) + "-" + std::to_string(tensorOp) + "-";
+    auto network_config = ProblemKey{"OpTensor3d"};
+    network_config.Add(bTensorDesc.GetType()).Add(aTensorDesc.GetType()).Add(tensorOp);
 
     // for naive tensor ops
     size_t RD_BLCK              = (clens[2] % 4 == 0) ? 4 : (clens[2] % 2 == 0) ? 2 : 1;
@@ -213,9 +212,11 @@ void OpTensor3d(const Handle& handle,
         if(lite_applicable && is_lite)
         {
 
-            network_config += std::to_string(RD_BLCK) + "x" + std::to_string(local_threads) + "x" +
-                              std::to_string(grp_sz) + std::to_string(local_threads2) +
-                              std::to_string(grp_sz2);
+            network_config.Add(RD_BLCK)
+                .Add(local_threads)
+                .Add(grp_sz)
+                .Add(local_threads2)
+                .Add(grp_sz2);
 
             auto&& kernels = handle.GetKernels("Op2dTensorLite", network_config);
 
@@ -245,8 +246,7 @@ void OpTensor3d(const Handle& handle,
         }
         else if(is_squashed)
         {
-            network_config += std::to_string(RD_BLCK) + "x" + std::to_string(local_threads) + "x" +
-                              std::to_string(grp_sz);
+            network_config.Add(RD_BLCK).Add(local_threads).Add(grp_sz);
 
             auto&& kernels = handle.GetKernels("Op2dTensorSquash", network_config);
 
@@ -276,8 +276,7 @@ void OpTensor3d(const Handle& handle,
         else
         {
 
-            network_config += std::to_string(max_num_wg) + "-" + std::to_string(local_threads) +
-                              "x" + std::to_string(num_wg);
+            network_config.Add(max_num_wg).Add(local_threads).Add(num_wg);
 
             auto&& kernels = handle.GetKernels("Op3dTensorGeneric", network_config);
 
@@ -335,24 +334,28 @@ void OpTensor3d(const Handle& handle,
 
             const std::vector<size_t> vgd1{glb_sz, glb_sz2, 1};
 
-            handle.AddKernel(
-                "Op2dTensorLite", network_config, program_name, "Op2dTensorLite", vld, vgd1, parms)(
-                ATensor,
-                static_cast<int>(astrides[1]), // a_cstride,
-                BTensor,
-                static_cast<int>(bstrides[1]), // b_cstride,
-                CTensor,
-                static_cast<int>(cstrides[1]), // c_cstride,
-                miopen_alpha0,
-                miopen_alpha1,
-                miopen_beta,
-                static_cast<int64_t>(Aoffset),
-                static_cast<int64_t>(Boffset),
-                static_cast<int64_t>(Coffset),
-                static_cast<int64_t>(total_work),
-                static_cast<int64_t>(total_work2),
-                static_cast<int>(!float_equal(miopen_beta, 0.0)),
-                static_cast<int>(blens[1] == 1));
+            handle.AddKernel("Op2dTensorLite",
+                             network_config.ToString(),
+                             program_name,
+                             "Op2dTensorLite",
+                             vld,
+                             vgd1,
+                             parms)(ATensor,
+                                    static_cast<int>(astrides[1]), // a_cstride,
+                                    BTensor,
+                                    static_cast<int>(bstrides[1]), // b_cstride,
+                                    CTensor,
+                                    static_cast<int>(cstrides[1]), // c_cstride,
+                                    miopen_alpha0,
+                                    miopen_alpha1,
+                                    miopen_beta,
+                                    static_cast<int64_t>(Aoffset),
+                                    static_cast<int64_t>(Boffset),
+                                    static_cast<int64_t>(Coffset),
+                                    static_cast<int64_t>(total_work),
+                                    static_cast<int64_t>(total_work2),
+                                    static_cast<int>(!float_equal(miopen_beta, 0.0)),
+                                    static_cast<int>(blens[1] == 1));
         }
         else if(is_squashed)
         {
@@ -362,7 +365,7 @@ void OpTensor3d(const Handle& handle,
             const std::vector<size_t> vgd1{glb_sz, 1, 1};
 
             handle.AddKernel("Op2dTensorSquash",
-                             network_config,
+                             network_config.ToString(),
                              program_name,
                              "Op2dTensorSquash",
                              vld,
@@ -394,7 +397,7 @@ void OpTensor3d(const Handle& handle,
             parms += " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
             handle.AddKernel("Op3dTensorGeneric",
-                             network_config,
+                             network_config.ToString(),
                              program_name,
                              "Op3dTensorGeneric",
                              vld,
@@ -544,12 +547,13 @@ void OpTensor4d(const Handle& handle,
     grp_sz            = std::min(size_t(max_num_wg), grp_sz);
     size_t glb_sz     = local_threads * grp_sz;
 
-    std::string network_config{};
-    network_config +=
-        std::to_string(bTensorDesc.GetType()) + "-" + std::to_string(aTensorDesc.GetType()) + "-" +
-        std::to_string(tensorOp) + "-" + std::to_string(max_num_wg) + "-" +
-        ((fwd_conv_bias == 0 && packed_equal_tensor) ? "" : std::to_string(global_threads)) + "-" +
-        std::to_string(local_threads);
+    auto network_config = ProblemKey{"OpTensor4d"};
+    network_config.Add(bTensorDesc.GetType())
+        .Add(aTensorDesc.GetType())
+        .Add(tensorOp)
+        .Add(max_num_wg)
+        .Add((fwd_conv_bias == 0 && packed_equal_tensor) ? 0 : global_threads)
+        .Add(local_threads);
 
     visit_float(bTensorDesc.GetType(), [&](auto as_float) {
         auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
@@ -622,7 +626,7 @@ void OpTensor4d(const Handle& handle,
         // precede leading_ones for bitmap = 1,1,1,1
         else if(packed_equal_tensor)
         {
-            network_config += "x" + std::to_string(grp_sz) + "x" + std::to_string(RD_BLCK);
+            network_config.Add(grp_sz).Add(RD_BLCK);
             auto&& kernels = handle.GetKernels("Op4dTensorLite", network_config);
             if(!kernels.empty())
             {
@@ -766,7 +770,7 @@ void OpTensor4d(const Handle& handle,
                 parms += " -DUSE_FWD_BIAS";
 
                 handle.AddKernel("OpTensorFwdBias",
-                                 network_config,
+                                 network_config.ToString(),
                                  program_name,
                                  "OpTensorFwdBias",
                                  vld,
@@ -792,7 +796,7 @@ void OpTensor4d(const Handle& handle,
             {
                 parms += " -DUSE_FWD_BIAS_GENERIC";
                 handle.AddKernel("OpTensorFwdBiasGeneric",
-                                 network_config,
+                                 network_config.ToString(),
                                  program_name,
                                  "OpTensorFwdBiasGeneric",
                                  vld,
@@ -829,19 +833,23 @@ void OpTensor4d(const Handle& handle,
 
             const std::vector<size_t> vgd1{glb_sz, 1, 1};
 
-            handle.AddKernel(
-                "Op4dTensorLite", network_config, program_name, "Op4dTensorLite", vld, vgd1, parms)(
-                ATensor,
-                BTensor,
-                CTensor,
-                miopen_alpha0,
-                miopen_alpha1,
-                miopen_beta,
-                static_cast<int64_t>(Aoffset),
-                static_cast<int64_t>(Boffset),
-                static_cast<int64_t>(Coffset),
-                static_cast<int64_t>(total_work),
-                static_cast<int>(!float_equal(miopen_beta, 0.0)));
+            handle.AddKernel("Op4dTensorLite",
+                             network_config.ToString(),
+                             program_name,
+                             "Op4dTensorLite",
+                             vld,
+                             vgd1,
+                             parms)(ATensor,
+                                    BTensor,
+                                    CTensor,
+                                    miopen_alpha0,
+                                    miopen_alpha1,
+                                    miopen_beta,
+                                    static_cast<int64_t>(Aoffset),
+                                    static_cast<int64_t>(Boffset),
+                                    static_cast<int64_t>(Coffset),
+                                    static_cast<int64_t>(total_work),
+                                    static_cast<int>(!float_equal(miopen_beta, 0.0)));
         }
         else if(leading_ones)
         {
@@ -849,7 +857,7 @@ void OpTensor4d(const Handle& handle,
             {
                 parms += " -DUSE_LEADING_ONES";
                 handle.AddKernel("OpTensorLeadingOnes",
-                                 network_config,
+                                 network_config.ToString(),
                                  program_name,
                                  "OpTensorLeadingOnes",
                                  vld,
@@ -878,7 +886,7 @@ void OpTensor4d(const Handle& handle,
                 parms += " -DUSE_LEADING_ONES_GENERIC";
 
                 handle.AddKernel("OpTensorLeadingOnesGeneric",
-                                 network_config,
+                                 network_config.ToString(),
                                  program_name,
                                  "OpTensorLeadingOnesGeneric",
                                  vld,
@@ -914,7 +922,7 @@ void OpTensor4d(const Handle& handle,
             parms += " -DUSE_4D_TENSOR_GENERIC";
 
             handle.AddKernel("Op4dTensorGeneric",
-                             network_config,
+                             network_config.ToString(),
                              program_name,
                              "Op4dTensorGeneric",
                              vld,
@@ -1021,10 +1029,12 @@ void OpTensorOther(const Handle& handle,
 
     const std::vector<size_t> vgd{global_threads, 1, 1};
 
-    std::string network_config{};
-    network_config += std::to_string(bTensorDesc.GetType()) + "-" +
-                      std::to_string(aTensorDesc.GetType()) + "-" + std::to_string(tensorOp) + "-" +
-                      std::to_string(global_threads) + "-" + std::to_string(local_threads);
+    auto network_config = ProblemKey{"OpTensorOther"};
+    network_config.Add(bTensorDesc.GetType())
+        .Add(aTensorDesc.GetType())
+        .Add(tensorOp)
+        .Add(global_threads)
+        .Add(local_threads);
 
     visit_float(bTensorDesc.GetType(), [&](auto as_float) {
         auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
@@ -1145,7 +1155,7 @@ void OpTensorOther(const Handle& handle,
             parms += " -DUSE_5D_TENSOR_GENERIC";
 
             handle.AddKernel("Op5dTensorGeneric",
-                             network_config,
+                             network_config.ToString(),
                              program_name,
                              "Op5dTensorGeneric",
                              vld,
@@ -1188,7 +1198,7 @@ void OpTensorOther(const Handle& handle,
             parms += " -DUSE_2D_TENSOR_GENERIC";
 
             handle.AddKernel("Op2dTensorGeneric",
-                             network_config,
+                             network_config.ToString(),
                              program_name,
                              "Op2dTensorGeneric",
                              vld,
@@ -1216,7 +1226,7 @@ void OpTensorOther(const Handle& handle,
             parms += " -DUSE_1D_TENSOR_GENERIC";
 
             handle.AddKernel("Op1dTensorGeneric",
-                             network_config,
+                             network_config.ToString(),
                              program_name,
                              "Op1dTensorGeneric",
                              vld,
@@ -87,6 +87,27 @@ NetworkConfig ProblemDescription::MakeNetworkConfig() const
     return NetworkConfig{ss.str()};
 }
 
+ProblemKey ProblemDescription::MakeProblemKey() const
+{
+    const auto cast_type = xDesc.GetCastType();
+
+    auto key = ProblemKey{"Pooling"};
+    key.Add(direction).Add(pooling.GetMode()).Add(xDesc.GetType());
+    key.Add(cast_type ? static_cast<int64_t>(*cast_type) : -1);
+    key.AddRange(pooling.lens).AddRange(pooling.strides).AddRange(pooling.pads);
+    key.Add(pooling.GetIndexType()).Add(pooling.GetWorkspaceIndexMode());
+    if(direction == Direction::Forward)
+        key.Add(save_index);
+    key.AddRange(xDesc.GetLengths()).AddRange(xDesc.GetStrides());
+    key.AddRange(yDesc.GetLengths()).AddRange(yDesc.GetStrides());
+    if(direction == Direction::Backward)
+    {
+        key.AddRange(dxDesc.GetLengths()).AddRange(dxDesc.GetStrides());
+        key.AddRange(dyDesc.GetLengths()).AddRange(dyDesc.GetStrides());
+    }
+    return key;
+}
+
 } // namespace pooling
 
 } // namespace miopen
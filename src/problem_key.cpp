@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/problem_key.hpp>
+#include <miopen/xxhash.hpp>
+
+#include <cstring>
+#include <unordered_map>
+
+namespace miopen {
+
+uint64_t ProblemKey::GetHash() const
+{
+    // Names are not hashed, equal fields of different primitives only cost a comparison.
+    return xxhash64(fields.data(), size * sizeof(int64_t), size);
+}
+
+std::string ProblemKey::ToString() const
+{
+    auto str = std::string{};
+    for(auto i = std::size_t{0}; i < size; ++i)
+    {
+        if(i != 0)
+            str += '-';
+        str += std::to_string(fields[i]);
+    }
+    return str;
+}
+
+bool ProblemKey::operator==(const ProblemKey& other) const
+{
+    return size == other.size &&
+           std::memcmp(fields.data(), other.fields.data(), size * sizeof(int64_t)) == 0 &&
+           (name == other.name || std::strcmp(name, other.name) == 0);
+}
+
+constexpr std::size_t max_cached_network_configs = 1024;
+
+std::shared_ptr<const NetworkConfig>
+GetNetworkConfig(const ProblemKey& key, const std::function<NetworkConfig()>& make_config)
+{
+    // Immediate mode calls are usually repeated with the same few problems, so no locks are taken
+    // and the cache is simply dropped when it grows too large. The configs are shared, so the ones
+    // returned before stay valid.
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    thread_local auto cache =
+        std::unordered_map<ProblemKey, std::shared_ptr<const NetworkConfig>, ProblemKey::Hash>{};
+
+    const auto found = cache.find(key);
+    if(found != cache.end())
+        return found->second;
+    if(cache.size() >= max_cached_network_configs)
+        cache.clear();
+
+    auto config = std::make_shared<const NetworkConfig>(make_config());
+    cache.emplace(key, config);
+    return config;
+}
+
+} // namespace miopen
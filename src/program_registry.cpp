@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/program_registry.hpp>
+
+#if MIOPEN_BACKEND_HIP
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <exception>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_SHARED_PROGRAMS)
+
+namespace miopen {
+
+ProgramRegistry& ProgramRegistry::Get()
+{
+    static ProgramRegistry registry;
+    return registry;
+}
+
+HIPOCProgram ProgramRegistry::GetOrLoad(const std::string& device,
+                                        const std::string& program_name,
+                                        const std::string& params,
+                                        const std::function<HIPOCProgram()>& loader)
+{
+    if(IsEnabled(MIOPEN_DEBUG_DISABLE_SHARED_PROGRAMS{}))
+        return loader();
+
+    auto lock   = std::unique_lock<std::mutex>{mutex};
+    auto& entry = entries[Key{device, program_name, params}];
+
+    auto program = HIPOCProgram{};
+    program.impl = entry.program.lock();
+    if(program.impl != nullptr)
+    {
+        ++hits;
+        MIOPEN_LOG_I2("Sharing program: " << program_name << " \"" << params << '"');
+        return program;
+    }
+
+    if(entry.loading.valid())
+    {
+        ++hits;
+        auto loading = entry.loading;
+        lock.unlock();
+        MIOPEN_LOG_I2("Waiting for program: " << program_name << " \"" << params << '"');
+        return loading.get();
+    }
+
+    auto promise  = std::promise<HIPOCProgram>{};
+    entry.loading = promise.get_future().share();
+    lock.unlock();
+
+    try
+    {
+        program = loader();
+    }
+    catch(...)
+    {
+        lock.lock();
+        entries[Key{device, program_name, params}].loading = {};
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    lock.lock();
+    // The entry is not erased while it is loading.
+    auto& loaded   = entries[Key{device, program_name, params}];
+    loaded.program = program.impl;
+    loaded.loading = {};
+    ++loads;
+    promise.set_value(program);
+    if(entries.size() >= prune_threshold)
+        PruneUnsafe();
+    return program;
+}
+
+void ProgramRegistry::PruneUnsafe()
+{
+    for(auto it = entries.begin(); it != entries.end();)
+    {
+        if(it->second.program.expired() && !it->second.loading.valid())
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+    prune_threshold = std::max<std::size_t>(64, entries.size() * 2);
+}
+
+ProgramRegistry::Stats ProgramRegistry::GetStats() const
+{
+    const auto lock = std::lock_guard<std::mutex>{mutex};
+    auto stats      = Stats{};
+    stats.loads     = loads;
+    stats.hits      = hits;
+    stats.programs  = std::count_if(entries.begin(), entries.end(), [](auto&& entry) {
+        return !entry.second.program.expired();
+    });
+    return stats;
+}
+
+} // namespace miopen
+
+#endif
@@ -26,6 +26,7 @@
 
 #include <miopen/ramdb.hpp>
 
+#include <miopen/cached_instances.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -34,6 +35,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
@@ -41,9 +43,28 @@
 #include <map>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 namespace miopen {
 
+namespace debug {
+
+boost::optional<std::chrono::milliseconds>& ramdb_check_interval_override()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static boost::optional<std::chrono::milliseconds> data = boost::none;
+    return data;
+}
+
+} // namespace debug
+
+static ramdb_clock::duration GetCheckInterval()
+{
+    if(debug::ramdb_check_interval_override())
+        return *debug::ramdb_check_interval_override();
+    return std::chrono::milliseconds{100};
+}
+
 std::string RamDb::GetTimeFilePath(const std::string& path) { return path + ".time"; }
 
 static ramdb_clock::time_point GetDbModificationTime(const std::string& path)
@@ -56,7 +77,9 @@ static ramdb_clock::time_point GetDbModificationTime(const std::string& path)
         return {};
 
     ramdb_clock::rep time;
-    file >> time;
+    if(!(file >> time))
+        // The file is being written by someone else, so the db is being changed too.
+        return ramdb_clock::time_point::max();
     return ramdb_clock::time_point{ramdb_clock::duration{time}};
 }
 
@@ -77,6 +100,19 @@ static void UpdateDbModificationTime(const std::string& path)
     file << time.count();
 }
 
+#if MIOPEN_DB_CACHE_WRITE_THROUGH
+/// Same as the part of the line after '=' in the file, i.e. without the line break.
+std::string RamDb::GetCacheContents(const DbRecord& record)
+{
+    auto ss = std::ostringstream{};
+    record.WriteIdsAndValues(ss);
+    auto contents = ss.str();
+    if(!contents.empty() && contents.back() == '\n')
+        contents.pop_back();
+    return contents;
+}
+#endif
+
 #define MIOPEN_VALIDATE_LOCK(lock)                       \
     do                                                   \
     {                                                    \
@@ -88,48 +124,128 @@ static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60};
 
 using exclusive_lock = std::unique_lock<LockFile>;
 
-RamDb::RamDb(std::string path, bool is_system) : PlainTextDb(path, is_system) {}
+static std::size_t GetNextInstanceId()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::atomic<std::size_t> next_id{1};
+    return next_id++;
+}
+
+RamDb::RamDb(std::string path, bool is_system)
+    : PlainTextDb(path, is_system), instance_id(GetNextInstanceId())
+{
+    PublishUnsafe();
+}
 
 RamDb& RamDb::GetCached(const std::string& path, bool is_system)
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    const std::lock_guard<std::mutex> lock{mutex};
+    static auto instances = CachedInstances<RamDb>{};
+    return instances.Get(path, [&]() {
+        // The ReadonlyRamDb objects allocated here by "new" shall be alive during
+        // the calling app lifetime. Size of each is very small, and there couldn't
+        // be many of them (max number is number of _different_ GPU board installed
+        // in the user's system, which is _one_ for now). Therefore the total
+        // footprint in heap is very small. That is why we can omit deletion of
+        // these objects thus avoiding bothering with MP/MT syncronization.
+        // These will be destroyed altogether with heap.
+        auto instance = new RamDb{path, is_system};
+        if(!DisableUserDbFileIO)
+        {
+            const auto prefetch_lock = exclusive_lock(instance->GetLockFile(), GetLockTimeout());
+            MIOPEN_VALIDATE_LOCK(prefetch_lock);
+            instance->Prefetch();
+        }
+        return instance;
+    });
+}
+
+const RamDb::Snapshot& RamDb::GetSnapshot() const
+{
+    struct CachedSnapshot
+    {
+        std::size_t instance_id = 0;
+        std::size_t version     = 0;
+        std::shared_ptr<const Snapshot> snapshot;
+    };
 
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto instances = std::map<std::string, RamDb*>{};
-    const auto it         = instances.find(path);
-
-    if(it != instances.end())
-        return *it->second;
-
-    // The ReadonlyRamDb objects allocated here by "new" shall be alive during
-    // the calling app lifetime. Size of each is very small, and there couldn't
-    // be many of them (max number is number of _different_ GPU board installed
-    // in the user's system, which is _one_ for now). Therefore the total
-    // footprint in heap is very small. That is why we can omit deletion of
-    // these objects thus avoiding bothering with MP/MT syncronization.
-    // These will be destroyed altogether with heap.
-    auto instance = new RamDb{path, is_system};
-    instances.emplace(path, instance);
-    if(!DisableUserDbFileIO)
+    thread_local auto cached = std::unordered_map<const RamDb*, CachedSnapshot>{};
+
+    // The snapshot is stored before the version is incremented, so the loaded snapshot is never
+    // older than the loaded version.
+    const auto version = snapshot_version.load(std::memory_order_acquire);
+    auto& entry        = cached[this];
+
+    if(entry.instance_id != instance_id || entry.version != version)
+        entry = {instance_id, version, std::atomic_load(&snapshot)};
+
+    return *entry.snapshot;
+}
+
+void RamDb::PublishUnsafe()
+{
+    published_cache = std::make_shared<const Cache>(cache);
+    published_changes.clear();
+    StoreSnapshotUnsafe();
+}
+
+void RamDb::PublishUnsafe(const std::string& key)
+{
+    constexpr std::size_t min_changes = 16;
+    const auto count                  = published_changes.size();
+    if(count >= min_changes && count * count >= cache.size())
     {
-        const auto prefetch_lock = exclusive_lock(instance->GetLockFile(), GetLockTimeout());
-        MIOPEN_VALIDATE_LOCK(prefetch_lock);
-        instance->Prefetch();
+        PublishUnsafe();
+        return;
     }
-    return *instance;
+
+    const auto it = cache.find(key);
+    published_changes[key] =
+        it != cache.end() ? boost::make_optional(it->second) : boost::optional<CacheItem>{};
+    StoreSnapshotUnsafe();
+}
+
+void RamDb::StoreSnapshotUnsafe()
+{
+    // The cache has just been read from the file or changed along with it, unless nothing has
+    // been read yet.
+    const auto checked_until = file_read_time == ramdb_clock::time_point{}
+                                   ? file_read_time
+                                   : file_read_time + GetCheckInterval();
+    auto next = std::make_shared<const Snapshot>(
+        file_read_time, published_cache, published_changes, cache.empty(), checked_until);
+    std::atomic_store(&snapshot, std::move(next));
+    snapshot_version.fetch_add(1, std::memory_order_release);
+}
+
+bool RamDb::IsCurrent(const Snapshot& current) const
+{
+    const auto now = ramdb_clock::now();
+    if(now.time_since_epoch().count() < current.checked_until.load(std::memory_order_relaxed))
+        return true;
+    if(!IsCurrent(current.read_time, current.is_empty))
+        return false;
+    const auto until = now + GetCheckInterval();
+    current.checked_until.store(until.time_since_epoch().count(), std::memory_order_relaxed);
+    return true;
 }
 
 boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
 {
+    {
+        const auto& current = GetSnapshot();
+        if(IsCurrent(current))
+            return FindRecordIn(current, problem);
+    }
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
     if(!ValidateUnsafe())
     {
-        MIOPEN_LOG_I2("RamDb file is newer than cache, prefetching");
-        Prefetch();
+        MIOPEN_LOG_I2("RamDb file is newer than cache, reloading");
+        ReloadUnsafe();
     }
 
     return FindRecordUnsafe(problem);
@@ -143,6 +259,10 @@ bool RamDb::StoreRecord(const DbRecord& record)
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
+#if MIOPEN_DB_CACHE_WRITE_THROUGH
+    const auto is_valid = ValidateUnsafe();
+#endif
+
     if(!DisableUserDbFileIO)
     {
         if(!StoreRecordUnsafe(record))
@@ -151,7 +271,7 @@ bool RamDb::StoreRecord(const DbRecord& record)
     }
 
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
-    UpdateCacheEntryUnsafe(record);
+    UpdateCacheEntryUnsafe(record, is_valid);
 #else
     Prefetch();
 #endif
@@ -166,6 +286,10 @@ bool RamDb::UpdateRecord(DbRecord& record)
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
+#if MIOPEN_DB_CACHE_WRITE_THROUGH
+    const auto is_valid = ValidateUnsafe();
+#endif
+
     if(!DisableUserDbFileIO)
     {
         if(!UpdateRecordUnsafe(record))
@@ -174,7 +298,7 @@ bool RamDb::UpdateRecord(DbRecord& record)
     }
 
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
-    UpdateCacheEntryUnsafe(record);
+    UpdateCacheEntryUnsafe(record, is_valid);
 #else
     Prefetch();
 #endif
@@ -204,6 +328,12 @@ bool RamDb::RemoveRecord(const std::string& key)
     {
         cache.erase(key);
         file_read_time = ramdb_clock::now();
+        PublishUnsafe(key);
+        if(!DisableUserDbFileIO)
+        {
+            auto file = std::ifstream{GetFileName()};
+            UpdateFileStateUnsafe(file);
+        }
     }
 #else
     Prefetch();
@@ -244,13 +374,17 @@ bool RamDb::Remove(const std::string& key, const std::string& id)
         }
         else
         {
-            auto it = cache.find(key);
-            auto ss = std::ostringstream{};
-            record->WriteIdsAndValues(ss);
-            it->second.content = ss.str();
+            auto it            = cache.find(key);
+            it->second.content = GetCacheContents(*record);
         }
 
         file_read_time = ramdb_clock::now();
+        PublishUnsafe(key);
+        if(!DisableUserDbFileIO)
+        {
+            auto file = std::ifstream{GetFileName()};
+            UpdateFileStateUnsafe(file);
+        }
     }
 #else
     Prefetch();
@@ -263,17 +397,40 @@ boost::optional<miopen::DbRecord> RamDb::FindRecordUnsafe(const std::string& pro
 {
     MIOPEN_LOG_I2("Looking for key " << problem << " in cache for file " << GetFileName());
     const auto it = cache.find(problem);
-
     if(it == cache.end())
         return boost::none;
+    return ParseRecord(problem, it->second);
+}
+
+boost::optional<miopen::DbRecord> RamDb::FindRecordIn(const Snapshot& current,
+                                                      const std::string& problem) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in cache for file " << GetFileName());
 
+    const auto change = current.changes.find(problem);
+    if(change != current.changes.end())
+    {
+        if(!change->second)
+            return boost::none;
+        return ParseRecord(problem, *change->second);
+    }
+
+    const auto it = current.base->find(problem);
+    if(it == current.base->end())
+        return boost::none;
+    return ParseRecord(problem, it->second);
+}
+
+boost::optional<miopen::DbRecord> RamDb::ParseRecord(const std::string& problem,
+                                                     const CacheItem& item) const
+{
     auto record = DbRecord{problem};
 
-    if(!record.ParseContents(it->second.content))
+    if(!record.ParseContents(item.content))
     {
         MIOPEN_LOG_E("Error parsing payload under the key: "
-                     << problem << " form file " << GetFileName() << "#" << it->second.line);
-        MIOPEN_LOG_E("Contents: " << it->second.content);
+                     << problem << " form file " << GetFileName() << "#" << item.line);
+        MIOPEN_LOG_E("Contents: " << item.content);
         return boost::none;
     }
 
@@ -284,7 +441,10 @@ template <class TFunc>
 static void Measure(const std::string& funcName, TFunc&& func)
 {
     if(!miopen::IsLogging(LoggingLevel::Info))
+    {
         func();
+        return;
+    }
 
     const auto start = std::chrono::high_resolution_clock::now();
     func();
@@ -293,16 +453,25 @@ static void Measure(const std::string& funcName, TFunc&& func)
 }
 
 bool RamDb::ValidateUnsafe()
+{
+    if(IsCurrent(file_read_time, cache.empty()))
+        return true;
+    // The readers have to check the file again until the cache is reloaded.
+    std::atomic_load(&snapshot)->checked_until.store(0, std::memory_order_relaxed);
+    return false;
+}
+
+bool RamDb::IsCurrent(ramdb_clock::time_point read_time, bool is_empty) const
 {
     if(DisableUserDbFileIO)
         return true;
     if(!boost::filesystem::exists(GetFileName()))
-        return cache.empty();
+        return is_empty;
     const auto file_mod_time     = GetDbModificationTime(GetFileName());
-    const auto validation_result = file_mod_time < file_read_time;
+    const auto validation_result = file_mod_time < read_time;
     MIOPEN_LOG_I2("DB file is " << (validation_result ? "older" : "newer")
                                 << " than cache: " << file_mod_time.time_since_epoch().count()
-                                << ", " << file_read_time.time_since_epoch().count());
+                                << ", " << read_time.time_since_epoch().count());
     return validation_result;
 }
 
@@ -323,61 +492,127 @@ void RamDb::Prefetch()
         }
 
         cache.clear();
-        auto line   = std::string{};
-        auto n_line = 0;
-
-        while(std::getline(file, line))
-        {
-            ++n_line;
+        file_state = {GetDbFileState(GetFileName()).id, 0};
+        file_lines = 0;
+        ParseUnsafe(file);
+        file_read_time = ramdb_clock::now();
+        PublishUnsafe();
+        ++full_reloads;
+    });
+}
 
-            if(line.empty())
-                continue;
+static std::string ReadTail(std::istream& file, std::streamoff end)
+{
+    constexpr std::streamoff max_tail_size = 64;
+
+    const auto begin = std::max<std::streamoff>(0, end - max_tail_size);
+    auto tail        = std::string(end - begin, '\0');
+    file.clear();
+    file.seekg(begin);
+    file.read(&tail[0], tail.size());
+    tail.resize(file.gcount());
+    return tail;
+}
 
-            const auto key_size = line.find('=');
-            const bool is_key   = (key_size != std::string::npos && key_size != 0);
+void RamDb::ReloadUnsafe()
+{
+    if(DisableUserDbFileIO)
+        MIOPEN_THROW("Reload should never happen with disabled File IO");
 
-            if(!is_key)
-            {
-                MIOPEN_LOG_E("Ill-formed record: key not found: " << GetFileName() << "#"
-                                                                  << n_line);
-                continue;
-            }
+    auto file        = std::ifstream{GetFileName()};
+    const auto state = GetDbFileState(GetFileName());
 
-            const auto key      = line.substr(0, key_size);
-            const auto contents = line.substr(key_size + 1);
+    const auto appended_only = file && state.size >= 0 && file_state.size >= 0 &&
+                               state.id == file_state.id && state.size >= file_state.size &&
+                               ReadTail(file, file_state.size) == file_tail;
 
-            cache.emplace(key, CacheItem{n_line, contents});
-        }
+    if(!appended_only)
+    {
+        MIOPEN_LOG_I2("RamDb file has been rewritten, reloading it completely");
+        Prefetch();
+        return;
+    }
 
+    Measure("IncrementalReload", [&]() {
+        file.clear();
+        file.seekg(file_state.size);
+        ParseUnsafe(file);
         file_read_time = ramdb_clock::now();
+        PublishUnsafe();
+        ++incremental_reloads;
     });
 }
 
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
-void RamDb::UpdateCacheEntryUnsafe(const DbRecord& record)
+void RamDb::ParseUnsafe(std::istream& file)
 {
-    const auto is_valid = ValidateUnsafe();
+    auto line   = std::string{};
+    auto offset = file_state.size;
 
-    if(!DisableUserDbFileIO)
-        UpdateDbModificationTime(GetFileName());
+    while(std::getline(file, line))
+    {
+        ++file_lines;
+        offset += static_cast<std::streamoff>(line.size()) + (file.eof() ? 0 : 1);
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+
+        if(!is_key)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << GetFileName() << "#"
+                                                              << file_lines);
+            continue;
+        }
+
+        const auto key      = line.substr(0, key_size);
+        const auto contents = line.substr(key_size + 1);
+
+        // The last record with a key wins and an empty one removes it, so log-structured
+        // files are read the same way as plain ones.
+        if(contents.empty())
+            cache.erase(key);
+        else
+            cache.insert_or_assign(key, CacheItem{file_lines, contents});
+    }
+
+    file_state.size = offset;
+    file_tail       = ReadTail(file, offset);
+}
 
+void RamDb::UpdateFileStateUnsafe(std::istream& file)
+{
+    // Own changes are already in the cache, so only the position in the file has to be updated.
+    file_state = GetDbFileState(GetFileName());
+    file_tail  = file_state.size < 0 ? std::string{} : ReadTail(file, file_state.size);
+}
+
+#if MIOPEN_DB_CACHE_WRITE_THROUGH
+void RamDb::UpdateCacheEntryUnsafe(const DbRecord& record, bool is_valid)
+{
     if(is_valid)
     {
         const auto& key = record.GetKey();
         const auto it   = cache.find(key);
-        auto ss         = std::ostringstream{};
-        record.WriteIdsAndValues(ss);
+        auto contents   = GetCacheContents(record);
 
         if(it != cache.end())
         {
             auto& item   = it->second;
-            item.content = ss.str();
+            item.content = std::move(contents);
         }
         else
         {
-            cache.emplace(key, CacheItem{-1, ss.str()});
+            cache.emplace(key, CacheItem{-1, std::move(contents)});
         }
         file_read_time = ramdb_clock::now();
+        PublishUnsafe(key);
+        if(!DisableUserDbFileIO)
+        {
+            auto file = std::ifstream{GetFileName()};
+            UpdateFileStateUnsafe(file);
+        }
     }
 }
 #endif
@@ -0,0 +1,642 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/readonlymappeddb.hpp>
+#include <miopen/cached_instances.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/xxhash.hpp>
+
+#if MIOPEN_EMBED_DB
+#include <miopen_data.hpp>
+#endif
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <tuple>
+
+#include <unistd.h>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_DB_SHARED_MEMORY)
+
+namespace miopen {
+
+namespace debug {
+boost::optional<bool>& find_db_shared_memory_override()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static boost::optional<bool> data = boost::none;
+    return data;
+}
+} // namespace debug
+
+namespace {
+
+constexpr char ImageMagic[8]        = {'M', 'I', 'O', 'F', 'D', 'B', 'I', 'M'};
+constexpr std::uint32_t ImageVersion = 4;
+constexpr char SharedImageMagic[8]  = {'M', 'I', 'O', 'F', 'D', 'B', 'S', 'H'};
+
+/// Precedes the image in a shared memory segment. The segment is found by the path of the text
+/// db, so it has to tell which version of the text db the image has been built from. The magic
+/// is written last, so a segment left by a crashed process is never used.
+struct SharedImageHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t publisher; ///< Process id.
+    std::uint64_t source_size;
+    std::int64_t source_time;
+    std::uint64_t image_size;
+};
+
+/// Returns the XXH3-64 of the contents of the file, or boost::none if it can't be read.
+boost::optional<std::uint64_t> HashFile(const std::string& path)
+{
+    namespace ipc = boost::interprocess;
+
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(path, ec);
+    if(ec)
+        return boost::none;
+    if(size == 0)
+        return xxh3_64(nullptr, 0);
+
+    try
+    {
+        const auto file   = ipc::file_mapping{path.c_str(), ipc::read_only};
+        const auto region = ipc::mapped_region{file, ipc::read_only};
+        return xxh3_64(region.get_address(), region.get_size());
+    }
+    catch(const ipc::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map " << path << ": " << ex.what());
+        return boost::none;
+    }
+}
+
+struct TextRecord
+{
+    std::string key;
+    std::string content;
+    int line;
+};
+
+} // namespace
+
+ReadonlyMappedDb& ReadonlyMappedDb::GetCached(const std::string& path, bool warn_if_unreadable)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = CachedInstances<ReadonlyMappedDb>{};
+    return instances.Get(path, [&]() {
+        // Same lifetime considerations as for ReadonlyRamDb::GetCached() apply here.
+        // The mapping is released altogether with the process.
+        auto instance = new ReadonlyMappedDb{path};
+        instance->Prefetch(warn_if_unreadable);
+        return instance;
+    });
+}
+
+bool ReadonlyMappedDb::IsSharedMemoryEnabled()
+{
+    if(debug::find_db_shared_memory_override())
+        return *debug::find_db_shared_memory_override();
+    return miopen::IsEnabled(MIOPEN_FIND_DB_SHARED_MEMORY{});
+}
+
+std::string ReadonlyMappedDb::GetSharedMemoryName(const std::string& path)
+{
+    return "miopen-find-db-" + xxhash64(path);
+}
+
+std::string ReadonlyMappedDb::GetImagePath(const std::string& path)
+{
+    const std::string text_ext = ".txt";
+    if(path.size() > text_ext.size() &&
+       path.compare(path.size() - text_ext.size(), text_ext.size(), text_ext) == 0)
+        return path.substr(0, path.size() - text_ext.size()) + ".bin";
+    return path + ".bin";
+}
+
+template <class TFunc>
+static void Measure(const std::string& funcName, TFunc&& func)
+{
+    if(!miopen::IsLogging(LoggingLevel::Info))
+    {
+        func();
+        return;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    func();
+    const auto end = std::chrono::high_resolution_clock::now();
+    MIOPEN_LOG_I("ReadonlyMappedDb::" << funcName << " time: " << (end - start).count() * .000001f
+                                      << " ms");
+}
+
+void ReadonlyMappedDb::BuildImage(std::istream& input_stream,
+                                  std::uint64_t source_size,
+                                  std::int64_t source_time,
+                                  std::uint64_t source_hash,
+                                  std::vector<char>& image,
+                                  const std::string& db_path)
+{
+    auto records = std::vector<TextRecord>{};
+    auto line    = std::string{};
+    auto n_line  = 0;
+
+    while(std::getline(input_stream, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+
+        if(!is_key)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << db_path << "#" << n_line);
+            continue;
+        }
+
+        records.push_back({line.substr(0, key_size), line.substr(key_size + 1), n_line});
+    }
+
+    // The first record wins in case of duplicate keys, same as in ReadonlyRamDb.
+    std::stable_sort(records.begin(), records.end(), [](const auto& left, const auto& right) {
+        return left.key < right.key;
+    });
+    records.erase(std::unique(records.begin(),
+                              records.end(),
+                              [](const auto& left, const auto& right) {
+                                  return left.key == right.key;
+                              }),
+                  records.end());
+
+    auto header = Header{};
+    std::copy(std::begin(ImageMagic), std::end(ImageMagic), std::begin(header.magic));
+    header.version      = ImageVersion;
+    header.entry_size   = sizeof(Entry);
+    header.record_count = records.size();
+    header.source_size  = source_size;
+    header.source_time  = source_time;
+    header.source_hash  = source_hash;
+    header.index_offset = sizeof(Header);
+    header.arena_offset = header.index_offset + records.size() * sizeof(Entry);
+    header.arena_size   = 0;
+
+    auto entries = std::vector<Entry>{};
+    entries.reserve(records.size());
+
+    for(const auto& record : records)
+    {
+        auto entry           = Entry{};
+        entry.key_offset     = header.arena_size;
+        entry.key_size       = static_cast<std::uint32_t>(record.key.size());
+        entry.content_offset = entry.key_offset + entry.key_size;
+        entry.content_size   = static_cast<std::uint32_t>(record.content.size());
+        entry.line           = static_cast<std::uint32_t>(record.line);
+        entry.reserved       = 0;
+        header.arena_size    = entry.content_offset + entry.content_size;
+        entries.push_back(entry);
+    }
+
+    image.clear();
+    image.resize(header.arena_offset + header.arena_size);
+
+    std::memcpy(image.data(), &header, sizeof(Header));
+    if(!entries.empty())
+        std::memcpy(image.data() + header.index_offset,
+                    entries.data(),
+                    entries.size() * sizeof(Entry));
+
+    auto arena = image.data() + header.arena_offset;
+    for(auto i = 0u; i < records.size(); ++i)
+    {
+        std::copy(records[i].key.begin(), records[i].key.end(), arena + entries[i].key_offset);
+        std::copy(records[i].content.begin(),
+                  records[i].content.end(),
+                  arena + entries[i].content_offset);
+    }
+}
+
+bool ReadonlyMappedDb::ConvertTextDb(const std::string& text_path, const std::string& image_path)
+{
+    auto input_stream = std::ifstream{text_path};
+
+    if(!input_stream)
+    {
+        MIOPEN_LOG_E("File is unreadable: " << text_path);
+        return false;
+    }
+
+    const auto source_hash = HashFile(text_path);
+    if(!source_hash)
+    {
+        MIOPEN_LOG_E("File is unreadable: " << text_path);
+        return false;
+    }
+
+    auto image = std::vector<char>{};
+    BuildImage(input_stream,
+               boost::filesystem::file_size(text_path),
+               boost::filesystem::last_write_time(text_path),
+               *source_hash,
+               image,
+               text_path);
+
+    const auto temp_path = image_path + ".temp";
+    {
+        auto output_stream = std::ofstream{temp_path, std::ios::binary | std::ios::trunc};
+        if(!output_stream)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << temp_path);
+            return false;
+        }
+
+        output_stream.write(image.data(), image.size());
+        if(!output_stream)
+        {
+            MIOPEN_LOG_E("Failed to write: " << temp_path);
+            return false;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp_path, image_path, ec);
+    if(ec)
+    {
+        MIOPEN_LOG_E("Failed to rename " << temp_path << " to " << image_path << ": "
+                                         << ec.message());
+        return false;
+    }
+    return true;
+}
+
+bool ReadonlyMappedDb::Attach(const char* data,
+                              std::size_t size,
+                              std::uint64_t source_size,
+                              std::int64_t source_time)
+{
+    if(size < sizeof(Header))
+        return false;
+
+    const auto image_header = reinterpret_cast<const Header*>(data);
+
+    if(!std::equal(std::begin(ImageMagic), std::end(ImageMagic), std::begin(image_header->magic)))
+    {
+        MIOPEN_LOG_W("Not a find-db image: " << db_path);
+        return false;
+    }
+
+    if(image_header->version != ImageVersion || image_header->entry_size != sizeof(Entry))
+    {
+        MIOPEN_LOG_W("Unsupported find-db image version " << image_header->version << ": "
+                                                          << db_path);
+        return false;
+    }
+
+    // The modification time only saves hashing the text db. Copies of the text db, such as the
+    // one in the build tree or the installed one, get their own modification times, so the
+    // contents decide whether the image is up to date.
+    if(source_size != 0 &&
+       (image_header->source_size != source_size ||
+        (image_header->source_time != source_time &&
+         HashFile(db_path) != boost::optional<std::uint64_t>{image_header->source_hash})))
+    {
+        MIOPEN_LOG_I("Find-db image is stale: " << db_path);
+        return false;
+    }
+
+    const auto count = image_header->record_count;
+    if(image_header->index_offset % alignof(Entry) != 0 || image_header->index_offset > size ||
+       count > (size - image_header->index_offset) / sizeof(Entry) ||
+       image_header->arena_offset > size ||
+       image_header->arena_size > size - image_header->arena_offset)
+    {
+        MIOPEN_LOG_W("Find-db image is truncated or corrupt: " << db_path);
+        return false;
+    }
+
+    header = image_header;
+    index  = reinterpret_cast<const Entry*>(data + header->index_offset);
+    arena  = data + header->arena_offset;
+    return true;
+}
+
+bool ReadonlyMappedDb::Map(const std::string& image_path,
+                           std::uint64_t source_size,
+                           std::int64_t source_time)
+{
+    namespace ipc = boost::interprocess;
+
+    try
+    {
+        file   = ipc::file_mapping{image_path.c_str(), ipc::read_only};
+        region = ipc::mapped_region{file, ipc::read_only};
+    }
+    catch(const ipc::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map " << image_path << ": " << ex.what());
+        return false;
+    }
+
+    if(!Attach(static_cast<const char*>(region.get_address()),
+               region.get_size(),
+               source_size,
+               source_time))
+    {
+        region = ipc::mapped_region{};
+        file   = ipc::file_mapping{};
+        return false;
+    }
+
+    region.advise(ipc::mapped_region::advice_random);
+    return true;
+}
+
+bool ReadonlyMappedDb::MapShared(std::uint64_t source_size, std::int64_t source_time)
+{
+    const auto name = GetSharedMemoryName(db_path);
+
+    try
+    {
+        auto& lock_file     = LockFile::Get(LockFilePath(db_path + ".shm").c_str());
+        const auto timeout = std::chrono::seconds{60};
+
+        {
+            const auto lock = std::shared_lock<LockFile>(lock_file, timeout);
+            if(lock && OpenShared(name, source_size, source_time))
+                return true;
+        }
+
+        const auto lock = std::unique_lock<LockFile>(lock_file, timeout);
+        if(!lock)
+        {
+            MIOPEN_LOG_W("Unable to lock the shared find-db image: " << name);
+            return false;
+        }
+
+        // Someone else may have published it before the lock has been taken.
+        if(OpenShared(name, source_size, source_time))
+            return true;
+
+        return PublishShared(name, source_size, source_time) &&
+               OpenShared(name, source_size, source_time);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to share find-db image " << name << ": " << ex.what());
+        region        = {};
+        shared_memory = {};
+        return false;
+    }
+}
+
+bool ReadonlyMappedDb::OpenShared(const std::string& name,
+                                  std::uint64_t source_size,
+                                  std::int64_t source_time)
+{
+    namespace ipc = boost::interprocess;
+
+    try
+    {
+        shared_memory = ipc::shared_memory_object{ipc::open_only, name.c_str(), ipc::read_only};
+    }
+    catch(const ipc::interprocess_exception&)
+    {
+        // Has not been published yet.
+        return false;
+    }
+
+    region = ipc::mapped_region{shared_memory, ipc::read_only};
+
+    const auto data        = static_cast<const char*>(region.get_address());
+    const auto size        = region.get_size();
+    auto segment_header    = SharedImageHeader{};
+    const auto is_complete = size >= sizeof(SharedImageHeader);
+
+    if(is_complete)
+        std::memcpy(&segment_header, data, sizeof(SharedImageHeader));
+
+    if(!is_complete ||
+       !std::equal(std::begin(SharedImageMagic),
+                   std::end(SharedImageMagic),
+                   std::begin(segment_header.magic)) ||
+       segment_header.version != ImageVersion || segment_header.source_size != source_size ||
+       segment_header.source_time != source_time ||
+       segment_header.image_size > size - sizeof(SharedImageHeader) ||
+       !Attach(data + sizeof(SharedImageHeader),
+               segment_header.image_size,
+               source_size,
+               source_time))
+    {
+        MIOPEN_LOG_I("Shared find-db image is stale or incomplete: " << name);
+        region        = {};
+        shared_memory = {};
+        return false;
+    }
+
+    shared           = true;
+    shared_publisher = segment_header.publisher;
+    return true;
+}
+
+bool ReadonlyMappedDb::PublishShared(const std::string& name,
+                                     std::uint64_t source_size,
+                                     std::int64_t source_time) const
+{
+    namespace ipc = boost::interprocess;
+
+    auto input_stream = std::ifstream{db_path};
+    if(!input_stream)
+        return false;
+
+    auto image = std::vector<char>{};
+    BuildImage(input_stream, source_size, source_time, 0, image, db_path);
+
+    // Processes which have mapped the stale segment keep using it until they exit.
+    ipc::shared_memory_object::remove(name.c_str());
+
+    auto segment = ipc::shared_memory_object{ipc::create_only, name.c_str(), ipc::read_write};
+    segment.truncate(sizeof(SharedImageHeader) + image.size());
+    const auto writable = ipc::mapped_region{segment, ipc::read_write};
+    const auto data     = static_cast<char*>(writable.get_address());
+
+    auto segment_header        = SharedImageHeader{};
+    segment_header.version     = ImageVersion;
+    segment_header.publisher   = ::getpid();
+    segment_header.source_size = source_size;
+    segment_header.source_time = source_time;
+    segment_header.image_size  = image.size();
+    std::memcpy(data, &segment_header, sizeof(SharedImageHeader));
+    std::copy(image.begin(), image.end(), data + sizeof(SharedImageHeader));
+    std::copy(std::begin(SharedImageMagic), std::end(SharedImageMagic), data);
+
+    MIOPEN_LOG_I("Published find-db image in shared memory: " << name);
+    return true;
+}
+
+void ReadonlyMappedDb::Prefetch(bool warn_if_unreadable)
+{
+    Measure("Prefetch", [this, warn_if_unreadable]() {
+        if(db_path.empty())
+            return;
+
+        constexpr bool isEmbedded = MIOPEN_EMBED_DB;
+        // cppcheck-suppress knownConditionTrueFalse
+        if(!debug::rordb_embed_fs_override() && isEmbedded)
+        {
+#if MIOPEN_EMBED_DB
+            boost::filesystem::path filepath(db_path);
+            const auto& it_p = miopen_data().find(filepath.filename().string() + ".o");
+            if(it_p == miopen_data().end())
+                MIOPEN_THROW(miopenStatusInternalError,
+                             "Unknown database: " + filepath.filename().string() +
+                                 " in internal filesystem");
+
+            const auto& p = it_p->second;
+            ptrdiff_t sz  = p.second - p.first;
+            MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
+            auto input_stream = std::stringstream(std::string(p.first, sz));
+            BuildImage(input_stream, 0, 0, 0, storage, db_path);
+            Attach(storage.data(), storage.size(), 0, 0);
+#endif
+            return;
+        }
+
+        // A missing text db does not make the image stale: installations may ship images only.
+        boost::system::error_code size_ec;
+        boost::system::error_code exists_ec;
+        boost::system::error_code time_ec;
+        const auto source_size = boost::filesystem::file_size(db_path, size_ec);
+        const auto source_time = boost::filesystem::last_write_time(db_path, time_ec);
+        const auto image_path  = GetImagePath(db_path);
+
+        if(boost::filesystem::exists(image_path, exists_ec) &&
+           Map(image_path, size_ec || time_ec ? 0 : source_size, source_time))
+        {
+            MIOPEN_LOG_I2("Mapped find-db image: " << image_path);
+            return;
+        }
+
+        if(!size_ec && !time_ec && IsSharedMemoryEnabled() && MapShared(source_size, source_time))
+        {
+            MIOPEN_LOG_I2("Mapped shared find-db image: " << GetSharedMemoryName(db_path));
+            return;
+        }
+
+        auto input_stream = std::ifstream{db_path};
+        if(!input_stream)
+        {
+            const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                       ? LoggingLevel::Warning
+                                       : LoggingLevel::Info;
+            MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
+            return;
+        }
+
+        MIOPEN_LOG_I("Find-db image is not available, building it in memory: " << image_path);
+        BuildImage(input_stream, 0, 0, 0, storage, db_path);
+        Attach(storage.data(), storage.size(), 0, 0);
+    });
+}
+
+std::size_t ReadonlyMappedDb::GetSize() const
+{
+    return header != nullptr ? header->record_count : 0;
+}
+
+void ReadonlyMappedDb::VisitKeys(const std::function<void(std::string_view)>& visitor) const
+{
+    for(std::size_t i = 0; i < GetSize(); ++i)
+        visitor(GetKey(index[i]));
+}
+
+std::string_view ReadonlyMappedDb::GetKey(const Entry& entry) const
+{
+    if(entry.key_offset > header->arena_size ||
+       entry.key_size > header->arena_size - entry.key_offset)
+        return {};
+    return {arena + entry.key_offset, entry.key_size};
+}
+
+std::string_view ReadonlyMappedDb::GetContent(const Entry& entry) const
+{
+    if(entry.content_offset > header->arena_size ||
+       entry.content_size > header->arena_size - entry.content_offset)
+        return {};
+    return {arena + entry.content_offset, entry.content_size};
+}
+
+boost::optional<DbRecord> ReadonlyMappedDb::FindRecord(const std::string& problem) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+
+    if(header == nullptr)
+        return boost::none;
+
+    const auto key   = std::string_view{problem};
+    const auto begin = index;
+    const auto end   = index + header->record_count;
+    const auto it    = std::lower_bound(
+        begin, end, key, [this](const Entry& entry, std::string_view value) {
+            return GetKey(entry) < value;
+        });
+
+    if(it == end || GetKey(*it) != key)
+        return boost::none;
+
+    const auto content = GetContent(*it);
+    auto record        = DbRecord{problem};
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+    MIOPEN_LOG_I2("Contents found: " << content);
+
+    if(!record.ParseContents(content))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: "
+                     << problem << " form file " << db_path << "#" << it->line);
+        MIOPEN_LOG_E("Contents: " << content);
+        return boost::none;
+    }
+
+    return record;
+}
+
+} // namespace miopen
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/cached_instances.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
 
@@ -35,10 +36,10 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <algorithm>
 #include <fstream>
-#include <mutex>
-#include <sstream>
-#include <map>
+#include <memory>
+#include <string_view>
 
 namespace miopen {
 
@@ -54,27 +55,89 @@ bool& rordb_embed_fs_override()
 ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path, bool warn_if_unreadable)
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    const std::lock_guard<std::mutex> lock{mutex};
+    static auto instances = CachedInstances<ReadonlyRamDb>{};
+    return instances.Get(path, [&]() {
+        // The ReadonlyRamDb objects allocated here by "new" shall be alive during
+        // the calling app lifetime. Size of each is very small, and there couldn't
+        // be many of them (max number is number of _different_ GPU board installed
+        // in the user's system, which is _one_ for now). Therefore the total
+        // footprint in heap is very small. That is why we can omit deletion of
+        // these objects thus avoiding bothering with MP/MT syncronization.
+        // These will be destroyed altogether with heap.
+        auto instance = new ReadonlyRamDb{path};
+        instance->Prefetch(warn_if_unreadable);
+        return instance;
+    });
+}
 
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto instances = std::map<std::string, ReadonlyRamDb*>{};
-    const auto it         = instances.find(path);
-
-    if(it != instances.end())
-        return *it->second;
-
-    // The ReadonlyRamDb objects allocated here by "new" shall be alive during
-    // the calling app lifetime. Size of each is very small, and there couldn't
-    // be many of them (max number is number of _different_ GPU board installed
-    // in the user's system, which is _one_ for now). Therefore the total
-    // footprint in heap is very small. That is why we can omit deletion of
-    // these objects thus avoiding bothering with MP/MT syncronization.
-    // These will be destroyed altogether with heap.
-    auto instance = new ReadonlyRamDb{path};
-    instances.emplace(path, instance);
-    instance->Prefetch(warn_if_unreadable);
-    return *instance;
+const DbRecord* ReadonlyRamDb::GetRecord(const std::string& problem) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+    const auto it = cache.find(problem);
+
+    if(it == cache.end())
+        return nullptr;
+
+    return GetRecord(problem, it->second);
+}
+
+const DbRecord* ReadonlyRamDb::GetRecord(const std::string& problem, const CacheItem& item) const
+{
+    const auto parsed = item.record.load(std::memory_order_acquire);
+
+    if(parsed != nullptr)
+    {
+        MIOPEN_LOG_I2("Key match (parsed): " << problem);
+        return parsed;
+    }
+
+    auto record = DbRecord{problem};
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+    MIOPEN_LOG_I2("Contents found: " << item.content);
+
+    if(!record.ParseContents(item.content))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: "
+                     << problem << " form file " << db_path << "#" << item.line);
+        MIOPEN_LOG_E("Contents: " << item.content);
+        return nullptr;
+    }
+
+    // Concurrent first lookups may parse the same payload twice, which is harmless:
+    // the results are identical and the first one published is kept.
+    auto owned     = std::make_unique<const DbRecord>(std::move(record));
+    auto published = static_cast<const DbRecord*>(nullptr);
+    if(item.record.compare_exchange_strong(
+           published, owned.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+        return owned.release();
+    return published;
+}
+
+const FindDbValues* ReadonlyRamDb::FindDecodedRecord(const std::string& problem) const
+{
+    const auto it = cache.find(problem);
+
+    if(it == cache.end())
+        return nullptr;
+
+    const auto& item    = it->second;
+    const auto existing = item.find_db_values.load(std::memory_order_acquire);
+
+    if(existing != nullptr)
+        return existing;
+
+    const auto record = GetRecord(problem, item);
+    if(record == nullptr)
+        return nullptr;
+
+    // Same as for the records, the first values published are kept.
+    auto owned     = std::make_unique<const FindDbValues>(record->Decode<FindDbData>());
+    auto published = static_cast<const FindDbValues*>(nullptr);
+    if(item.find_db_values.compare_exchange_strong(
+           published, owned.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+        return owned.release();
+    return published;
 }
 
 template <class TFunc>
@@ -90,28 +153,24 @@ static auto Measure(const std::string& funcName, TFunc&& func)
                                    << " ms");
 }
 
-void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable)
+void ReadonlyRamDb::ParseAndLoadDb(std::string_view data)
 {
-    if(!input_stream)
-    {
-        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
-                                                                             : LoggingLevel::Info;
-        MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
-        return;
-    }
-
-    auto line   = std::string{};
     auto n_line = 0;
+    cache.reserve(std::count(data.begin(), data.end(), '\n') + 1);
 
-    while(std::getline(input_stream, line))
+    while(!data.empty())
     {
         ++n_line;
 
+        const auto line_size = data.find('\n');
+        const auto line      = data.substr(0, line_size);
+        data.remove_prefix(line_size == std::string_view::npos ? data.size() : line_size + 1);
+
         if(line.empty())
             continue;
 
         const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+        const bool is_key   = (key_size != std::string_view::npos && key_size != 0);
 
         if(!is_key)
         {
@@ -119,10 +178,9 @@ void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream, bool warn_if_unre
             continue;
         }
 
-        const auto key      = line.substr(0, key_size);
-        const auto contents = line.substr(key_size + 1);
-
-        cache.emplace(key, CacheItem{n_line, contents});
+        cache.emplace(std::piecewise_construct,
+                      std::forward_as_tuple(line.substr(0, key_size)),
+                      std::forward_as_tuple(n_line, line.substr(key_size + 1)));
     }
 }
 
@@ -146,14 +204,31 @@ void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
             const auto& p = it_p->second;
             ptrdiff_t sz  = p.second - p.first;
             MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
-            auto input_stream = std::stringstream(std::string(p.first, sz));
-            ParseAndLoadDb(input_stream, warn_if_unreadable);
+            // The embedded data lives as long as the process, so it is indexed in place.
+            ParseAndLoadDb({p.first, static_cast<std::size_t>(sz)});
 #endif
         }
         else
         {
-            auto input_stream = std::ifstream{db_path};
-            ParseAndLoadDb(input_stream, warn_if_unreadable);
+            auto file = std::ifstream{db_path, std::ios::binary | std::ios::ate};
+            if(!file)
+            {
+                const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                           ? LoggingLevel::Warning
+                                           : LoggingLevel::Info;
+                MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
+                return;
+            }
+
+            storage.resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0);
+            if(!file.read(storage.data(), storage.size()))
+            {
+                MIOPEN_LOG_E("Unable to read " << db_path);
+                storage.clear();
+                return;
+            }
+            ParseAndLoadDb({storage.data(), storage.size()});
         }
     });
 }
@@ -57,6 +57,8 @@ int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_r
 }
 namespace miopen {
 
+using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+
 class SQLite::impl
 {
     struct SQLiteCloser
@@ -192,6 +194,48 @@ public:
 
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+
+    // Declared after the connection, as prepared statements have to be finalized before it is
+    // closed.
+    std::mutex statementsMutex;
+    std::unordered_multimap<std::string, sqlite3_stmt_ptr> statements;
+
+    struct BatchState
+    {
+        int depth = 0;
+        std::vector<std::pair<std::string, std::vector<std::string>>> queue;
+    };
+
+    std::mutex batchMutex;
+    std::mutex flushMutex;
+    /// Keyed by the thread which queues the statements, so that a batch of one thread does not
+    /// hold back the changes of the others.
+    std::unordered_map<std::thread::id, BatchState> batches;
+
+    sqlite3_stmt_ptr AcquireStatement(const std::string& query)
+    {
+        const std::lock_guard<std::mutex> lock{statementsMutex};
+        const auto it = statements.find(query);
+        if(it == statements.end())
+            return nullptr;
+        auto ret = std::move(it->second);
+        statements.erase(it);
+        return ret;
+    }
+
+    void ReleaseStatement(const std::string& query, sqlite3_stmt_ptr stmt)
+    {
+        // Statements are cached by the shape of the query, so the limit is only reached
+        // if many threads use the same connection at once.
+        constexpr std::size_t max_statements = 64;
+
+        sqlite3_reset(stmt.get());
+        sqlite3_clear_bindings(stmt.get());
+
+        const std::lock_guard<std::mutex> lock{statementsMutex};
+        if(statements.size() < max_statements)
+            statements.emplace(query, std::move(stmt));
+    }
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -285,9 +329,14 @@ bool SQLite::Valid() const { return pImpl->isValid; }
 
 class SQLite::Statement::impl
 {
-    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+    SQLite::impl* owner = nullptr;
+    std::string query;
+
     sqlite3_stmt_ptr Prepare(const SQLite& sql, const std::string& query)
     {
+        if(auto cached = sql.pImpl->AcquireStatement(query))
+            return cached;
+
         sqlite3_stmt* ptr = nullptr;
         MIOPEN_LOG_I2(query);
         auto rc =
@@ -301,8 +350,12 @@ class SQLite::Statement::impl
     }
 
 public:
-    impl(const SQLite& sql, const std::string& query) { ptrStmt = Prepare(sql, query); }
-    impl(const SQLite& sql, const std::string& query, const std::vector<std::string>& vals)
+    impl(const SQLite& sql, const std::string& query_) : owner(sql.pImpl.get()), query(query_)
+    {
+        ptrStmt = Prepare(sql, query);
+    }
+    impl(const SQLite& sql, const std::string& query_, const std::vector<std::string>& vals)
+        : owner(sql.pImpl.get()), query(query_)
     {
         ptrStmt = Prepare(sql, query);
         int cnt = 1;
@@ -316,6 +369,15 @@ public:
         MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
     }
 
+    ~impl()
+    {
+        if(ptrStmt)
+            owner->ReleaseStatement(query, std::move(ptrStmt));
+    }
+
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
     sqlite3_stmt_ptr ptrStmt = nullptr;
 };
 
@@ -379,6 +441,135 @@ int SQLite::Statement::BindInt64(int idx, const int64_t num)
     return 0;
 }
 
+SQLite::Batch::Batch(const SQLite& sql_) : sql(&sql_), owner(std::this_thread::get_id())
+{
+    const std::lock_guard<std::mutex> lock{sql->pImpl->batchMutex};
+    ++sql->pImpl->batches[owner].depth;
+}
+
+SQLite::Batch::~Batch()
+{
+    if(sql == nullptr)
+        return;
+
+    {
+        const std::lock_guard<std::mutex> lock{sql->pImpl->batchMutex};
+        if(--sql->pImpl->batches[owner].depth > 0)
+            return;
+    }
+
+    try
+    {
+        if(!sql->Flush(owner))
+            MIOPEN_LOG_E("Failed to commit a batch of database changes");
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Failed to commit a batch of database changes: " << ex.what());
+    }
+    catch(...)
+    {
+        MIOPEN_LOG_E("Failed to commit a batch of database changes: unknown error");
+    }
+}
+
+bool SQLite::InBatch() const
+{
+    const std::lock_guard<std::mutex> lock{pImpl->batchMutex};
+    const auto it = pImpl->batches.find(std::this_thread::get_id());
+    return it != pImpl->batches.end() && it->second.depth > 0;
+}
+
+void SQLite::Queue(std::string query, std::vector<std::string> vals) const
+{
+    const std::lock_guard<std::mutex> lock{pImpl->batchMutex};
+    pImpl->batches[std::this_thread::get_id()].queue.emplace_back(std::move(query),
+                                                                  std::move(vals));
+}
+
+bool SQLite::Flush() const { return Flush(std::this_thread::get_id()); }
+
+bool SQLite::Flush(std::thread::id thread) const
+{
+    // Only one transaction can be open on a connection.
+    const std::lock_guard<std::mutex> flush_lock{pImpl->flushMutex};
+
+    {
+        const std::lock_guard<std::mutex> lock{pImpl->batchMutex};
+        const auto it = pImpl->batches.find(thread);
+        if(it == pImpl->batches.end())
+            return true;
+        if(it->second.queue.empty())
+        {
+            if(it->second.depth == 0)
+                pImpl->batches.erase(it);
+            return true;
+        }
+    }
+
+    // The statements stay queued if the transaction cannot be started, e.g. when the db is busy
+    // for longer than the retries last, so the next flush commits them.
+    try
+    {
+        Exec("BEGIN IMMEDIATE;");
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Failed to begin a transaction, the statements stay queued: " << ex.what());
+        return false;
+    }
+
+    auto queue = decltype(impl::BatchState::queue){};
+    {
+        const std::lock_guard<std::mutex> lock{pImpl->batchMutex};
+        const auto it = pImpl->batches.find(thread);
+        queue.swap(it->second.queue);
+        if(it->second.depth == 0)
+            pImpl->batches.erase(it);
+    }
+
+    MIOPEN_LOG_I2("Committing " << queue.size() << " statements");
+
+    try
+    {
+        for(const auto& item : queue)
+        {
+            auto stmt = Statement{*this, item.first, item.second};
+            if(stmt.Step(*this) != SQLITE_DONE)
+            {
+                MIOPEN_LOG_E("Failed to execute a batched statement, dropping "
+                             << queue.size() << " statements: " << ErrorMessage());
+                Exec("ROLLBACK;");
+                return false;
+            }
+        }
+    }
+    catch(...)
+    {
+        Exec("ROLLBACK;");
+        throw;
+    }
+
+    try
+    {
+        Exec("COMMIT;");
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Failed to commit " << queue.size() << " statements: " << ex.what());
+        try
+        {
+            Exec("ROLLBACK;");
+        }
+        catch(const std::exception&)
+        {
+            // The transaction is rolled back when the connection is closed.
+        }
+        return false;
+    }
+    return true;
+}
+
 SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system_)
     : SQLiteBase(filename_, is_system_)
 {
@@ -442,6 +633,8 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system_)
                 sql.Exec(create_perfdb_sql);
             }
         }
+        // Lookups by config, also added to the dbs created before it was introduced.
+        sql.Exec("CREATE INDEX IF NOT EXISTS `idx_perf_db_config` ON perf_db(config);");
         MIOPEN_LOG_T("Database created successfully");
     }
     // Check fields for the tables
@@ -461,5 +654,25 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system_)
             dbInvalid = true;
         }
     }
+
+    if(is_system && !dbInvalid)
+    {
+        // One index lookup per solver instead of a scan of the whole table.
+        const auto query = "SELECT solver FROM perf_db WHERE solver > ? ORDER BY solver LIMIT 1;";
+        auto last        = std::string{};
+
+        while(true)
+        {
+            auto stmt = SQLite::Statement{sql, query, {last}};
+            if(stmt.Step(sql) != SQLITE_ROW)
+                break;
+            last = stmt.ColumnText(0);
+            solvers.push_back(last);
+        }
+
+        const auto tokens    = std::vector<std::string>(solvers.size(), "?");
+        solvers_placeholders = JoinStrings(tokens, ",");
+        MIOPEN_LOG_I2(solvers.size() << " solvers found in " << filename);
+    }
 }
 } // namespace miopen
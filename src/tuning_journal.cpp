@@ -0,0 +1,298 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tuning_journal.hpp>
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/generic_search_controls.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/xxhash.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace miopen {
+namespace solver {
+
+static boost::optional<TuningJournal::Entry> ParseEntry(const std::string& line)
+{
+    const auto separator = line.rfind(';');
+    if(separator == std::string::npos || separator == 0)
+        return boost::none;
+    auto entry          = TuningJournal::Entry{};
+    entry.config        = line.substr(0, separator);
+    const auto time_str = line.substr(separator + 1);
+    if(time_str == "failed")
+        return entry;
+    std::istringstream ss{time_str};
+    auto time = 0.0f;
+    if(!(ss >> time) || !ss.eof() || time < 0.0f)
+        return boost::none;
+    entry.time = time;
+    return entry;
+}
+
+TuningJournal::TuningJournal(boost::filesystem::path path_, std::string key_)
+    : path(std::move(path_)), key(std::move(key_))
+{
+    auto in = std::ifstream{path.string(), std::ios::binary};
+    if(!in)
+        return;
+    const auto contents =
+        std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+    auto begin = contents.find('\n');
+    if(contents.empty())
+        return;
+    if(begin == std::string::npos || contents.compare(0, begin, key) != 0)
+    {
+        MIOPEN_LOG_W("Tuning journal " << path << " belongs to another search, ignored");
+        return;
+    }
+    loaded        = true;
+    complete_size = contents.rfind('\n') + 1;
+    terminated    = complete_size == contents.size();
+
+    // The last line may have been cut off by a kill.
+    for(auto end = contents.find('\n', ++begin); end != std::string::npos;
+        begin = end + 1, end = contents.find('\n', begin))
+    {
+        const auto line  = contents.substr(begin, end - begin);
+        const auto entry = ParseEntry(line);
+        if(entry)
+            entries.push_back(*entry);
+        else
+            MIOPEN_LOG_W("Invalid line in tuning journal " << path << ": " << line);
+    }
+}
+
+void TuningJournal::Append(const std::string& config, boost::optional<float> time)
+{
+    if(!IsEnabled())
+        return;
+
+    auto line = std::ostringstream{};
+    if(!file.is_open())
+    {
+        const auto directory = path.parent_path();
+        auto ec              = boost::system::error_code{};
+        if(!boost::filesystem::exists(directory) &&
+           !boost::filesystem::create_directories(directory, ec))
+        {
+            MIOPEN_LOG_W("Unable to create a directory: " << directory);
+        }
+        // The cut off line is dropped rather than completed with the next entry.
+        if(loaded && !terminated)
+        {
+            auto ec = boost::system::error_code{};
+            boost::filesystem::resize_file(path, complete_size, ec);
+        }
+        file.open(path.string(), loaded ? std::ios::app : std::ios::trunc);
+        if(!file)
+        {
+            MIOPEN_LOG_W("Unable to open tuning journal " << path);
+            path.clear();
+            return;
+        }
+        if(!loaded)
+            line << key << '\n';
+        loaded = true;
+    }
+
+    line.precision(std::numeric_limits<float>::max_digits10);
+    line << config << ';';
+    if(time)
+        line << *time;
+    else
+        line << "failed";
+    line << '\n';
+
+    // One write per entry, so the entries of concurrent searches do not interleave.
+    const auto str = line.str();
+    file.write(str.data(), str.size());
+    file.flush();
+    if(!file)
+        MIOPEN_LOG_W("Unable to write tuning journal " << path);
+}
+
+void TuningJournal::Remove()
+{
+    if(!IsEnabled())
+        return;
+    file.close();
+    auto ec = boost::system::error_code{};
+    boost::filesystem::remove(path, ec);
+    if(ec)
+        MIOPEN_LOG_W("Unable to remove tuning journal " << path << ": " << ec.message());
+    entries.clear();
+    loaded = false;
+}
+
+boost::optional<TuningShard> ParseTuningShard(const std::string& value)
+{
+    const auto separator = value.find('/');
+    auto shard           = TuningShard{};
+    try
+    {
+        if(separator == std::string::npos)
+            throw std::invalid_argument{value};
+        const auto index = value.substr(0, separator);
+        shard.merge      = index == "merge";
+        auto parsed      = std::size_t{0};
+        if(!shard.merge)
+        {
+            shard.index = std::stoul(index, &parsed);
+            if(parsed != index.size())
+                throw std::invalid_argument{value};
+        }
+        const auto count = value.substr(separator + 1);
+        shard.count      = std::stoul(count, &parsed);
+        if(parsed != count.size() || shard.count == 0 || shard.index >= shard.count)
+            throw std::invalid_argument{value};
+    }
+    catch(const std::logic_error&)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Invalid MIOPEN_DEBUG_TUNING_SHARD value: " + value +
+                         ", expected <index>/<count> or merge/<count>");
+    }
+    return shard;
+}
+
+boost::optional<TuningShard> GetTuningShard()
+{
+    const auto value = GetStringEnv(MIOPEN_DEBUG_TUNING_SHARD{});
+    if(value == nullptr || *value == '\0')
+        return boost::none;
+    return ParseTuningShard(value);
+}
+
+static std::string GetWorkerSuffix(std::size_t index, std::size_t count)
+{
+    return "." + std::to_string(index) + "-of-" + std::to_string(count);
+}
+
+TuningSession::TuningSession(const boost::filesystem::path& directory,
+                             const std::string& key,
+                             boost::optional<TuningShard> shard_)
+    : shard(shard_)
+{
+    const auto name = xxhash64(key);
+    if(IsWorker())
+    {
+        journal = TuningJournal{
+            directory / (name + GetWorkerSuffix(shard->index, shard->count) + ".txt"), key};
+        return;
+    }
+    journal = TuningJournal{directory / (name + ".txt"), key};
+    if(shard)
+    {
+        for(auto i = std::size_t{0}; i < shard->count; ++i)
+        {
+            worker_journals.emplace_back(directory /
+                                             (name + GetWorkerSuffix(i, shard->count) + ".txt"),
+                                         key);
+            if(worker_journals.back().GetEntries().empty())
+                MIOPEN_LOG_W("No measurements from tuning worker " << i << '/' << shard->count);
+        }
+    }
+}
+
+bool TuningSession::HasEntries() const
+{
+    return !journal.GetEntries().empty() ||
+           std::any_of(worker_journals.begin(), worker_journals.end(), [](const auto& worker) {
+               return !worker.GetEntries().empty();
+           });
+}
+
+std::vector<TuningSession::Measurement>
+TuningSession::Restore(const std::vector<std::string>& configs) const
+{
+    auto indices = std::unordered_map<std::string, std::size_t>{};
+    for(auto i = std::size_t{0}; i < configs.size(); ++i)
+        indices.emplace(configs[i], i);
+
+    auto restored      = std::vector<Measurement>{};
+    const auto restore = [&](const TuningJournal& from) {
+        for(const auto& entry : from.GetEntries())
+        {
+            const auto found = indices.find(entry.config);
+            if(found == indices.end())
+                continue;
+            restored.push_back({found->second, entry.time});
+            indices.erase(found);
+        }
+    };
+    for(const auto& worker : worker_journals)
+        restore(worker);
+    restore(journal);
+    return restored;
+}
+
+void TuningSession::Complete()
+{
+    if(IsWorker())
+        return;
+    journal.Remove();
+    for(auto& worker : worker_journals)
+        worker.Remove();
+}
+
+TuningSession OpenTuningSession(const ExecutionContext& context,
+                                const std::string& problem,
+                                const std::string& solver)
+{
+    const auto shard = GetTuningShard();
+    auto directory   = boost::filesystem::path{};
+    if(const auto dir = GetStringEnv(MIOPEN_DEBUG_TUNING_JOURNAL_DIR{}))
+        directory = dir;
+    else if(!DisableUserDbFileIO && !GetUserDbPath().empty())
+        directory = GetUserDbPath() / "tuning";
+
+    if(directory.empty() || IsDisabled(MIOPEN_DEBUG_TUNING_CHECKPOINT{}))
+    {
+        if(shard)
+            MIOPEN_THROW(miopenStatusBadParm, "Distributed search requires tuning journals");
+        return {};
+    }
+
+    const auto key = context.GetStream().GetDbBasename() + ' ' + problem + ' ' + solver;
+    auto session   = TuningSession{directory, key, shard};
+    if(session.HasEntries())
+        MIOPEN_LOG_I("Tuning journals found for " << session.GetPath());
+    return session;
+}
+
+} // namespace solver
+} // namespace miopen
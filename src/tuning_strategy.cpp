@@ -0,0 +1,467 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tuning_strategy.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/generic_search_controls.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/xxhash.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+/// The training set of the model is limited to the best measured configs. Exact Gaussian process
+/// is cubic in it, the prediction is quadratic.
+constexpr std::size_t max_model_points = 128;
+/// Expected improvement is computed for a random subset of the remaining configs.
+constexpr std::size_t max_candidates = 1024;
+/// Variance of the noise of the standardized log-times.
+constexpr double noise = 1e-2;
+/// Failed configs are modeled as this much slower (in log scale) than the slowest measured one.
+constexpr double failure_penalty = 1.0;
+
+/// Replaces the symmetric positive definite n x n matrix by its lower Cholesky factor.
+bool Cholesky(std::vector<double>& a, std::size_t n)
+{
+    for(auto j = std::size_t{0}; j < n; ++j)
+    {
+        auto d = a[j * n + j];
+        for(auto k = std::size_t{0}; k < j; ++k)
+            d -= a[j * n + k] * a[j * n + k];
+        if(!(d > 0.0))
+            return false;
+        d            = std::sqrt(d);
+        a[j * n + j] = d;
+        for(auto i = j + 1; i < n; ++i)
+        {
+            auto s = a[i * n + j];
+            for(auto k = std::size_t{0}; k < j; ++k)
+                s -= a[i * n + k] * a[j * n + k];
+            a[i * n + j] = s / d;
+        }
+        for(auto k = j + 1; k < n; ++k)
+            a[j * n + k] = 0.0;
+    }
+    return true;
+}
+
+/// Solves L x = b in place.
+void SolveLower(const std::vector<double>& l, std::size_t n, std::vector<double>& x)
+{
+    for(auto i = std::size_t{0}; i < n; ++i)
+    {
+        for(auto k = std::size_t{0}; k < i; ++k)
+            x[i] -= l[i * n + k] * x[k];
+        x[i] /= l[i * n + i];
+    }
+}
+
+/// Solves L^T x = b in place.
+void SolveUpper(const std::vector<double>& l, std::size_t n, std::vector<double>& x)
+{
+    for(auto i = n; i-- > 0;)
+    {
+        for(auto k = i + 1; k < n; ++k)
+            x[i] -= l[k * n + i] * x[k];
+        x[i] /= l[i * n + i];
+    }
+}
+
+double SquaredDistance(const std::vector<double>& a, const std::vector<double>& b)
+{
+    auto sum = 0.0;
+    for(auto i = std::size_t{0}; i < a.size(); ++i)
+        sum += (a[i] - b[i]) * (a[i] - b[i]);
+    return sum;
+}
+
+double ExpectedImprovement(double best, double mean, double variance)
+{
+    constexpr double pi    = 3.14159265358979323846;
+    const auto sigma       = std::sqrt(std::max(variance, 1e-12));
+    const auto improvement = best - mean - 0.01;
+    const auto z           = improvement / sigma;
+    const auto cdf         = 0.5 * std::erfc(-z / std::sqrt(2.0));
+    const auto pdf         = std::exp(-0.5 * z * z) / std::sqrt(2.0 * pi);
+    return improvement * cdf + sigma * pdf;
+}
+
+} // namespace
+
+/// Gaussian process with the squared exponential kernel.
+struct ModelTuningStrategy::Model
+{
+    std::vector<const std::vector<double>*> points;
+    std::vector<double> targets;
+    double length_scale = 1.0;
+    double best         = 0.0;
+    std::vector<double> chol;
+    std::vector<double> alpha;
+
+    double Kernel(const std::vector<double>& a, const std::vector<double>& b) const
+    {
+        return std::exp(-0.5 * SquaredDistance(a, b) / (length_scale * length_scale));
+    }
+
+    /// \return Log marginal likelihood, -inf if the kernel matrix is degenerate.
+    double Update()
+    {
+        const auto n = points.size();
+        chol.assign(n * n, 0.0);
+        for(auto i = std::size_t{0}; i < n; ++i)
+        {
+            for(auto j = std::size_t{0}; j <= i; ++j)
+                chol[i * n + j] = chol[j * n + i] = Kernel(*points[i], *points[j]);
+            chol[i * n + i] += noise;
+        }
+        if(!Cholesky(chol, n))
+            return -std::numeric_limits<double>::infinity();
+
+        alpha = targets;
+        SolveLower(chol, n, alpha);
+        auto likelihood = 0.0;
+        for(auto i = std::size_t{0}; i < n; ++i)
+            likelihood -= 0.5 * alpha[i] * alpha[i] + std::log(chol[i * n + i]);
+        SolveUpper(chol, n, alpha);
+        return likelihood;
+    }
+
+    void Predict(const std::vector<double>& x, double& mean, double& variance) const
+    {
+        const auto n = points.size();
+        auto k       = std::vector<double>(n);
+        for(auto i = std::size_t{0}; i < n; ++i)
+            k[i] = Kernel(x, *points[i]);
+        mean = std::inner_product(k.begin(), k.end(), alpha.begin(), 0.0);
+        SolveLower(chol, n, k);
+        variance = 1.0 + noise - std::inner_product(k.begin(), k.end(), k.begin(), 0.0);
+    }
+
+    /// Adds a config being measured with its predicted mean, so the next proposals of the same
+    /// batch are not all around the same point.
+    void AddPending(const std::vector<double>& x, double mean)
+    {
+        points.push_back(&x);
+        targets.push_back(mean);
+        Update();
+    }
+};
+
+void RandomTuningStrategy::Init(std::size_t size, const GetFeatures&)
+{
+    order.resize(size);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    restored.assign(size, false);
+    proposed = 0;
+}
+
+std::vector<std::size_t> RandomTuningStrategy::Propose(std::size_t max_count)
+{
+    auto proposal = std::vector<std::size_t>{};
+    while(proposal.size() < max_count && proposed < order.size())
+    {
+        const auto index = order[proposed++];
+        if(!restored[index])
+            proposal.push_back(index);
+    }
+    return proposal;
+}
+
+void ModelTuningStrategy::Init(std::size_t size, const GetFeatures& get_features)
+{
+    auto raw  = std::vector<std::vector<double>>(size);
+    auto dims = std::size_t{0};
+    for(auto i = std::size_t{0}; i < size; ++i)
+    {
+        raw[i] = get_features(i);
+        dims   = std::max(dims, raw[i].size());
+    }
+
+    // Sizes of tiles and the like are mostly powers of 2, so they are compared in log scale.
+    auto min = std::vector<double>(dims, std::numeric_limits<double>::max());
+    auto max = std::vector<double>(dims, std::numeric_limits<double>::lowest());
+    for(auto& config : raw)
+    {
+        config.resize(dims, 0.0);
+        for(auto d = std::size_t{0}; d < dims; ++d)
+        {
+            config[d] = std::copysign(std::log2(1.0 + std::abs(config[d])), config[d]);
+            min[d]    = std::min(min[d], config[d]);
+            max[d]    = std::max(max[d], config[d]);
+        }
+    }
+
+    auto used = std::vector<std::size_t>{};
+    for(auto d = std::size_t{0}; d < dims; ++d)
+        if(max[d] > min[d])
+            used.push_back(d);
+
+    features.assign(size, std::vector<double>(used.size()));
+    for(auto i = std::size_t{0}; i < size; ++i)
+        for(auto d = std::size_t{0}; d < used.size(); ++d)
+            features[i][d] = (raw[i][used[d]] - min[used[d]]) / (max[used[d]] - min[used[d]]);
+
+    remaining.resize(size);
+    std::iota(remaining.begin(), remaining.end(), 0);
+    restored.clear();
+    measured.clear();
+    log_times.clear();
+    initial_samples = std::clamp<std::size_t>(2 * used.size(), batch_size, 4 * batch_size);
+    MIOPEN_LOG_I2("Tuning model of " << size << " configs with " << used.size() << " features");
+}
+
+std::vector<std::size_t> ModelTuningStrategy::ProposeRandom(std::size_t count)
+{
+    count = std::min(count, remaining.size());
+    for(auto i = std::size_t{0}; i < count; ++i)
+    {
+        auto pick = std::uniform_int_distribution<std::size_t>{i, remaining.size() - 1}(rng);
+        std::swap(remaining[i], remaining[pick]);
+    }
+    const auto proposal = std::vector<std::size_t>(remaining.begin(), remaining.begin() + count);
+    remaining.erase(remaining.begin(), remaining.begin() + count);
+    return proposal;
+}
+
+void ModelTuningStrategy::Restore(std::size_t index, boost::optional<float> time)
+{
+    restored.resize(features.size(), false);
+    restored[index] = true;
+    Report(index, time);
+}
+
+std::vector<std::size_t> ModelTuningStrategy::Propose(std::size_t max_count)
+{
+    if(!restored.empty())
+    {
+        remaining.erase(std::remove_if(remaining.begin(),
+                                       remaining.end(),
+                                       [&](auto index) { return restored[index]; }),
+                        remaining.end());
+        restored.clear();
+    }
+
+    if(remaining.empty() || max_count == 0)
+        return {};
+
+    const auto passed = std::count_if(
+        log_times.begin(), log_times.end(), [](auto time) { return !std::isnan(time); });
+    if(measured.size() < initial_samples || passed < 2 || features.front().empty())
+    {
+        const auto count = measured.size() < initial_samples ? initial_samples - measured.size()
+                                                             : batch_size;
+        return ProposeRandom(std::min(count, max_count));
+    }
+
+    auto model = Fit();
+
+    // Random candidates are moved to the front.
+    const auto candidates = std::min(max_candidates, remaining.size());
+    for(auto i = std::size_t{0}; i < candidates; ++i)
+    {
+        auto pick = std::uniform_int_distribution<std::size_t>{i, remaining.size() - 1}(rng);
+        std::swap(remaining[i], remaining[pick]);
+    }
+
+    const auto count = std::min({max_count, batch_size, candidates});
+    auto picked      = std::vector<bool>(candidates, false);
+    auto positions   = std::vector<std::size_t>{};
+    for(auto n = std::size_t{0}; n < count; ++n)
+    {
+        auto best_position    = std::size_t{0};
+        auto best_improvement = -1.0;
+        auto best_mean        = 0.0;
+        for(auto i = std::size_t{0}; i < candidates; ++i)
+        {
+            if(picked[i])
+                continue;
+            auto mean     = 0.0;
+            auto variance = 0.0;
+            model.Predict(features[remaining[i]], mean, variance);
+            const auto improvement = ExpectedImprovement(model.best, mean, variance);
+            if(improvement > best_improvement)
+            {
+                best_improvement = improvement;
+                best_position    = i;
+                best_mean        = mean;
+            }
+        }
+        picked[best_position] = true;
+        positions.push_back(best_position);
+        model.AddPending(features[remaining[best_position]], best_mean);
+    }
+
+    auto proposal = std::vector<std::size_t>{};
+    for(const auto position : positions)
+        proposal.push_back(remaining[position]);
+    // Removed from the back, so the positions which are left stay valid.
+    std::sort(positions.rbegin(), positions.rend());
+    for(const auto position : positions)
+    {
+        remaining[position] = remaining.back();
+        remaining.pop_back();
+    }
+    return proposal;
+}
+
+void ModelTuningStrategy::Report(std::size_t index, boost::optional<float> time)
+{
+    measured.push_back(index);
+    log_times.push_back(time ? std::log(std::max(*time, 1e-6f))
+                             : std::numeric_limits<double>::quiet_NaN());
+}
+
+ModelTuningStrategy::Model ModelTuningStrategy::Fit() const
+{
+    auto slowest = std::numeric_limits<double>::lowest();
+    for(const auto time : log_times)
+        if(!std::isnan(time))
+            slowest = std::max(slowest, time);
+
+    auto order = std::vector<std::size_t>(measured.size());
+    std::iota(order.begin(), order.end(), 0);
+    const auto target = [&](std::size_t i) {
+        return std::isnan(log_times[i]) ? slowest + failure_penalty : log_times[i];
+    };
+    std::sort(order.begin(), order.end(), [&](auto l, auto r) { return target(l) < target(r); });
+    order.resize(std::min(order.size(), max_model_points));
+
+    auto model = Model{};
+    for(const auto i : order)
+    {
+        model.points.push_back(&features[measured[i]]);
+        model.targets.push_back(target(i));
+    }
+
+    const auto n    = static_cast<double>(model.targets.size());
+    const auto mean = std::accumulate(model.targets.begin(), model.targets.end(), 0.0) / n;
+    auto variance   = 0.0;
+    for(const auto t : model.targets)
+        variance += (t - mean) * (t - mean) / n;
+    const auto scale = variance > 0.0 ? std::sqrt(variance) : 1.0;
+    for(auto& t : model.targets)
+        t = (t - mean) / scale;
+    model.best = model.targets.front();
+
+    // The length scale is chosen by the likelihood of the data.
+    const auto dims      = std::sqrt(static_cast<double>(features.front().size()));
+    auto best_scale      = 0.0;
+    auto best_likelihood = -std::numeric_limits<double>::infinity();
+    for(const auto length_scale : {0.05, 0.1, 0.2, 0.4, 0.8})
+    {
+        model.length_scale    = length_scale * dims;
+        const auto likelihood = model.Update();
+        if(likelihood > best_likelihood || best_scale == 0.0)
+        {
+            best_likelihood = likelihood;
+            best_scale      = model.length_scale;
+        }
+    }
+    model.length_scale = best_scale;
+    model.Update();
+    return model;
+}
+
+bool TuningEarlyStop::Update(boost::optional<float> time)
+{
+    ++measured;
+    if(time && *time < best)
+    {
+        if(*time < best * (1.0 - min_improvement))
+            last_improvement = measured;
+        best = *time;
+    }
+    // Nothing has passed yet, so there is nothing to converge to.
+    if(patience == 0 || best == std::numeric_limits<float>::max())
+        return false;
+    return measured - last_improvement >= patience;
+}
+
+std::unique_ptr<TuningStrategy> MakeTuningStrategy(std::size_t parallelism)
+{
+    const auto name = GetStringEnv(MIOPEN_DEBUG_TUNING_STRATEGY{});
+    if(name == nullptr || std::string{name} == "random")
+        return std::make_unique<RandomTuningStrategy>();
+    if(std::string{name} == "model")
+        return std::make_unique<ModelTuningStrategy>(std::random_device{}(),
+                                                     std::max<std::size_t>(parallelism, 8));
+    MIOPEN_THROW(miopenStatusBadParm,
+                 std::string{"Unknown MIOPEN_DEBUG_TUNING_STRATEGY value: "} + name);
+}
+
+TuningEarlyStop MakeTuningEarlyStop()
+{
+    return TuningEarlyStop{Value(MIOPEN_DEBUG_TUNING_EARLY_STOP{})};
+}
+
+std::vector<double> ParseTuningFeatures(const std::string& serialized)
+{
+    auto features = std::vector<double>{};
+    auto pos      = std::size_t{0};
+    while(pos < serialized.size())
+    {
+        // The character classification is undefined for negative chars.
+        const auto c = static_cast<unsigned char>(serialized[pos]);
+        if(std::isdigit(c) != 0 ||
+           (c == '-' && pos + 1 < serialized.size() &&
+            std::isdigit(static_cast<unsigned char>(serialized[pos + 1])) != 0))
+        {
+            char* end = nullptr;
+            features.push_back(std::strtod(serialized.c_str() + pos, &end));
+            pos = end - serialized.c_str();
+        }
+        else if(std::isalpha(c) != 0 || c == '_')
+        {
+            const auto begin = pos;
+            while(pos < serialized.size() &&
+                  (std::isalnum(static_cast<unsigned char>(serialized[pos])) != 0 ||
+                   serialized[pos] == '_'))
+                ++pos;
+            const auto word = serialized.substr(begin, pos - begin);
+            if(word == "true" || word == "false")
+                features.push_back(word == "true" ? 1.0 : 0.0);
+            else
+                features.push_back(static_cast<double>(xxhash64(word.data(), word.size()) % 1024));
+        }
+        else
+        {
+            ++pos;
+        }
+    }
+    return features;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,563 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/xxhash.hpp>
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace miopen {
+namespace {
+constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// Only little-endian targets are supported.
+inline uint64_t Read64(const unsigned char* p)
+{
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t Read32(const unsigned char* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input)
+{
+    acc += input * prime2;
+    acc = Rotl(acc, 31);
+    return acc * prime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t val)
+{
+    acc ^= Round(0, val);
+    return acc * prime1 + prime4;
+}
+
+inline uint64_t Avalanche64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+// XXH3, version 0.8 of the reference implementation.
+
+constexpr uint32_t prime32_1 = 0x9E3779B1U;
+constexpr uint32_t prime32_2 = 0x85EBCA77U;
+constexpr uint32_t prime32_3 = 0xC2B2AE3DU;
+constexpr uint64_t prime_mx1 = 0x165667919E3779F9ULL;
+constexpr uint64_t prime_mx2 = 0x9FB21C651E98DF25ULL;
+
+constexpr std::size_t secret_size      = 192;
+constexpr std::size_t stripe_len       = 64;
+constexpr std::size_t secret_consume   = 8;
+constexpr std::size_t acc_count        = stripe_len / sizeof(uint64_t);
+constexpr std::size_t midsize_max      = 240;
+constexpr std::size_t secret_size_min  = 136;
+constexpr std::size_t midsize_start    = 3;
+constexpr std::size_t midsize_last     = 17;
+constexpr std::size_t merge_accs_start = 11;
+constexpr std::size_t last_acc_start   = 7;
+
+alignas(64) constexpr unsigned char default_secret[secret_size] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline uint32_t Swap32(uint32_t x)
+{
+    return ((x << 24) & 0xff000000U) | ((x << 8) & 0x00ff0000U) | ((x >> 8) & 0x0000ff00U) |
+           ((x >> 24) & 0x000000ffU);
+}
+
+inline uint64_t Swap64(uint64_t x)
+{
+    return (static_cast<uint64_t>(Swap32(static_cast<uint32_t>(x))) << 32) |
+           Swap32(static_cast<uint32_t>(x >> 32));
+}
+
+inline uint32_t Rotl32(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+
+inline xxhash128_t Mul128(uint64_t lhs, uint64_t rhs)
+{
+#if defined(__SIZEOF_INT128__)
+    const auto product = static_cast<unsigned __int128>(lhs) * rhs;
+    return {static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#else
+    const auto lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    const auto hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    const auto lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    const auto hi_hi = (lhs >> 32) * (rhs >> 32);
+    const auto cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    return {(cross << 32) | (lo_lo & 0xFFFFFFFF), (hi_lo >> 32) + (cross >> 32) + hi_hi};
+#endif
+}
+
+inline uint64_t Mul128Fold64(uint64_t lhs, uint64_t rhs)
+{
+    const auto product = Mul128(lhs, rhs);
+    return product.low ^ product.high;
+}
+
+inline uint64_t Avalanche3(uint64_t h)
+{
+    h ^= h >> 37;
+    h *= prime_mx1;
+    return h ^ (h >> 32);
+}
+
+inline uint64_t Rrmxmx(uint64_t h, uint64_t len)
+{
+    h ^= Rotl(h, 49) ^ Rotl(h, 24);
+    h *= prime_mx2;
+    h ^= (h >> 35) + len;
+    h *= prime_mx2;
+    return h ^ (h >> 28);
+}
+
+inline uint64_t Mix16(const unsigned char* p, const unsigned char* secret, uint64_t seed)
+{
+    return Mul128Fold64(Read64(p) ^ (Read64(secret) + seed),
+                        Read64(p + 8) ^ (Read64(secret + 8) - seed));
+}
+
+inline void Mix32(xxhash128_t& acc,
+                  const unsigned char* p1,
+                  const unsigned char* p2,
+                  const unsigned char* secret,
+                  uint64_t seed)
+{
+    acc.low += Mix16(p1, secret, seed);
+    acc.low ^= Read64(p2) + Read64(p2 + 8);
+    acc.high += Mix16(p2, secret + 16, seed);
+    acc.high ^= Read64(p1) + Read64(p1 + 8);
+}
+
+// The lanes of a stripe are independent, so they are processed two at a time with SSE2, which
+// all x86-64 targets have. Compilers do not vectorize the scalar loops by themselves.
+#if defined(__SSE2__)
+inline void Accumulate512(uint64_t* __restrict acc,
+                          const unsigned char* __restrict p,
+                          const unsigned char* __restrict secret)
+{
+    for(std::size_t i = 0; i < acc_count; i += 2)
+    {
+        const auto lanes   = _mm_load_si128(reinterpret_cast<const __m128i*>(acc + i));
+        const auto value   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8 * i));
+        const auto key     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + 8 * i));
+        const auto mixed   = _mm_xor_si128(value, key);
+        const auto mixed_h = _mm_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1));
+        const auto product = _mm_mul_epu32(mixed, mixed_h);
+        const auto swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+        _mm_store_si128(reinterpret_cast<__m128i*>(acc + i),
+                        _mm_add_epi64(product, _mm_add_epi64(lanes, swapped)));
+    }
+}
+
+inline void ScrambleAcc(uint64_t* __restrict acc, const unsigned char* __restrict secret)
+{
+    const auto prime32 = _mm_set1_epi32(static_cast<int>(prime32_1));
+    for(std::size_t i = 0; i < acc_count; i += 2)
+    {
+        const auto lanes   = _mm_load_si128(reinterpret_cast<const __m128i*>(acc + i));
+        const auto value   = _mm_xor_si128(lanes, _mm_srli_epi64(lanes, 47));
+        const auto key     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + 8 * i));
+        const auto mixed   = _mm_xor_si128(value, key);
+        const auto mixed_h = _mm_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1));
+        const auto prod_lo = _mm_mul_epu32(mixed, prime32);
+        const auto prod_hi = _mm_mul_epu32(mixed_h, prime32);
+        _mm_store_si128(reinterpret_cast<__m128i*>(acc + i),
+                        _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32)));
+    }
+}
+#else
+inline void Accumulate512(uint64_t* __restrict acc,
+                          const unsigned char* __restrict p,
+                          const unsigned char* __restrict secret)
+{
+    for(std::size_t i = 0; i < acc_count; ++i)
+    {
+        const auto value = Read64(p + 8 * i);
+        const auto key   = value ^ Read64(secret + 8 * i);
+        acc[i ^ 1] += value;
+        acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+    }
+}
+
+inline void ScrambleAcc(uint64_t* __restrict acc, const unsigned char* __restrict secret)
+{
+    for(std::size_t i = 0; i < acc_count; ++i)
+    {
+        auto value = acc[i];
+        value ^= value >> 47;
+        value ^= Read64(secret + 8 * i);
+        acc[i] = value * prime32_1;
+    }
+}
+#endif
+
+inline uint64_t MergeAccs(const uint64_t* acc, const unsigned char* secret, uint64_t start)
+{
+    auto result = start;
+    for(std::size_t i = 0; i < 4; ++i)
+        result += Mul128Fold64(acc[2 * i] ^ Read64(secret + 16 * i),
+                               acc[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+    return Avalanche3(result);
+}
+
+/// Inputs longer than midsize_max are hashed with a secret derived from the seed.
+struct Secret
+{
+    alignas(64) unsigned char data[secret_size];
+
+    explicit Secret(uint64_t seed)
+    {
+        for(std::size_t i = 0; i < secret_size; i += 16)
+        {
+            const auto lo = Read64(default_secret + i) + seed;
+            const auto hi = Read64(default_secret + i + 8) - seed;
+            std::memcpy(data + i, &lo, sizeof(lo));
+            std::memcpy(data + i + 8, &hi, sizeof(hi));
+        }
+    }
+};
+
+void HashLong(uint64_t* acc, const unsigned char* p, std::size_t size, const unsigned char* secret)
+{
+    constexpr auto stripes_per_block = (secret_size - stripe_len) / secret_consume;
+    constexpr auto block_len         = stripe_len * stripes_per_block;
+    const auto blocks                = (size - 1) / block_len;
+
+    for(std::size_t n = 0; n < blocks; ++n)
+    {
+        for(std::size_t s = 0; s < stripes_per_block; ++s)
+            Accumulate512(acc, p + n * block_len + s * stripe_len, secret + s * secret_consume);
+        ScrambleAcc(acc, secret + secret_size - stripe_len);
+    }
+
+    const auto stripes = ((size - 1) - block_len * blocks) / stripe_len;
+    for(std::size_t s = 0; s < stripes; ++s)
+        Accumulate512(acc, p + blocks * block_len + s * stripe_len, secret + s * secret_consume);
+
+    Accumulate512(acc, p + size - stripe_len, secret + secret_size - stripe_len - last_acc_start);
+}
+
+uint64_t Xxh3Long64(const unsigned char* p, std::size_t size, uint64_t seed)
+{
+    alignas(16) uint64_t acc[acc_count] = {
+        prime32_3, prime1, prime2, prime3, prime4, prime32_2, prime5, prime32_1};
+    const auto secret = Secret{seed};
+    HashLong(acc, p, size, secret.data);
+    return MergeAccs(acc, secret.data + merge_accs_start, size * prime1);
+}
+
+xxhash128_t Xxh3Long128(const unsigned char* p, std::size_t size, uint64_t seed)
+{
+    alignas(16) uint64_t acc[acc_count] = {
+        prime32_3, prime1, prime2, prime3, prime4, prime32_2, prime5, prime32_1};
+    const auto secret = Secret{seed};
+    HashLong(acc, p, size, secret.data);
+    return {MergeAccs(acc, secret.data + merge_accs_start, size * prime1),
+            MergeAccs(acc,
+                      secret.data + secret_size - stripe_len - merge_accs_start,
+                      ~(size * prime2))};
+}
+
+/// Writes the hash as 16 hex digits which end right before `end`.
+void WriteHex(uint64_t h, char* end)
+{
+    static const char digits[] = "0123456789abcdef";
+    for(auto i = 0; i < 16; ++i, h >>= 4)
+        *--end = digits[h & 0xf];
+}
+} // namespace
+
+uint64_t xxhash64(const void* data, std::size_t size, uint64_t seed)
+{
+    auto p         = static_cast<const unsigned char*>(data);
+    const auto end = p + size;
+    uint64_t h;
+
+    if(size >= 32)
+    {
+        // Four independent lanes, so the stripes are processed without dependencies between them.
+        uint64_t v1 = seed + prime1 + prime2;
+        uint64_t v2 = seed + prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - prime1;
+
+        for(const auto limit = end - 32; p <= limit; p += 32)
+        {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+        }
+
+        h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+        h = MergeRound(h, v1);
+        h = MergeRound(h, v2);
+        h = MergeRound(h, v3);
+        h = MergeRound(h, v4);
+    }
+    else
+    {
+        h = seed + prime5;
+    }
+
+    h += size;
+
+    for(; p + 8 <= end; p += 8)
+    {
+        h ^= Round(0, Read64(p));
+        h = Rotl(h, 27) * prime1 + prime4;
+    }
+
+    if(p + 4 <= end)
+    {
+        h ^= Read32(p) * prime1;
+        h = Rotl(h, 23) * prime2 + prime3;
+        p += 4;
+    }
+
+    for(; p < end; ++p)
+    {
+        h ^= *p * prime5;
+        h = Rotl(h, 11) * prime1;
+    }
+
+    return Avalanche64(h);
+}
+
+std::string xxhash64(const std::string& s)
+{
+    auto result = std::string(16, '0');
+    WriteHex(xxhash64(s.data(), s.size()), &result[0] + 16);
+    return result;
+}
+
+uint64_t xxh3_64(const void* data, std::size_t size, uint64_t seed)
+{
+    const auto p      = static_cast<const unsigned char*>(data);
+    const auto secret = default_secret;
+
+    if(size == 0)
+        return Avalanche64(seed ^ Read64(secret + 56) ^ Read64(secret + 64));
+
+    if(size <= 3)
+    {
+        const uint32_t combined = (static_cast<uint32_t>(p[0]) << 16) |
+                                  (static_cast<uint32_t>(p[size >> 1]) << 24) |
+                                  static_cast<uint32_t>(p[size - 1]) |
+                                  (static_cast<uint32_t>(size) << 8);
+        const uint64_t bitflip = (Read32(secret) ^ Read32(secret + 4)) + seed;
+        return Avalanche64(combined ^ bitflip);
+    }
+
+    if(size <= 8)
+    {
+        seed ^= static_cast<uint64_t>(Swap32(static_cast<uint32_t>(seed))) << 32;
+        const auto bitflip = (Read64(secret + 8) ^ Read64(secret + 16)) - seed;
+        const auto value   = Read32(p + size - 4) + (static_cast<uint64_t>(Read32(p)) << 32);
+        return Rrmxmx(value ^ bitflip, size);
+    }
+
+    if(size <= 16)
+    {
+        const auto bitflip1 = (Read64(secret + 24) ^ Read64(secret + 32)) + seed;
+        const auto bitflip2 = (Read64(secret + 40) ^ Read64(secret + 48)) - seed;
+        const auto lo       = Read64(p) ^ bitflip1;
+        const auto hi       = Read64(p + size - 8) ^ bitflip2;
+        return Avalanche3(size + Swap64(lo) + hi + Mul128Fold64(lo, hi));
+    }
+
+    if(size <= 128)
+    {
+        uint64_t acc = size * prime1;
+        if(size > 32)
+        {
+            if(size > 64)
+            {
+                if(size > 96)
+                {
+                    acc += Mix16(p + 48, secret + 96, seed);
+                    acc += Mix16(p + size - 64, secret + 112, seed);
+                }
+                acc += Mix16(p + 32, secret + 64, seed);
+                acc += Mix16(p + size - 48, secret + 80, seed);
+            }
+            acc += Mix16(p + 16, secret + 32, seed);
+            acc += Mix16(p + size - 32, secret + 48, seed);
+        }
+        acc += Mix16(p, secret, seed);
+        acc += Mix16(p + size - 16, secret + 16, seed);
+        return Avalanche3(acc);
+    }
+
+    if(size <= midsize_max)
+    {
+        uint64_t acc = size * prime1;
+        for(std::size_t i = 0; i < 8; ++i)
+            acc += Mix16(p + 16 * i, secret + 16 * i, seed);
+        auto acc_end = Mix16(p + size - 16, secret + secret_size_min - midsize_last, seed);
+        acc          = Avalanche3(acc);
+        for(std::size_t i = 8; i < size / 16; ++i)
+            acc_end += Mix16(p + 16 * i, secret + 16 * (i - 8) + midsize_start, seed);
+        return Avalanche3(acc + acc_end);
+    }
+
+    return Xxh3Long64(p, size, seed);
+}
+
+xxhash128_t xxh3_128(const void* data, std::size_t size, uint64_t seed)
+{
+    const auto p      = static_cast<const unsigned char*>(data);
+    const auto secret = default_secret;
+
+    if(size == 0)
+        return {Avalanche64(seed ^ Read64(secret + 64) ^ Read64(secret + 72)),
+                Avalanche64(seed ^ Read64(secret + 80) ^ Read64(secret + 88))};
+
+    if(size <= 3)
+    {
+        const uint32_t combined_lo = (static_cast<uint32_t>(p[0]) << 16) |
+                                     (static_cast<uint32_t>(p[size >> 1]) << 24) |
+                                     static_cast<uint32_t>(p[size - 1]) |
+                                     (static_cast<uint32_t>(size) << 8);
+        const uint32_t combined_hi = Rotl32(Swap32(combined_lo), 13);
+        const uint64_t bitflip_lo  = (Read32(secret) ^ Read32(secret + 4)) + seed;
+        const uint64_t bitflip_hi  = (Read32(secret + 8) ^ Read32(secret + 12)) - seed;
+        return {Avalanche64(combined_lo ^ bitflip_lo), Avalanche64(combined_hi ^ bitflip_hi)};
+    }
+
+    if(size <= 8)
+    {
+        seed ^= static_cast<uint64_t>(Swap32(static_cast<uint32_t>(seed))) << 32;
+        const auto value   = Read32(p) + (static_cast<uint64_t>(Read32(p + size - 4)) << 32);
+        const auto bitflip = (Read64(secret + 16) ^ Read64(secret + 24)) + seed;
+        auto m             = Mul128(value ^ bitflip, prime1 + (size << 2));
+        m.high += m.low << 1;
+        m.low ^= m.high >> 3;
+        m.low ^= m.low >> 35;
+        m.low *= prime_mx2;
+        m.low ^= m.low >> 28;
+        m.high = Avalanche3(m.high);
+        return m;
+    }
+
+    if(size <= 16)
+    {
+        const auto bitflip_lo = (Read64(secret + 32) ^ Read64(secret + 40)) - seed;
+        const auto bitflip_hi = (Read64(secret + 48) ^ Read64(secret + 56)) + seed;
+        const auto lo         = Read64(p);
+        auto hi               = Read64(p + size - 8);
+        auto m                = Mul128(lo ^ hi ^ bitflip_lo, prime1);
+        m.low += static_cast<uint64_t>(size - 1) << 54;
+        hi ^= bitflip_hi;
+        m.high += hi + (hi & 0xFFFFFFFF) * (prime32_2 - 1);
+        m.low ^= Swap64(m.high);
+        auto h = Mul128(m.low, prime2);
+        h.high += m.high * prime2;
+        return {Avalanche3(h.low), Avalanche3(h.high)};
+    }
+
+    if(size <= midsize_max)
+    {
+        auto acc = xxhash128_t{size * prime1, 0};
+        if(size <= 128)
+        {
+            if(size > 32)
+            {
+                if(size > 64)
+                {
+                    if(size > 96)
+                        Mix32(acc, p + 48, p + size - 64, secret + 96, seed);
+                    Mix32(acc, p + 32, p + size - 48, secret + 64, seed);
+                }
+                Mix32(acc, p + 16, p + size - 32, secret + 32, seed);
+            }
+            Mix32(acc, p, p + size - 16, secret, seed);
+        }
+        else
+        {
+            for(std::size_t i = 32; i < 160; i += 32)
+                Mix32(acc, p + i - 32, p + i - 16, secret + i - 32, seed);
+            acc.low  = Avalanche3(acc.low);
+            acc.high = Avalanche3(acc.high);
+            for(std::size_t i = 160; i <= size; i += 32)
+                Mix32(acc, p + i - 32, p + i - 16, secret + midsize_start + i - 160, seed);
+            Mix32(acc,
+                  p + size - 16,
+                  p + size - 32,
+                  secret + secret_size_min - midsize_last - 16,
+                  0 - seed);
+        }
+
+        const auto low  = acc.low + acc.high;
+        const auto high = acc.low * prime1 + acc.high * prime4 + (size - seed) * prime2;
+        return {Avalanche3(low), 0 - Avalanche3(high)};
+    }
+
+    return Xxh3Long128(p, size, seed);
+}
+
+std::string xxh3_128(const std::string& s)
+{
+    const auto h = xxh3_128(s.data(), s.size());
+    auto result  = std::string(32, '0');
+    WriteHex(h.high, &result[0] + 16);
+    WriteHex(h.low, &result[0] + 32);
+    return result;
+}
+
+} // namespace miopen
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/zstd.hpp>
+
+#include <zstd.h>
+
+#include <stdexcept>
+
+namespace miopen {
+namespace zstd {
+namespace {
+// Decompression speed does not depend on the level, higher levels only slow down the writes.
+constexpr int compression_level = 9;
+
+void check_zstd_error(size_t e, const std::string& name)
+{
+    if(ZSTD_isError(e) != 0u)
+        throw std::runtime_error(name + " failed: " + ZSTD_getErrorName(e));
+}
+} // namespace
+
+std::string compress(const std::string& s, bool* compressed)
+{
+    std::string result(ZSTD_compressBound(s.size()), 0);
+    const auto len =
+        ZSTD_compress(&result[0], result.size(), s.data(), s.size(), compression_level);
+    check_zstd_error(len, "ZSTD_compress");
+    if(compressed != nullptr)
+    {
+        *compressed = len < s.size();
+        if(!*compressed)
+            return s;
+    }
+    result.resize(len);
+    return result;
+}
+
+std::string decompress(const std::string& s, unsigned int size)
+{
+    std::string result(size, 0);
+    const auto len = ZSTD_decompress(&result[0], result.size(), s.data(), s.size());
+    check_zstd_error(len, "ZSTD_decompress");
+    result.resize(len);
+    return result;
+}
+
+} // namespace zstd
+} // namespace miopen
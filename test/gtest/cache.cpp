@@ -27,8 +27,12 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/kern_db.hpp>
 #include <miopen/temp_file.hpp>
+#if MIOPEN_USE_ZSTD
+#include <miopen/zstd.hpp>
+#endif
 
 #include <miopen/md5.hpp>
+#include <miopen/xxhash.hpp>
 #include "test.hpp"
 #include "random.hpp"
 
@@ -88,6 +92,24 @@ TEST(TestCache, check_bz2_decompress)
     ASSERT_TRUE(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+#if MIOPEN_USE_ZSTD
+TEST(TestCache, check_zstd_compress)
+{
+    auto orig_str = random_string(4096);
+    bool success  = false;
+    auto cmprsd   = miopen::zstd::compress(orig_str, &success);
+    ASSERT_TRUE(success);
+    ASSERT_TRUE(cmprsd.size() < orig_str.size());
+    ASSERT_TRUE(miopen::zstd::decompress(cmprsd, orig_str.size()) == orig_str);
+
+    EXPECT_TRUE(throws([&]() { std::ignore = miopen::zstd::decompress(cmprsd, 10); }));
+
+    // Incompressible data is stored as is.
+    cmprsd = miopen::zstd::compress(cmprsd, &success);
+    ASSERT_FALSE(success);
+}
+#endif
+
 TEST(TestCache, check_kern_db)
 {
     miopen::KernelConfig cfg0;
@@ -134,6 +156,75 @@ TEST(TestCache, check_kern_db)
         EXPECT_TRUE(err_db.RemoveRecordUnsafe(cfg0));
     }
 }
+
+TEST(TestCache, check_kern_db_codecs)
+{
+    miopen::KernelConfig cfg0;
+    cfg0.kernel_name = "kernel1";
+    cfg0.kernel_args = random_string(512);
+    cfg0.kernel_blob = random_string(8192);
+
+    miopen::KernelConfig cfg1 = cfg0;
+    cfg1.kernel_name          = "kernel2";
+
+    miopen::TempFile temp_file("tmp-kerndb");
+
+    {
+        miopen::SQLite sql{temp_file.Path(), false};
+        // clang-format off
+        sql.Exec("CREATE TABLE `kern_db` ("
+                 "`id` INTEGER PRIMARY KEY ASC,"
+                 "`kernel_name` TEXT NOT NULL,"
+                 "`kernel_args` TEXT NOT NULL,"
+                 "`kernel_blob` BLOB NOT NULL,"
+                 "`kernel_hash` TEXT NOT NULL,"
+                 "`uncompressed_size` INT NOT NULL);");
+        // clang-format on
+        auto stmt = miopen::SQLite::Statement{sql,
+                                              "INSERT INTO kern_db(kernel_name, kernel_args, "
+                                              "kernel_blob, kernel_hash, uncompressed_size) "
+                                              "VALUES(?, ?, ?, ?, ?);"};
+        stmt.BindText(1, cfg0.kernel_name);
+        stmt.BindText(2, cfg0.kernel_args);
+        stmt.BindBlob(3, miopen::compress(cfg0.kernel_blob));
+        stmt.BindText(4, miopen::md5(cfg0.kernel_blob));
+        stmt.BindInt64(5, cfg0.kernel_blob.size());
+        ASSERT_EQ(stmt.Step(sql), SQLITE_DONE);
+    }
+
+    for(const auto codec :
+        {miopen::KernDbCodec::None, miopen::KernDbCodec::Bzip2, miopen::KernDbCodec::Zstd})
+    {
+#if !MIOPEN_USE_ZSTD
+        if(codec == miopen::KernDbCodec::Zstd)
+            continue;
+#endif
+        // Records written before the codec and hash_type columns were added, or with another
+        // codec, are still readable.
+        miopen::KernDb db(temp_file.Path(), false, codec);
+        auto readout = db.FindRecordUnsafe(cfg0);
+        ASSERT_TRUE(readout);
+        EXPECT_TRUE(readout.get() == cfg0.kernel_blob);
+
+        auto prev = db.FindRecordUnsafe(cfg1);
+        if(prev)
+        {
+            EXPECT_TRUE(prev.get() == cfg1.kernel_blob);
+        }
+
+        EXPECT_TRUE(db.StoreRecordUnsafe(cfg1));
+        readout = db.FindRecordUnsafe(cfg1);
+        ASSERT_TRUE(readout);
+        EXPECT_TRUE(readout.get() == cfg1.kernel_blob);
+    }
+
+    {
+        miopen::SQLite sql{temp_file.Path(), false};
+        sql.Exec("UPDATE kern_db SET kernel_hash = '0' WHERE kernel_name = 'kernel2';");
+    }
+    miopen::KernDb db(temp_file.Path(), false);
+    EXPECT_TRUE(throws([&]() { std::ignore = db.FindRecordUnsafe(cfg1); }));
+}
 #endif
 
 TEST(TestCache, check_cache_file)
@@ -145,6 +236,35 @@ TEST(TestCache, check_cache_file)
 TEST(TestCache, check_cache_str)
 {
     auto p    = miopen::GetCacheFile("gfx", "base", "args", true);
-    auto name = miopen::md5("base");
+    auto name = miopen::xxh3_128("base");
     EXPECT_TRUE(p.filename().string() == name + ".o");
 }
+
+TEST(TestCache, check_xxhash64)
+{
+    EXPECT_EQ(miopen::xxhash64(""), "ef46db3751d8e999");
+    EXPECT_EQ(miopen::xxhash64("a"), "d24ec4f1a98c6e5b");
+    EXPECT_EQ(miopen::xxhash64("abc"), "44bc2cf5ad770999");
+
+    std::string s;
+    for(auto i = 0; i < 3; ++i)
+        s += "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJ";
+    EXPECT_EQ(miopen::xxhash64(s), "96b8be0a711b97f4");
+    EXPECT_EQ(miopen::xxhash64(s.data(), s.size(), 0), 0x96b8be0a711b97f4ULL);
+    EXPECT_NE(miopen::xxhash64(s.data(), s.size(), 1), 0x96b8be0a711b97f4ULL);
+}
+
+TEST(TestCache, check_xxh3)
+{
+    EXPECT_EQ(miopen::xxh3_64("", 0), 0x2d06800538d394c2ULL);
+    EXPECT_EQ(miopen::xxh3_128(""), "99aa06d3014798d86001c324468d497f");
+    EXPECT_EQ(miopen::xxh3_128("abc"), "06b05ab6733a618578af5f94892f3950");
+
+    // Longer than a block of stripes, so the accumulators are scrambled as well.
+    std::string s;
+    for(auto i = 0; i < 4096; ++i)
+        s += static_cast<char>('a' + i % 26);
+    EXPECT_EQ(miopen::xxh3_64(s.data(), s.size()), 0x418f6f6a75913ff3ULL);
+    EXPECT_EQ(miopen::xxh3_128(s), "8905489dd3ee402b418f6f6a75913ff3");
+    EXPECT_NE(miopen::xxh3_64(s.data(), s.size(), 1), 0x418f6f6a75913ff3ULL);
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_job_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Counts the compilations of each program instead of running the compiler.
+struct MockCompiler
+{
+    std::array<std::atomic<int>, 16> compilations{};
+
+    std::function<void()> Compile(std::size_t program)
+    {
+        return [this, program]() {
+            ++compilations[program];
+            std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        };
+    }
+};
+
+uint64_t Key(std::size_t program)
+{
+    return miopen::CompileJobTable::MakeKey(
+        "gfx90a_110", "kernel.s", "-DP=" + std::to_string(program));
+}
+
+} // namespace
+
+TEST(CompileJobTable, CompilesEachProgramOnce)
+{
+    auto table    = miopen::CompileJobTable{};
+    auto compiler = MockCompiler{};
+
+    // Many perf configs of several solvers map to the same few programs.
+    auto agents = std::vector<std::thread>{};
+    for(auto agent = 0; agent < 8; ++agent)
+    {
+        agents.emplace_back([&, agent]() {
+            for(auto config = 0; config < 100; ++config)
+            {
+                const auto program = static_cast<std::size_t>((config + agent) % 10);
+                table.Run(Key(program), compiler.Compile(program));
+            }
+        });
+    }
+    for(auto& agent : agents)
+        agent.join();
+
+    for(auto program = 0; program < 10; ++program)
+        EXPECT_EQ(compiler.compilations[program], 1) << "program " << program;
+    const auto stats = table.GetStats();
+    EXPECT_EQ(stats.requested, 800);
+    EXPECT_EQ(stats.run, 10);
+    EXPECT_EQ(stats.Avoided(), 790);
+}
+
+TEST(CompileJobTable, DistinguishesTargetsAndOptions)
+{
+    using miopen::CompileJobTable;
+    EXPECT_NE(CompileJobTable::MakeKey("gfx90a_110", "a.s", "-O3"),
+              CompileJobTable::MakeKey("gfx908_120", "a.s", "-O3"));
+    EXPECT_NE(CompileJobTable::MakeKey("gfx90a_110", "a.s", "-O3"),
+              CompileJobTable::MakeKey("gfx90a_110", "a.s", "-O2"));
+    EXPECT_NE(CompileJobTable::MakeKey("gfx90a_110", "a.s", "-O3"),
+              CompileJobTable::MakeKey("gfx90a_110", "a.s-O3", ""));
+}
+
+TEST(CompileJobTable, RetriesFailedCompilation)
+{
+    auto table    = miopen::CompileJobTable{};
+    auto attempts = std::atomic<int>{0};
+    const auto failing = [&]() {
+        ++attempts;
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        throw std::runtime_error("compiler error");
+    };
+
+    // The request waiting for the failed compilation gets its error.
+    auto waiter_failed = std::atomic<bool>{false};
+    auto first         = std::thread{[&]() { EXPECT_ANY_THROW(table.Run(Key(0), failing)); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    auto waiter = std::thread{[&]() {
+        try
+        {
+            table.Run(Key(0), failing);
+        }
+        catch(const std::runtime_error&)
+        {
+            waiter_failed = true;
+        }
+    }};
+    first.join();
+    waiter.join();
+    EXPECT_TRUE(waiter_failed);
+
+    EXPECT_ANY_THROW(table.Run(Key(0), failing));
+    EXPECT_EQ(attempts, table.GetStats().run);
+
+    auto compiler = MockCompiler{};
+    table.Run(Key(0), compiler.Compile(0));
+    EXPECT_EQ(compiler.compilations[0], 1);
+}
+
+TEST(CompileJobTable, ForgetsUnstoredPrograms)
+{
+    auto table    = miopen::CompileJobTable{};
+    auto compiler = MockCompiler{};
+
+    table.Run(Key(1), compiler.Compile(1), false);
+    table.Run(Key(1), compiler.Compile(1), false);
+    EXPECT_EQ(compiler.compilations[1], 2);
+
+    table.Run(Key(2), compiler.Compile(2));
+    table.Run(Key(2), compiler.Compile(2));
+    EXPECT_EQ(compiler.compilations[2], 1);
+
+    table.Clear();
+    table.Run(Key(2), compiler.Compile(2));
+    EXPECT_EQ(compiler.compilations[2], 2);
+    EXPECT_EQ(table.GetStats().run, 1);
+}
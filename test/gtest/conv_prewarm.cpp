@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/prewarm.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+miopen::TensorDescriptor MakeInput() { return {miopenFloat, {4, 16, 14, 14}}; }
+miopen::TensorDescriptor MakeWeights() { return {miopenFloat, {16, 16, 3, 3}}; }
+miopen::ConvolutionDescriptor MakeConv() { return {{1, 1}, {1, 1}, {1, 1}}; }
+
+miopen::conv::ProblemDescription MakeProblem(miopen::conv::Direction direction)
+{
+    const auto in      = MakeInput();
+    const auto weights = MakeWeights();
+    const auto conv    = MakeConv();
+    const auto out     = conv.GetForwardOutputTensor(in, weights);
+    if(direction == miopen::conv::Direction::Forward)
+        return {in, weights, out, conv, direction};
+    return {out, weights, in, conv, direction};
+}
+
+/// Solver of the problem as selected by the immediate mode.
+miopen::solver::Id GetImmediateSolver(miopen::Handle& handle,
+                                      const miopen::conv::ProblemDescription& problem)
+{
+    auto ctx = miopen::ExecutionContext{&handle};
+    problem.SetupFloats(ctx);
+    const auto solutions = problem.GetConv().GetSolutions(ctx, problem, 1, nullptr);
+    if(solutions.empty())
+        return {};
+    return miopen::solver::Id{solutions.front().solution_id};
+}
+
+} // namespace
+
+TEST(ConvPrewarm, RegistersInvokersOnce)
+{
+    // A handle of its own, so that nothing has been loaded to it yet.
+    auto handle         = miopen::Handle{};
+    const auto problems = std::vector<miopen::conv::ProblemDescription>{
+        MakeProblem(miopen::conv::Direction::Forward),
+        MakeProblem(miopen::conv::Direction::BackwardData),
+    };
+
+    const auto timings = miopen::conv::Prewarm(handle, problems);
+    EXPECT_EQ(timings.problems, problems.size());
+    EXPECT_LE(timings.db_lookup + timings.kernel_load + timings.invokers, timings.total * 1.01f);
+    EXPECT_GE(timings.kern_db_lookup, 0);
+    EXPECT_GE(timings.decompress, 0);
+    EXPECT_GE(timings.module_load, 0);
+
+    for(const auto& problem : problems)
+    {
+        const auto solver = GetImmediateSolver(handle, problem);
+        ASSERT_TRUE(solver.IsValid());
+        EXPECT_TRUE(handle.GetInvoker(problem.MakeNetworkConfig(), solver)) << solver.ToString();
+    }
+
+    // Everything is loaded, so there is nothing left to do.
+    const auto again = miopen::conv::Prewarm(handle, problems);
+    EXPECT_EQ(again.problems, 0);
+    EXPECT_EQ(again.programs, 0);
+}
+
+TEST(ConvPrewarm, Api)
+{
+    auto handle = miopen::Handle{};
+    auto in     = MakeInput();
+    auto w      = MakeWeights();
+    auto conv   = MakeConv();
+    auto out    = conv.GetForwardOutputTensor(in, w);
+
+    miopenProblem_t problem;
+    ASSERT_EQ(miopenCreateConvProblem(&problem, &conv, miopenProblemDirectionForward),
+              miopenStatusSuccess);
+    EXPECT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionX, &in),
+              miopenStatusSuccess);
+    EXPECT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionW, &w),
+              miopenStatusSuccess);
+    EXPECT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionY, &out),
+              miopenStatusSuccess);
+
+    miopenPrewarmTimings_t timings;
+    EXPECT_EQ(miopenPrewarmProblems(&handle, 1, &problem, &timings), miopenStatusSuccess);
+    EXPECT_EQ(timings.problems, 1);
+
+    // Timings are optional.
+    EXPECT_EQ(miopenPrewarmProblems(&handle, 1, &problem, nullptr), miopenStatusSuccess);
+
+    EXPECT_EQ(miopenPrewarmProblems(&handle, 0, nullptr, nullptr), miopenStatusSuccess);
+
+    miopenDestroyProblem(problem);
+}
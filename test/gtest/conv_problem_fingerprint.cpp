@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/invoker_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+struct KeysCacheGuard
+{
+    KeysCacheGuard(bool enabled) { miopen::debug::conv_problem_keys_cache_enabled = enabled; }
+    ~KeysCacheGuard() { miopen::debug::conv_problem_keys_cache_enabled = true; }
+};
+
+struct TestCase
+{
+    miopen::TensorDescriptor in;
+    miopen::TensorDescriptor weights;
+    miopen::ConvolutionDescriptor conv;
+    miopen::conv::Direction direction;
+    int bias = 0;
+
+    miopen::conv::ProblemDescription MakeProblem() const
+    {
+        const auto out = conv.GetForwardOutputTensor(in, weights);
+        if(direction == miopen::conv::Direction::Forward)
+            return {in, weights, out, conv, direction, bias};
+        return {out, weights, in, conv, direction, bias};
+    }
+};
+
+std::vector<TestCase> GetTestCases()
+{
+    const auto conv_2d = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    const auto conv_3d = miopen::ConvolutionDescriptor{3,
+                                                       miopenConvolution,
+                                                       miopenPaddingDefault,
+                                                       {1, 1, 1},
+                                                       {2, 2, 2},
+                                                       {1, 1, 1},
+                                                       {0, 0, 0}};
+    auto grouped = conv_2d;
+    grouped.group_count = 4;
+
+    auto nhwc = miopen::TensorDescriptor{miopenHalf, miopenTensorNHWC, {8, 64, 28, 28}};
+    auto nhwc_weights = miopen::TensorDescriptor{miopenHalf, miopenTensorNHWC, {64, 64, 3, 3}};
+    auto cast         = miopen::TensorDescriptor{miopenFloat8, {8, 64, 28, 28}};
+    cast.SetCastType(miopenHalf);
+
+    return {
+        {{miopenFloat, {32, 64, 56, 56}}, {miopenFloat, {64, 64, 3, 3}}, conv_2d,
+         miopen::conv::Direction::Forward},
+        {{miopenFloat, {32, 64, 56, 56}}, {miopenFloat, {64, 64, 3, 3}}, conv_2d,
+         miopen::conv::Direction::Forward, 1},
+        {{miopenFloat, {32, 64, 56, 56}}, {miopenFloat, {64, 64, 3, 3}}, conv_2d,
+         miopen::conv::Direction::BackwardData},
+        {{miopenHalf, {32, 64, 56, 56}}, {miopenHalf, {64, 64, 3, 3}}, conv_2d,
+         miopen::conv::Direction::BackwardWeights},
+        {{miopenHalf, {32, 64, 56, 56}}, {miopenHalf, {64, 16, 3, 3}}, grouped,
+         miopen::conv::Direction::Forward},
+        {{miopenFloat, {4, 16, 8, 28, 28}}, {miopenFloat, {32, 16, 3, 3, 3}}, conv_3d,
+         miopen::conv::Direction::Forward},
+        {nhwc, nhwc_weights, conv_2d, miopen::conv::Direction::Forward},
+        {cast, {miopenFloat8, {64, 64, 3, 3}}, conv_2d, miopen::conv::Direction::Forward},
+    };
+}
+
+} // namespace
+
+TEST(ConvProblemFingerprint, EqualForEqualProblems)
+{
+    for(const auto& test_case : GetTestCases())
+    {
+        const auto problem = test_case.MakeProblem();
+        const auto copy    = test_case.MakeProblem();
+        EXPECT_NE(problem.GetFingerprint(), 0u);
+        EXPECT_EQ(problem.GetFingerprint(), copy.GetFingerprint());
+        EXPECT_EQ(problem.GetEncoding(), copy.GetEncoding());
+    }
+}
+
+TEST(ConvProblemFingerprint, DifferentForDifferentProblems)
+{
+    const auto test_cases = GetTestCases();
+    for(auto i = 0u; i < test_cases.size(); ++i)
+    {
+        for(auto j = i + 1; j < test_cases.size(); ++j)
+        {
+            const auto a = test_cases[i].MakeProblem();
+            const auto b = test_cases[j].MakeProblem();
+            EXPECT_NE(a.GetEncoding(), b.GetEncoding()) << i << " " << j;
+            EXPECT_NE(a.GetFingerprint(), b.GetFingerprint()) << i << " " << j;
+        }
+    }
+}
+
+TEST(ConvProblemFingerprint, CachedKeysMatchFormattedKeys)
+{
+    for(const auto& test_case : GetTestCases())
+    {
+        const auto problem = test_case.MakeProblem();
+
+        auto formatted_config = miopen::NetworkConfig{};
+        auto formatted_key    = std::string{};
+        {
+            const auto guard = KeysCacheGuard{false};
+            formatted_config = problem.MakeNetworkConfig();
+            formatted_key    = miopen::DbRecord{problem}.GetKey();
+        }
+
+        // The first lookup fills the cache, the second one hits it.
+        for(auto i = 0; i < 2; ++i)
+        {
+            const auto config = problem.MakeNetworkConfig();
+            EXPECT_EQ(config.ToString(), formatted_config.ToString());
+            EXPECT_EQ(config.GetHash(), formatted_config.GetHash());
+            EXPECT_EQ(miopen::DbRecord{problem}.GetKey(), formatted_key);
+        }
+    }
+}
+
+TEST(ConvProblemFingerprint, InvokerCacheLooksUpByConfig)
+{
+    auto cache         = miopen::InvokerCache{};
+    const auto problem = GetTestCases().front().MakeProblem();
+    cache.Register(problem.MakeNetworkConfig(), "Solver", [](auto&&...) {});
+
+    const auto found = cache.Get(miopen::NetworkConfig{problem.MakeNetworkConfig().ToString()},
+                                 "Solver");
+    ASSERT_TRUE(found);
+    EXPECT_FALSE(cache.Get(problem.MakeNetworkConfig(), "OtherSolver"));
+    EXPECT_FALSE(cache.Get(miopen::NetworkConfig{"other"}, "Solver"));
+}
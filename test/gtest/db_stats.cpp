@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "db_test_helpers.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace {
+
+using db_test::TestValue;
+
+void WriteRecord(const std::string& path, const std::string& key, int value)
+{
+    auto db = miopen::PlainTextDb{path, false};
+    EXPECT_TRUE(db.Update(TestValue{key}, "id", TestValue{std::to_string(value)}));
+}
+
+void WriteStatsAndExit(const std::string& path)
+{
+    setenv("MIOPEN_DB_STATISTICS_FILE", path.c_str(), 1); // NOLINT (concurrency-mt-unsafe)
+    auto& stats = miopen::GetDbStats();
+    stats.Reset();
+    stats.find_db.Count(false, true, std::chrono::steady_clock::now());
+    stats.compilations.Add(std::chrono::milliseconds{3});
+    ++stats.fallback_wti;
+    std::exit(0); // NOLINT (concurrency-mt-unsafe)
+}
+
+} // namespace
+
+TEST(DbStats, LatencyHistogram)
+{
+    auto stats = miopen::LatencyStats{};
+    stats.Add(std::chrono::nanoseconds{500});
+    stats.Add(std::chrono::microseconds{1});
+    stats.Add(std::chrono::microseconds{3});
+    stats.Add(std::chrono::microseconds{4});
+    stats.Add(std::chrono::hours{1});
+
+    EXPECT_EQ(stats.count, 5u);
+    EXPECT_EQ(stats.max_ns, 3600000000000u);
+    EXPECT_EQ(stats.histogram[0], 1u);
+    EXPECT_EQ(stats.histogram[1], 1u);
+    EXPECT_EQ(stats.histogram[2], 1u);
+    EXPECT_EQ(stats.histogram[3], 1u);
+    EXPECT_EQ(stats.histogram[miopen::LatencyStats::buckets - 1], 1u);
+
+    stats.Reset();
+    EXPECT_EQ(stats.count, 0u);
+    EXPECT_EQ(stats.total_ns, 0u);
+    EXPECT_EQ(stats.histogram[0], 0u);
+}
+
+TEST(DbStats, MultiFileDbCountsLayers)
+{
+    const auto installed = miopen::TempFile{"db-stats-installed"};
+    const auto user      = miopen::TempFile{"db-stats-user"};
+    WriteRecord(installed, "system", 1);
+    WriteRecord(installed, "both", 2);
+    WriteRecord(user, "both", 3);
+    WriteRecord(user, "user", 4);
+
+    auto stats = miopen::DbLayerStats{};
+    auto db    = miopen::MultiFileDb<miopen::ReadonlyRamDb, miopen::PlainTextDb, false>{
+        installed, user, &stats};
+
+    EXPECT_TRUE(db.FindRecord(TestValue{"user"}));
+    EXPECT_TRUE(db.FindRecord(TestValue{"both"}));
+    EXPECT_TRUE(db.FindRecord(TestValue{"system"}));
+    EXPECT_FALSE(db.FindRecord(TestValue{"none"}));
+
+    auto system = TestValue{"system"};
+    auto none   = TestValue{"none"};
+    auto value  = TestValue{};
+    EXPECT_TRUE(db.Load(system, "id", value));
+    EXPECT_EQ(value.value, "1");
+    EXPECT_FALSE(db.Load(none, "id", value));
+
+    EXPECT_EQ(stats.user_hits, 2u);
+    EXPECT_EQ(stats.system_hits, 2u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.lookup.count, 6u);
+
+    auto merged = miopen::MultiFileDb<miopen::ReadonlyRamDb, miopen::PlainTextDb, true>{
+        installed, user, &stats};
+    stats.Reset();
+    EXPECT_TRUE(merged.FindRecord(TestValue{"both"}));
+    EXPECT_TRUE(merged.FindRecord(TestValue{"system"}));
+    EXPECT_EQ(stats.user_hits, 1u);
+    EXPECT_EQ(stats.system_hits, 1u);
+    EXPECT_EQ(stats.misses, 0u);
+}
+
+TEST(DbStats, WrittenAtExit)
+{
+    const auto file = miopen::TempFile{"db-stats-json"};
+    EXPECT_EXIT(WriteStatsAndExit(file), ::testing::ExitedWithCode(0), "");
+
+    auto stream = std::ifstream{file.Path()};
+    const auto json = nlohmann::json::parse(stream);
+    EXPECT_EQ(json["find_db"]["system_hits"], 1);
+    EXPECT_EQ(json["find_db"]["lookup"]["count"], 1);
+    EXPECT_EQ(json["perf_db"]["misses"], 0);
+    EXPECT_EQ(json["compilations"]["count"], 1);
+    EXPECT_DOUBLE_EQ(json["compilations"]["max_ms"].get<double>(), 3.0);
+    EXPECT_EQ(json["compilations"]["histogram_us_log2"].size(), miopen::LatencyStats::buckets);
+    EXPECT_EQ(json["compilations"]["histogram_us_log2"][12], 1);
+    EXPECT_EQ(json["fallback"]["wti"], 1);
+}
@@ -407,7 +407,7 @@ TEST(DBSync, DISABLED_DynamicFDBSync)
     {
         auto ctx = _ctx; 
         miopen::conv::ProblemDescription problem;
-        miopen::ParseProblemKey(kinder.first, problem);
+        miopen::ParseProblemKey(std::string{kinder.first}, problem);
         problem.SetupFloats(ctx); // TODO: Check if this is necessary
         std::stringstream ss;
         problem.Serialize(ss);
@@ -463,7 +463,7 @@ TEST(DbSync, DISABLED_StaticFDBSync)
     {
         auto ctx = _ctx; 
         miopen::conv::ProblemDescription problem;
-        miopen::ParseProblemKey(kinder.first, problem);
+        miopen::ParseProblemKey(std::string{kinder.first}, problem);
         problem.SetupFloats(ctx); // TODO: Check if this is necessary
         std::stringstream ss;
         problem.Serialize(ss);
@@ -473,7 +473,7 @@ TEST(DbSync, DISABLED_StaticFDBSync)
 
         std::vector<miopen::FDBVal> fdb_vals;
         std::unordered_map<std::string, std::string> pdb_vals;
-        miopen::ParseFDBbVal(kinder.second.content, fdb_vals);
+        miopen::ParseFDBbVal(std::string{kinder.second.content}, fdb_vals);
         std::string pdb_select_query;
         miopen::GetPerfDbVals(pdb_file_path, problem, pdb_vals, pdb_select_query);
         // This is an opportunity to link up fdb and pdb entries
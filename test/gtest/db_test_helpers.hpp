@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/db_record.hpp>
+#include <miopen/ramdb.hpp>
+
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace db_test {
+
+/// Serves both as the key and as the values of the records, written as is.
+struct TestValue
+{
+    std::string value;
+
+    void Serialize(std::ostream& stream) const { stream << value; }
+
+    bool Deserialize(const std::string& str)
+    {
+        value = str;
+        return true;
+    }
+};
+
+inline miopen::DbRecord
+MakeRecord(const std::string& key, const std::string& id, std::string value)
+{
+    auto record = miopen::DbRecord{TestValue{key}};
+    record.SetValues(id, TestValue{std::move(value)});
+    return record;
+}
+
+/// Returns an empty string if there is no such record or id.
+template <class TDb>
+std::string Load(TDb& db, const std::string& key, const std::string& id)
+{
+    auto value = TestValue{};
+    if(!db.Load(key, id, value))
+        return {};
+    return value.value;
+}
+
+/// Replaces the contents of the db file, as if it was changed by another process, and lets the
+/// RamDb instances know about it.
+inline void WriteFile(const std::string& path, const std::string& contents)
+{
+    {
+        auto file = std::ofstream{path};
+        file << contents;
+    }
+
+    auto time_file = std::ofstream{miopen::RamDb::GetTimeFilePath(path)};
+    time_file << miopen::ramdb_clock::now().time_since_epoch().count();
+}
+
+} // namespace db_test
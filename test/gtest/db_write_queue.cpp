@@ -0,0 +1,288 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db.hpp>
+#include <miopen/db_write_queue.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+#include <miopen/ramdb.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "db_test_helpers.hpp"
+#include "death_test_style.hpp"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using db_test::Load;
+using db_test::MakeRecord;
+using db_test::TestValue;
+
+using UserDb = miopen::MultiFileDb<miopen::ReadonlyRamDb, miopen::RamDb, true>;
+
+/// Keeps the background thread of a queue in its first batch until Release() is called.
+class Gate
+{
+public:
+    miopen::DbWriteQueue::BatchFactory Factory()
+    {
+        return [this]() -> std::shared_ptr<void> {
+            auto lock = std::unique_lock<std::mutex>{mutex};
+            if(armed)
+            {
+                entered = true;
+                changed.notify_all();
+                changed.wait(lock, [&]() { return released; });
+            }
+            return nullptr;
+        };
+    }
+
+    void Arm()
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        armed = true;
+    }
+
+    void WaitEntered()
+    {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        changed.wait(lock, [&]() { return entered; });
+    }
+
+    void Release()
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        released = true;
+        changed.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool armed    = false;
+    bool entered  = false;
+    bool released = false;
+};
+
+[[noreturn]] void WriteAndExit(const std::string& installed, const std::string& user)
+{
+    miopen::debug::user_db_async_writes_override() = true;
+    auto db = UserDb{installed, user};
+    for(auto i = 0; i < 100; ++i)
+        db.Update(TestValue{"k" + std::to_string(i % 4)},
+                  std::to_string(i),
+                  TestValue{std::to_string(i)});
+    std::exit(0); // NOLINT (concurrency-mt-unsafe)
+}
+
+class DbWriteQueueTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { miopen::debug::user_db_async_writes_override() = true; }
+    void TearDown() override
+    {
+        miopen::DbWriteQueue::FlushAll();
+        miopen::debug::user_db_async_writes_override() = boost::none;
+    }
+};
+
+} // namespace
+
+TEST_F(DbWriteQueueTest, Coalescing)
+{
+    const auto temp = miopen::TempFile{"db-write-queue-coalescing"};
+    auto gate       = Gate{};
+    auto& queue     = miopen::DbWriteQueue::Get(temp.Path(), gate.Factory());
+    gate.Arm();
+
+    auto written = std::vector<std::string>{};
+    const auto update = [&](const std::string& key, const std::string& id, std::string value) {
+        queue.Update(MakeRecord(key, id, value), id, [&written, key, id, value]() {
+            written.push_back(key + "/" + id + "=" + value);
+            return true;
+        });
+    };
+
+    update("k1", "a", "0");
+    gate.WaitEntered();
+
+    // The first change is being written, the rest wait for it.
+    for(auto i = 1; i <= 100; ++i)
+        update("k1", "a", std::to_string(i));
+    update("k1", "b", "1");
+    update("k2", "a", "1");
+    queue.Store(MakeRecord("k2", "c", "2"), [&written]() {
+        written.push_back("k2=c:2");
+        return true;
+    });
+    update("k2", "d", "3");
+
+    auto k1 = boost::optional<miopen::DbRecord>{};
+    queue.Overlay("k1", k1);
+    ASSERT_TRUE(k1);
+    auto value = TestValue{};
+    EXPECT_TRUE(k1->GetValues("a", value));
+    EXPECT_EQ(value.value, "100");
+    EXPECT_TRUE(k1->GetValues("b", value));
+    EXPECT_EQ(value.value, "1");
+
+    // The store replaces whatever has been read from the db.
+    auto k2 = boost::make_optional(MakeRecord("k2", "e", "4"));
+    queue.Overlay("k2", k2);
+    ASSERT_TRUE(k2);
+    EXPECT_TRUE(k2->GetValues("c", value));
+    EXPECT_TRUE(k2->GetValues("d", value));
+    EXPECT_FALSE(k2->GetValues("a", value));
+    EXPECT_FALSE(k2->GetValues("e", value));
+
+    gate.Release();
+    queue.Flush();
+
+    EXPECT_EQ(written,
+              (std::vector<std::string>{"k1/a=0", "k1/a=100", "k1/b=1", "k2=c:2", "k2/d=3"}));
+    EXPECT_EQ(queue.GetStats().queued, 105);
+    EXPECT_EQ(queue.GetStats().written, 5);
+}
+
+TEST_F(DbWriteQueueTest, ReadYourWrites)
+{
+    const auto installed = miopen::TempFile{"db-write-queue-installed"};
+    const auto user      = miopen::TempFile{"db-write-queue-user"};
+
+    auto db = UserDb{installed.Path(), user.Path()};
+    ASSERT_TRUE(db.Update(TestValue{"k1"}, "a", TestValue{"1"}));
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k2", "b", "2")));
+
+    // Visible right away, whether written already or not.
+    EXPECT_EQ(Load(db, "k1", "a"), "1");
+    EXPECT_EQ(Load(db, "k2", "b"), "2");
+
+    // Direct changes wait for the queued ones.
+    ASSERT_TRUE(db.Remove(std::string{"k1"}, "a"));
+    EXPECT_EQ(Load(db, "k1", "a"), "");
+
+    miopen::DbWriteQueue::FlushAll();
+    auto plain = miopen::PlainTextDb{user.Path()};
+    EXPECT_EQ(Load(plain, "k1", "a"), "");
+    EXPECT_EQ(Load(plain, "k2", "b"), "2");
+}
+
+TEST_F(DbWriteQueueTest, ConcurrentWriters)
+{
+    const auto installed = miopen::TempFile{"db-write-queue-mt-installed"};
+    const auto user      = miopen::TempFile{"db-write-queue-mt-user"};
+
+    constexpr auto threads_count = 8;
+    constexpr auto ids_count     = 50;
+
+    auto threads = std::vector<std::thread>{};
+    for(auto t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            auto db = UserDb{installed.Path(), user.Path()};
+            for(auto i = 0; i < ids_count; ++i)
+            {
+                const auto id = std::to_string(t) + "_" + std::to_string(i);
+                db.Update(TestValue{"k" + std::to_string(i % 4)}, id, TestValue{id});
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    miopen::DbWriteQueue::FlushAll();
+
+    // All ids of all records made it to the file.
+    auto plain = miopen::PlainTextDb{user.Path()};
+    for(auto t = 0; t < threads_count; ++t)
+    {
+        for(auto i = 0; i < ids_count; ++i)
+        {
+            const auto id = std::to_string(t) + "_" + std::to_string(i);
+            EXPECT_EQ(Load(plain, "k" + std::to_string(i % 4), id), id);
+        }
+    }
+
+    const auto stats = miopen::DbWriteQueue::Find(user.Path())->GetStats();
+    EXPECT_EQ(stats.queued, threads_count * ids_count);
+    EXPECT_LE(stats.written, stats.queued);
+}
+
+TEST_F(DbWriteQueueTest, FlushedAtExit)
+{
+    // The death test child runs the test from the start, so the paths have to be the same.
+    const auto dir       = boost::filesystem::temp_directory_path();
+    const auto installed = (dir / "miopen-db-write-queue-exit.db").string();
+    const auto user      = (dir / "miopen-db-write-queue-exit.udb").string();
+    std::remove(user.c_str());
+
+    const auto style = ScopedDeathTestStyle{"threadsafe"};
+    EXPECT_EXIT(WriteAndExit(installed, user), ::testing::ExitedWithCode(0), "");
+
+    auto plain = miopen::PlainTextDb{user};
+    for(auto i = 0; i < 100; ++i)
+        EXPECT_EQ(Load(plain, "k" + std::to_string(i % 4), std::to_string(i)), std::to_string(i));
+    std::remove(user.c_str());
+}
+
+TEST_F(DbWriteQueueTest, FlushedByDestroy)
+{
+    miopenHandle_t handle = nullptr;
+    ASSERT_EQ(miopenCreate(&handle), miopenStatusSuccess);
+
+    // Named as the user dbs of the handle, which are written when it is destroyed.
+    const auto name      = miopen::deref(handle).GetDbBasename() + ".db-write-queue-destroy.udb";
+    const auto installed = miopen::TempFile{"db-write-queue-destroy-installed"};
+    const auto user      = (boost::filesystem::temp_directory_path() / name).string();
+    std::remove(user.c_str());
+
+    {
+        auto db = UserDb{installed.Path(), user};
+        for(auto i = 0; i < 100; ++i)
+            db.Update(TestValue{"k" + std::to_string(i % 4)},
+                      std::to_string(i),
+                      TestValue{std::to_string(i)});
+    }
+    ASSERT_EQ(miopenDestroy(handle), miopenStatusSuccess);
+
+    auto plain = miopen::PlainTextDb{user};
+    for(auto i = 0; i < 100; ++i)
+        EXPECT_EQ(Load(plain, "k" + std::to_string(i % 4), std::to_string(i)), std::to_string(i));
+    std::remove(user.c_str());
+}
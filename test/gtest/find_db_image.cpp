@@ -0,0 +1,315 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_path.hpp>
+#include <miopen/readonlymappeddb.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "death_test_style.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+struct TestValue
+{
+    std::string value;
+
+    bool Deserialize(const std::string& str)
+    {
+        value = str;
+        return true;
+    }
+};
+
+void WriteTextDb(const std::string& path, const std::vector<std::string>& lines)
+{
+    auto file = std::ofstream{path};
+    for(const auto& line : lines)
+        file << line << std::endl;
+}
+
+const std::vector<std::string>& TestLines()
+{
+    static const std::vector<std::string> lines = {
+        "3-32-32-3x3-64-32-32-16-1x1-1x1-1x1-0-NCHW-FP32-F="
+        "ConvSolverA:0.1,0,miopenConvolutionFwdAlgoDirect",
+        "1-7-7-1x1-8-7-7-1-0x0-1x1-1x1-0-NCHW-FP32-B="
+        "ConvSolverB:1.5,64,miopenConvolutionBwdDataAlgoGEMM;"
+        "ConvSolverC:2.5,0,miopenConvolutionBwdDataAlgoDirect",
+        "",
+        "ill-formed-line",
+        "3-32-32-3x3-64-32-32-16-1x1-1x1-1x1-0-NCHW-FP32-F=ConvSolverD:0.2,0,duplicate",
+        "2-16-16-5x5-4-16-16-8-2x2-1x1-1x1-0-NHWC-FP16-W="
+        "ConvSolverE:3,128,miopenConvolutionBwdWeightsAlgoGEMM",
+    };
+    return lines;
+}
+
+/// Removes the image of the text db at the end of the test.
+struct ImageFile
+{
+    ImageFile(const std::string& text_path)
+        : path(miopen::ReadonlyMappedDb::GetImagePath(text_path))
+    {
+    }
+    ImageFile(const ImageFile&) = delete;
+    ImageFile& operator=(const ImageFile&) = delete;
+    ~ImageFile() { boost::filesystem::remove(path); }
+
+    std::string path;
+};
+
+void CheckSame(const miopen::ReadonlyMappedDb& image, const miopen::ReadonlyRamDb& text)
+{
+    EXPECT_EQ(image.GetSize(), text.GetCacheMap().size());
+
+    for(const auto& item : text.GetCacheMap())
+    {
+        const auto key      = std::string{item.first};
+        const auto expected = text.FindRecord(key);
+        const auto actual   = image.FindRecord(key);
+        ASSERT_TRUE(expected);
+        ASSERT_TRUE(actual);
+        EXPECT_EQ(actual->GetKey(), expected->GetKey());
+        EXPECT_EQ(actual->GetSize(), expected->GetSize());
+
+        for(const auto& id : expected->As<TestValue>())
+        {
+            auto value = TestValue{};
+            EXPECT_TRUE(actual->GetValues(id.first, value));
+            EXPECT_EQ(value.value, id.second.value);
+        }
+    }
+
+    EXPECT_FALSE(image.FindRecord(std::string{"0-0-0"}));
+    EXPECT_FALSE(image.FindRecord(std::string{"z"}));
+}
+
+void RemoveSharedImage(const std::string& text_path)
+{
+    const auto name = miopen::ReadonlyMappedDb::GetSharedMemoryName(text_path);
+    boost::interprocess::shared_memory_object::remove(name.c_str());
+}
+
+/// Stands for another process on the node which loads the db first.
+[[noreturn]] void LoadSharedAndExit(const std::string& text_path)
+{
+    const auto& image = miopen::ReadonlyMappedDb::GetCached(text_path, true);
+    std::exit(image.IsShared() ? 0 : 1); // NOLINT (concurrency-mt-unsafe)
+}
+
+class FindDbSharedImage : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        miopen::debug::find_db_shared_memory_override() = true;
+    }
+
+    void TearDown() override { miopen::debug::find_db_shared_memory_override() = boost::none; }
+
+    // The child has to see the same paths as the parent.
+    const ScopedDeathTestStyle death_test_style{"fast"};
+};
+
+} // namespace
+
+TEST(FindDbImage, MappedLookupsMatchText)
+{
+    const miopen::TempFile text_file{"find-db-image"};
+    const auto text_path = text_file.Path();
+    WriteTextDb(text_path, TestLines());
+
+    const ImageFile image_file{text_path};
+    const auto& image_path = image_file.path;
+    ASSERT_TRUE(miopen::ReadonlyMappedDb::ConvertTextDb(text_path, image_path));
+
+    const auto& image = miopen::ReadonlyMappedDb::GetCached(text_path, true);
+    const auto& text  = miopen::ReadonlyRamDb::GetCached(text_path, true);
+
+    EXPECT_TRUE(image.IsMapped());
+    CheckSame(image, text);
+}
+
+TEST(FindDbImage, StaleImageFallsBackToText)
+{
+    const miopen::TempFile text_file{"find-db-image-stale"};
+    const auto text_path = text_file.Path();
+    WriteTextDb(text_path, {TestLines()[0]});
+
+    const ImageFile image_file{text_path};
+    const auto& image_path = image_file.path;
+    ASSERT_TRUE(miopen::ReadonlyMappedDb::ConvertTextDb(text_path, image_path));
+
+    WriteTextDb(text_path, TestLines());
+
+    const auto& image = miopen::ReadonlyMappedDb::GetCached(text_path, true);
+    const auto& text  = miopen::ReadonlyRamDb::GetCached(text_path, true);
+
+    EXPECT_FALSE(image.IsMapped());
+    CheckSame(image, text);
+}
+
+TEST(FindDbImage, ImageOfEditedTextOfSameSizeIsStale)
+{
+    const miopen::TempFile text_file{"find-db-image-same-size"};
+    const auto text_path = text_file.Path();
+    auto lines           = TestLines();
+    WriteTextDb(text_path, lines);
+
+    const ImageFile image_file{text_path};
+    ASSERT_TRUE(miopen::ReadonlyMappedDb::ConvertTextDb(text_path, image_file.path));
+
+    // Same size, different contents and modification time.
+    lines[0].back() = lines[0].back() == 't' ? 'u' : 't';
+    WriteTextDb(text_path, lines);
+    const auto time = boost::filesystem::last_write_time(text_path);
+    boost::filesystem::last_write_time(text_path, time + 10);
+
+    const auto& image = miopen::ReadonlyMappedDb::GetCached(text_path, true);
+    const auto& text  = miopen::ReadonlyRamDb::GetCached(text_path, true);
+
+    EXPECT_FALSE(image.IsMapped());
+    CheckSame(image, text);
+}
+
+TEST(FindDbImage, ImageOfCopiedTextIsUpToDate)
+{
+    const miopen::TempFile text_file{"find-db-image-copied"};
+    const auto text_path = text_file.Path();
+    WriteTextDb(text_path, TestLines());
+
+    const ImageFile image_file{text_path};
+    ASSERT_TRUE(miopen::ReadonlyMappedDb::ConvertTextDb(text_path, image_file.path));
+
+    // Same contents, different modification time, like the copy of the text db in the build tree.
+    const auto time = boost::filesystem::last_write_time(text_path);
+    boost::filesystem::last_write_time(text_path, time + 10);
+
+    const auto& image = miopen::ReadonlyMappedDb::GetCached(text_path, true);
+    const auto& text  = miopen::ReadonlyRamDb::GetCached(text_path, true);
+
+    EXPECT_TRUE(image.IsMapped());
+    CheckSame(image, text);
+}
+
+TEST(FindDbImage, SystemDbImagesAreMapped)
+{
+    namespace fs = boost::filesystem;
+
+    const auto db_dir = fs::path{miopen::GetSystemDbPath()};
+    boost::system::error_code ec;
+    if(!fs::is_directory(db_dir, ec))
+        GTEST_SKIP() << "No system db directory: " << db_dir;
+
+    auto n_images = 0;
+    for(const auto& entry : fs::directory_iterator{db_dir})
+    {
+        const auto text_path = entry.path().string();
+        const auto suffix    = std::string{".fdb.txt"};
+        if(text_path.size() < suffix.size() ||
+           text_path.compare(text_path.size() - suffix.size(), suffix.size(), suffix) != 0 ||
+           !fs::exists(miopen::ReadonlyMappedDb::GetImagePath(text_path)))
+            continue;
+
+        ++n_images;
+        EXPECT_TRUE(miopen::ReadonlyMappedDb::GetCached(text_path, true).IsMapped()) << text_path;
+    }
+
+    if(n_images == 0)
+        GTEST_SKIP() << "No find-db images in " << db_dir;
+}
+
+TEST(FindDbImage, CorruptImageFallsBackToText)
+{
+    const miopen::TempFile text_file{"find-db-image-corrupt"};
+    const auto text_path = text_file.Path();
+    WriteTextDb(text_path, TestLines());
+
+    const ImageFile image_file{text_path};
+    {
+        auto stream = std::ofstream{image_file.path, std::ios::binary};
+        stream << "MIOFDBIM";
+    }
+
+    const auto& image = miopen::ReadonlyMappedDb::GetCached(text_path, true);
+    const auto& text  = miopen::ReadonlyRamDb::GetCached(text_path, true);
+
+    EXPECT_FALSE(image.IsMapped());
+    CheckSame(image, text);
+}
+
+TEST_F(FindDbSharedImage, PublishedImageIsReused)
+{
+    const miopen::TempFile text_file{"find-db-image-shared"};
+    const auto text_path = text_file.Path();
+    WriteTextDb(text_path, TestLines());
+    RemoveSharedImage(text_path);
+
+    EXPECT_EXIT(LoadSharedAndExit(text_path), ::testing::ExitedWithCode(0), "");
+
+    const auto& image = miopen::ReadonlyMappedDb::GetCached(text_path, true);
+    const auto& text  = miopen::ReadonlyRamDb::GetCached(text_path, true);
+
+    // Published by the child and mapped by the parent.
+    EXPECT_TRUE(image.IsShared());
+    EXPECT_NE(image.GetSharedImagePublisher(), 0u);
+    EXPECT_NE(image.GetSharedImagePublisher(), static_cast<std::uint32_t>(::getpid()));
+    CheckSame(image, text);
+    RemoveSharedImage(text_path);
+}
+
+TEST_F(FindDbSharedImage, StaleImageIsReplaced)
+{
+    const miopen::TempFile text_file{"find-db-image-shared-stale"};
+    const auto text_path = text_file.Path();
+    WriteTextDb(text_path, {TestLines()[0]});
+    RemoveSharedImage(text_path);
+
+    EXPECT_EXIT(LoadSharedAndExit(text_path), ::testing::ExitedWithCode(0), "");
+
+    WriteTextDb(text_path, TestLines());
+
+    const auto& image = miopen::ReadonlyMappedDb::GetCached(text_path, true);
+    const auto& text  = miopen::ReadonlyRamDb::GetCached(text_path, true);
+
+    // Replaced by the parent.
+    EXPECT_TRUE(image.IsShared());
+    EXPECT_EQ(image.GetSharedImagePublisher(), static_cast<std::uint32_t>(::getpid()));
+    CheckSame(image, text);
+    RemoveSharedImage(text_path);
+}
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_db_nearest.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct TestKey
+{
+    std::string value;
+
+    void Serialize(std::ostream& stream) const { stream << value; }
+};
+
+miopen::DbRecord MakeRecord(const std::string& key,
+                            const std::vector<std::pair<std::string, float>>& times)
+{
+    auto record = miopen::DbRecord{TestKey{key}};
+    for(const auto& time : times)
+    {
+        record.SetValues(time.first,
+                         miopen::FindDbData{time.second, 0, "miopenConvolutionFwdAlgoDirect"});
+    }
+    return record;
+}
+
+// 2D, in: C=64 H=W=56, filter 3x3, out: K=64 H=W=56, batch 32.
+const std::string key_2d = "64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP32-F";
+
+} // namespace
+
+TEST(FindDbNearest, Parses2dKey)
+{
+    const auto features = miopen::FindDbKeyFeatures::Parse(key_2d);
+    ASSERT_TRUE(features);
+    EXPECT_EQ(features->bucket, "3x3-1x1-1x1-1x1-0-NCHW-FP32-F");
+    EXPECT_DOUBLE_EQ(features->sizes[0], 6.0);
+    EXPECT_DOUBLE_EQ(features->sizes[1], 6.0);
+    EXPECT_DOUBLE_EQ(features->sizes[2], 5.0);
+    EXPECT_DOUBLE_EQ(features->sizes[3], 0.0);
+    EXPECT_DOUBLE_EQ(features->work, 32.0 * 64 * 64 * 56 * 56);
+}
+
+TEST(FindDbNearest, Parses3dAndNonDefaultLayoutKeys)
+{
+    const auto features_3d = miopen::FindDbKeyFeatures::Parse(
+        "16-8-28-28-3x3x3-32-8-28-28-4-1x1x1-1x1x1-1x1x1-0-NCDHW-FP16-B_g2");
+    ASSERT_TRUE(features_3d);
+    EXPECT_EQ(features_3d->bucket, "3x3x3-1x1x1-1x1x1-1x1x1-0-NCDHW-FP16-B_g2");
+    EXPECT_DOUBLE_EQ(features_3d->sizes[3], 3.0);
+    EXPECT_DOUBLE_EQ(features_3d->work, 4.0 * 16 * 32 * 8 * 28 * 28);
+
+    // The same number of tokens as a 3D key with the default layout.
+    const auto features_nhwc = miopen::FindDbKeyFeatures::Parse(
+        "64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NHWC-NHWC-NHWC-FP32-W");
+    ASSERT_TRUE(features_nhwc);
+    EXPECT_EQ(features_nhwc->bucket, "3x3-1x1-1x1-1x1-0-NHWC-NHWC-NHWC-FP32-W");
+}
+
+TEST(FindDbNearest, RejectsMalformedKeys)
+{
+    EXPECT_FALSE(miopen::FindDbKeyFeatures::Parse(""));
+    EXPECT_FALSE(miopen::FindDbKeyFeatures::Parse("64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0"));
+    EXPECT_FALSE(
+        miopen::FindDbKeyFeatures::Parse("64-56-56-3x3-64-56-56-0-1x1-1x1-1x1-0-NCHW-FP32-F"));
+    EXPECT_FALSE(
+        miopen::FindDbKeyFeatures::Parse("64-56-x6-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP32-F"));
+}
+
+TEST(FindDbNearest, FindsNearestInTheSameBucket)
+{
+    auto index = miopen::FindDbNearest{};
+    EXPECT_TRUE(index.Add("64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F"));
+    EXPECT_TRUE(index.Add("64-28-28-3x3-64-28-28-32-1x1-1x1-1x1-0-NCHW-FP32-F"));
+    EXPECT_TRUE(index.Add("256-7-7-3x3-256-7-7-32-1x1-1x1-1x1-0-NCHW-FP32-F"));
+    // Other filter, data type and direction.
+    EXPECT_TRUE(index.Add("64-56-56-1x1-64-56-56-32-0x0-1x1-1x1-0-NCHW-FP32-F"));
+    EXPECT_TRUE(index.Add("64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP16-F"));
+    EXPECT_TRUE(index.Add("64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP32-B"));
+    EXPECT_FALSE(index.Add("garbage"));
+    EXPECT_EQ(index.GetSize(), 6u);
+
+    const auto neighbours = index.Find(key_2d, 5);
+    ASSERT_EQ(neighbours.size(), 3u);
+    // Twice smaller batch weighs less than twice smaller height and width.
+    EXPECT_EQ(neighbours[0].key, "64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F");
+    EXPECT_EQ(neighbours[1].key, "64-28-28-3x3-64-28-28-32-1x1-1x1-1x1-0-NCHW-FP32-F");
+    EXPECT_EQ(neighbours[2].key, "256-7-7-3x3-256-7-7-32-1x1-1x1-1x1-0-NCHW-FP32-F");
+    EXPECT_DOUBLE_EQ(neighbours[0].work_ratio, 2.0);
+    EXPECT_DOUBLE_EQ(neighbours[1].work_ratio, 4.0);
+
+    EXPECT_EQ(index.Find(key_2d, 1).size(), 1u);
+    EXPECT_TRUE(index.Find("64-56-56-5x5-64-56-56-32-2x2-1x1-1x1-0-NCHW-FP32-F", 5).empty());
+}
+
+TEST(FindDbNearest, RanksByWeightedRelativeTime)
+{
+    const auto records = std::unordered_map<std::string, miopen::DbRecord>{
+        {"near", MakeRecord("near", {{"Fast", 1.0f}, {"Slow", 3.0f}, {"Slower", 4.0f}})},
+        {"far", MakeRecord("far", {{"Fast", 2.0f}, {"Slow", 2.0f}, {"Rare", 1.0f}})},
+    };
+    const auto load = [&](const std::string& key) -> boost::optional<miopen::DbRecord> {
+        const auto record = records.find(key);
+        if(record == records.end())
+            return boost::none;
+        return record->second;
+    };
+
+    const auto estimates = miopen::FindDbNearest::Rank(
+        {{"missing", 0.0, 1.0}, {"near", 0.0, 2.0}, {"far", 3.0, 1.0}}, load);
+    ASSERT_EQ(estimates.size(), 4u);
+
+    // Weights are 1 for near and 0.25 for far, times are scaled to 1 ms * 2.
+    // Only the far record knows this one, it was the best there.
+    EXPECT_EQ(estimates[0].solver, "Rare");
+    EXPECT_FLOAT_EQ(estimates[0].time, 2.0f);
+    EXPECT_EQ(estimates[1].solver, "Fast");
+    EXPECT_FLOAT_EQ(estimates[1].time, (1.0f + 0.25f * 2.0f) / 1.25f * 2.0f);
+    EXPECT_EQ(estimates[2].solver, "Slow");
+    EXPECT_FLOAT_EQ(estimates[2].time, (3.0f + 0.25f * 2.0f) / 1.25f * 2.0f);
+    EXPECT_EQ(estimates[3].solver, "Slower");
+    EXPECT_FLOAT_EQ(estimates[3].time, 8.0f);
+    EXPECT_EQ(estimates[3].algorithm, "miopenConvolutionFwdAlgoDirect");
+
+    EXPECT_TRUE(miopen::FindDbNearest::Rank({{"missing", 0.0, 1.0}}, load).empty());
+}
+
+TEST(FindDbNearest, EstimatesFromSystemFindDb)
+{
+    const auto db_file = miopen::TempFile{"find_db_nearest"};
+    const auto db_path = db_file.Path() + ".fdb.txt";
+    {
+        auto file = std::ofstream{db_path};
+        file << "64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F="
+                "Fast:1,0,miopenConvolutionFwdAlgoDirect;"
+                "Slow:2,0,miopenConvolutionFwdAlgoGEMM"
+             << std::endl;
+        file << "64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP16-F="
+                "Slow:1,0,miopenConvolutionFwdAlgoGEMM"
+             << std::endl;
+    }
+
+    const auto& index = miopen::FindDbNearest::GetCached(db_path);
+    EXPECT_EQ(index.GetSize(), 2u);
+    EXPECT_EQ(&index, &miopen::FindDbNearest::GetCached(db_path));
+
+    const auto estimates = miopen::FindDbNearest::GetEstimates(db_path, key_2d, 3);
+    ASSERT_EQ(estimates.size(), 2u);
+    EXPECT_EQ(estimates[0].solver, "Fast");
+    EXPECT_FLOAT_EQ(estimates[0].time, 2.0f);
+    EXPECT_EQ(estimates[1].solver, "Slow");
+    EXPECT_FLOAT_EQ(estimates[1].time, 4.0f);
+    EXPECT_EQ(estimates[1].algorithm, "miopenConvolutionFwdAlgoGEMM");
+}
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_db_shards.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+namespace {
+
+const std::string fwd_fp16_key = "64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP16-F";
+const std::string bwd_fp32_key = "64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NCHW-FP32-B";
+const std::string fwd_fp16_payload =
+    "ConvOclDirectFwd:0.1,0,miopenConvolutionFwdAlgoDirect,<unused>";
+const std::string bwd_fp32_payload =
+    "ConvOclBwdWrW2<1>:0.2,0,miopenConvolutionBwdWeightsAlgoDirect,<unused>";
+
+void Write(const std::string& path, const std::string& contents)
+{
+    auto file = std::ofstream{path};
+    file << contents;
+}
+
+} // namespace
+
+TEST(FindDbShards, GetShard)
+{
+    using miopen::FindDbShards;
+    EXPECT_EQ(FindDbShards::GetShard(fwd_fp16_key), "NCHW-FP16-F");
+    EXPECT_EQ(FindDbShards::GetShard(
+                  "16-8-28-28-3x3x3-32-8-28-28-4-1x1x1-1x1x1-1x1x1-0-NCDHW-FP16-B_g2"),
+              "NCDHW-FP16-B");
+    EXPECT_EQ(FindDbShards::GetShard(
+                  "576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NHWC-NCHW-NCHW-FP32-W_cwFP8"),
+              "NHWC-NCHW-NCHW-FP32-W");
+    EXPECT_EQ(FindDbShards::GetShard("64-56-56-3x3"), "");
+    EXPECT_EQ(FindDbShards::GetShard(""), "");
+}
+
+TEST(FindDbShards, GetPaths)
+{
+    using miopen::FindDbShards;
+    EXPECT_EQ(FindDbShards::GetShardPath("/db/gfx906_60.HIP.fdb.txt", "NCHW-FP16-F"),
+              "/db/gfx906_60.HIP.fdb.NCHW-FP16-F.txt");
+    EXPECT_EQ(FindDbShards::GetListPath("/db/gfx906_60.HIP.fdb.txt"),
+              "/db/gfx906_60.HIP.fdb.shards");
+}
+
+TEST(FindDbShards, NotSharded)
+{
+    const auto dir  = miopen::TmpDir{"find-db-shards"};
+    const auto path = (dir.path / "whole.fdb.txt").string();
+    Write(path, fwd_fp16_key + "=" + fwd_fp16_payload + "\n");
+
+    const auto& shards = miopen::FindDbShards::GetCached(path);
+    EXPECT_FALSE(shards.IsSharded());
+    EXPECT_EQ(shards.GetPath(fwd_fp16_key), path);
+}
+
+TEST(FindDbShards, LoadsOnlyTheShardOfTheKey)
+{
+    using miopen::FindDbShards;
+
+    const auto dir  = miopen::TmpDir{"find-db-shards"};
+    const auto path = (dir.path / "sharded.fdb.txt").string();
+    Write(path,
+          fwd_fp16_key + "=" + fwd_fp16_payload + "\n" + bwd_fp32_key + "=" + bwd_fp32_payload +
+              "\n");
+    Write(FindDbShards::GetShardPath(path, "NCHW-FP16-F"),
+          fwd_fp16_key + "=" + fwd_fp16_payload + "\n");
+    Write(FindDbShards::GetShardPath(path, "NCHW-FP32-B"),
+          bwd_fp32_key + "=" + bwd_fp32_payload + "\n");
+    Write(FindDbShards::GetListPath(path), "NCHW-FP16-F\nNCHW-FP32-B\n");
+
+    const auto& shards = FindDbShards::GetCached(path);
+    ASSERT_TRUE(shards.IsSharded());
+    EXPECT_EQ(shards.GetPath(fwd_fp16_key), FindDbShards::GetShardPath(path, "NCHW-FP16-F"));
+    EXPECT_EQ(shards.GetPath(bwd_fp32_key), FindDbShards::GetShardPath(path, "NCHW-FP32-B"));
+    // Missing shard means there are no records of such problems.
+    EXPECT_EQ(shards.GetPath("64-56-56-3x3-64-56-56-32-1x1-1x1-1x1-0-NHWC-BF16-W"), "");
+    // Keys without a shard are looked up in the whole db.
+    EXPECT_EQ(shards.GetPath("unknown"), path);
+
+    const auto& db = miopen::ReadonlyRamDb::GetCached(shards.GetPath(fwd_fp16_key), false);
+    EXPECT_EQ(db.GetCacheMap().size(), 1u);
+    EXPECT_TRUE(db.FindRecord(fwd_fp16_key));
+    EXPECT_FALSE(db.FindRecord(bwd_fp32_key));
+}
@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/invoker_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+miopen::NetworkConfig MakeConfig(int i) { return miopen::NetworkConfig{"config" + std::to_string(i)}; }
+
+miopen::Invoker MakeInvoker()
+{
+    return [](const miopen::Handle&, const miopen::AnyInvokeParams&) {};
+}
+
+/// Configs are distributed over min(capacity, 16) shards by their hash.
+std::vector<miopen::NetworkConfig> MakeConfigsOfOneShard(std::size_t count, std::size_t shards)
+{
+    auto configs = std::vector<miopen::NetworkConfig>{};
+    for(auto i = 0; configs.size() < count; ++i)
+    {
+        auto config = MakeConfig(i);
+        if(config.GetHash() % shards == 0)
+            configs.push_back(config);
+    }
+    return configs;
+}
+
+} // namespace
+
+TEST(InvokerCache, Unbounded)
+{
+    auto cache = miopen::InvokerCache{0};
+    for(auto i = 0; i < 1000; ++i)
+        EXPECT_EQ(cache.Register(MakeConfig(i), "Solver", MakeInvoker()), 0u);
+
+    for(auto i = 0; i < 1000; ++i)
+        EXPECT_TRUE(cache.Get(MakeConfig(i), "Solver"));
+    EXPECT_FALSE(cache.Get(MakeConfig(0), "OtherSolver"));
+    EXPECT_FALSE(cache.Get(MakeConfig(1000), "Solver"));
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 1000u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.evictions, 0u);
+    EXPECT_EQ(stats.invokers, 1000u);
+    EXPECT_GT(stats.bytes, 1000u * sizeof(miopen::Invoker));
+}
+
+TEST(InvokerCache, EvictsWholeConfigs)
+{
+    auto cache         = miopen::InvokerCache{1};
+    const auto configs = MakeConfigsOfOneShard(2, 1);
+    EXPECT_EQ(cache.GetCapacity(), 1u);
+
+    EXPECT_EQ(cache.Register(configs[0], "Solver0", MakeInvoker()), 0u);
+    EXPECT_EQ(cache.Register(configs[0], "Solver1", MakeInvoker()), 0u);
+    // The config touched last is kept even if it has more invokers than the capacity.
+    EXPECT_EQ(cache.GetStats().invokers, 2u);
+
+    EXPECT_EQ(cache.Register(configs[1], "Solver0", MakeInvoker()), 2u);
+    EXPECT_FALSE(cache.Get(configs[0], "Solver0"));
+    EXPECT_FALSE(cache.Get(configs[0], "Solver1"));
+    EXPECT_TRUE(cache.Get(configs[1], "Solver0"));
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.evictions, 2u);
+    EXPECT_EQ(stats.invokers, 1u);
+}
+
+TEST(InvokerCache, EvictsLeastRecentlyUsed)
+{
+    // 16 shards of 4 invokers.
+    auto cache         = miopen::InvokerCache{64};
+    const auto configs = MakeConfigsOfOneShard(6, 16);
+
+    for(auto i = 0; i < 4; ++i)
+        EXPECT_EQ(cache.Register(configs[i], "Solver", MakeInvoker()), 0u);
+
+    EXPECT_TRUE(cache.Get(configs[0], "Solver"));
+    EXPECT_EQ(cache.Register(configs[4], "Solver", MakeInvoker()), 1u);
+    EXPECT_FALSE(cache.Get(configs[1], "Solver"));
+
+    // Registering one more invoker for a config also makes it the most recently used.
+    EXPECT_EQ(cache.Register(configs[2], "Solver1", MakeInvoker()), 1u);
+    EXPECT_FALSE(cache.Get(configs[3], "Solver"));
+    EXPECT_EQ(cache.Register(configs[5], "Solver", MakeInvoker()), 1u);
+    EXPECT_FALSE(cache.Get(configs[0], "Solver"));
+
+    EXPECT_TRUE(cache.Get(configs[2], "Solver"));
+    EXPECT_TRUE(cache.Get(configs[2], "Solver1"));
+    EXPECT_TRUE(cache.Get(configs[4], "Solver"));
+    EXPECT_TRUE(cache.Get(configs[5], "Solver"));
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.evictions, 3u);
+    EXPECT_EQ(stats.invokers, 4u);
+}
+
+TEST(InvokerCache, Found1_0)
+{
+    auto cache        = miopen::InvokerCache{0};
+    const auto config = MakeConfig(0);
+
+    cache.Register(config, "Solver0", MakeInvoker());
+    cache.Register(config, "Solver1", MakeInvoker(), std::string{"fwd"});
+    EXPECT_THROW(cache.SetAsFound1_0(config, "bwd", "Solver2"), miopen::Exception);
+    EXPECT_THROW(cache.SetAsFound1_0(MakeConfig(1), "bwd", "Solver0"), miopen::Exception);
+    cache.SetAsFound1_0(config, "bwd", "Solver0");
+
+    EXPECT_EQ(cache.GetFound1_0SolverId(config, "fwd").value(), "Solver1");
+    EXPECT_EQ(cache.GetFound1_0SolverId(config, "bwd").value(), "Solver0");
+    EXPECT_FALSE(cache.GetFound1_0SolverId(config, "wrw"));
+    EXPECT_TRUE(cache.GetFound1_0(config, "fwd"));
+    EXPECT_FALSE(cache.GetFound1_0(config, "wrw"));
+    EXPECT_FALSE(cache.GetFound1_0(MakeConfig(1), "fwd"));
+}
+
+TEST(InvokerCache, Stress)
+{
+    const auto capacity   = 256u;
+    const auto configs    = 4096;
+    const auto threads    = 8;
+    const auto iterations = 20000;
+    auto cache            = miopen::InvokerCache{capacity};
+    auto hits             = std::atomic<uint64_t>{0};
+    auto workers          = std::vector<std::thread>{};
+
+    for(auto t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            for(auto i = 0; i < iterations; ++i)
+            {
+                const auto config = MakeConfig((i * 7919 + t * 104729) % configs);
+                const auto solver = "Solver" + std::to_string(i % 3);
+                if(cache.Get(config, solver))
+                    ++hits;
+                else
+                    cache.Register(config, solver, MakeInvoker(), std::string{"fwd"});
+                if(cache.GetFound1_0(config, "fwd"))
+                    ++hits;
+            }
+        });
+    }
+    for(auto& worker : workers)
+        worker.join();
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, hits.load());
+    EXPECT_EQ(stats.hits + stats.misses, 2u * threads * iterations);
+    // Up to 3 invokers of the config touched last are kept in each of 16 shards.
+    EXPECT_LE(stats.invokers, capacity + 2u * 16);
+    EXPECT_GT(stats.evictions, 0u);
+}
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+
+#if MIOPEN_BACKEND_HIP
+
+#include <miopen/hipoc_program.hpp>
+#include <miopen/invoker_cache.hpp>
+#include <miopen/kernel_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Program without a module, only its size matters for the cache.
+miopen::Program MakeProgram(std::size_t size)
+{
+    auto program                   = miopen::Program{};
+    program.impl                   = std::make_shared<miopen::HIPOCProgramImpl>();
+    program.impl->code_object_size = size;
+    return program;
+}
+
+std::string MakeName(int i) { return "program" + std::to_string(i); }
+
+} // namespace
+
+TEST(KernelCacheBudget, Unlimited)
+{
+    auto cache = miopen::KernelCache{};
+    cache.SetProgramBudget(0);
+    for(auto i = 0; i < 10; ++i)
+        cache.AddProgram(MakeProgram(100), MakeName(i), "");
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.programs, 10u);
+    EXPECT_EQ(stats.bytes, 1000u);
+    EXPECT_EQ(stats.budget, 0u);
+    EXPECT_EQ(stats.evictions, 0u);
+}
+
+TEST(KernelCacheBudget, EvictsLeastRecentlyUsed)
+{
+    auto cache = miopen::KernelCache{};
+    cache.SetProgramBudget(300);
+    for(auto i = 0; i < 3; ++i)
+        cache.AddProgram(MakeProgram(100), MakeName(i), "");
+    EXPECT_EQ(cache.GetStats().bytes, 300u);
+
+    // Replacing a program does not count it twice.
+    cache.AddProgram(MakeProgram(100), MakeName(0), "");
+    EXPECT_EQ(cache.GetStats().bytes, 300u);
+    EXPECT_EQ(cache.GetStats().evictions, 0u);
+
+    cache.AddProgram(MakeProgram(100), MakeName(3), "");
+    EXPECT_FALSE(cache.HasProgram(MakeName(1), ""));
+    EXPECT_TRUE(cache.HasProgram(MakeName(0), ""));
+    EXPECT_TRUE(cache.HasProgram(MakeName(2), ""));
+    EXPECT_TRUE(cache.HasProgram(MakeName(3), ""));
+
+    cache.AddProgram(MakeProgram(250), MakeName(4), "");
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.programs, 1u);
+    EXPECT_EQ(stats.bytes, 250u);
+    EXPECT_EQ(stats.evictions, 4u);
+}
+
+TEST(KernelCacheBudget, KeepsProgramsInUse)
+{
+    auto cache        = miopen::KernelCache{};
+    const auto in_use = MakeProgram(100);
+    cache.AddProgram(in_use, MakeName(0), "");
+    cache.AddProgram(MakeProgram(100), MakeName(1), "");
+
+    cache.SetProgramBudget(50);
+    EXPECT_TRUE(cache.HasProgram(MakeName(0), ""));
+    EXPECT_FALSE(cache.HasProgram(MakeName(1), ""));
+    EXPECT_EQ(cache.GetStats().bytes, 100u);
+    EXPECT_EQ(cache.GetStats().used_bytes, 100u);
+
+    cache.ClearProgram(MakeName(0), "");
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.programs, 0u);
+    EXPECT_EQ(stats.bytes, 0u);
+    EXPECT_EQ(stats.evictions, 1u);
+}
+
+TEST(KernelCacheBudget, SharedProgramsAreNotCharged)
+{
+    // The ProgramRegistry hands the same program to the caches of the handles on a device.
+    auto shared = MakeProgram(100);
+    auto cache  = miopen::KernelCache{};
+    auto other  = miopen::KernelCache{};
+    cache.AddProgram(shared, MakeName(0), "");
+    other.AddProgram(shared, MakeName(0), "");
+    shared = {};
+
+    cache.SetProgramBudget(150);
+    cache.AddProgram(MakeProgram(100), MakeName(1), "");
+    EXPECT_TRUE(cache.HasProgram(MakeName(0), ""));
+    EXPECT_TRUE(cache.HasProgram(MakeName(1), ""));
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.bytes, 200u);
+    EXPECT_EQ(stats.used_bytes, 100u);
+    EXPECT_EQ(stats.evictions, 0u);
+
+    // Once the other handle drops it, the program is charged and evicted first.
+    other.ClearProgram(MakeName(0), "");
+    cache.SetProgramBudget(150);
+    EXPECT_FALSE(cache.HasProgram(MakeName(0), ""));
+    EXPECT_TRUE(cache.HasProgram(MakeName(1), ""));
+    stats = cache.GetStats();
+    EXPECT_EQ(stats.bytes, 100u);
+    EXPECT_EQ(stats.used_bytes, 0u);
+    EXPECT_EQ(stats.evictions, 1u);
+}
+
+TEST(KernelCacheBudget, EvictsNamedKernels)
+{
+    auto cache = miopen::KernelCache{};
+    for(auto i = 0; i < 3; ++i)
+    {
+        const auto program = MakeProgram(100);
+        cache.AddProgram(program, MakeName(i), "");
+        cache.AddKernel({"Algorithm", MakeName(i)}, miopen::Kernel{program, MakeName(i)}, 0);
+    }
+    EXPECT_EQ(cache.GetStats().used_bytes, 0u) << "The named kernels are in the cache";
+
+    // The hit makes the first program the most recently used.
+    EXPECT_EQ(cache.GetKernels("Algorithm", MakeName(0)).size(), 1u);
+    cache.SetProgramBudget(200);
+    EXPECT_TRUE(cache.HasProgram(MakeName(0), ""));
+    EXPECT_FALSE(cache.HasProgram(MakeName(1), ""));
+    EXPECT_TRUE(cache.HasProgram(MakeName(2), ""));
+    EXPECT_TRUE(cache.GetKernels("Algorithm", MakeName(1)).empty());
+    EXPECT_EQ(cache.GetKernels("Algorithm", MakeName(2)).size(), 1u);
+
+    // The kernels found by the problem key are evicted from the index as well.
+    auto key = miopen::ProblemKey{"EvictsNamedKernels"};
+    key.Add(1);
+    {
+        const auto program = MakeProgram(100);
+        cache.AddProgram(program, MakeName(3), "");
+        cache.AddKernel({"Algorithm", key.ToString()}, miopen::Kernel{program, MakeName(3)}, 0);
+        EXPECT_EQ(cache.GetKernels("Algorithm", key).size(), 1u);
+        EXPECT_EQ(cache.GetStats().indexed_keys, 1u);
+
+        cache.SetProgramBudget(100);
+        EXPECT_TRUE(cache.HasProgram(MakeName(3), "")) << "The program is in use";
+        EXPECT_FALSE(cache.HasProgram(MakeName(0), ""));
+        EXPECT_TRUE(cache.HasProgram(MakeName(2), ""));
+        EXPECT_EQ(cache.GetStats().evictions, 2u);
+    }
+
+    cache.SetProgramBudget(50);
+    EXPECT_EQ(cache.GetStats().programs, 0u);
+    EXPECT_TRUE(cache.GetKernels("Algorithm", key).empty());
+    EXPECT_EQ(cache.GetStats().indexed_keys, 0u);
+}
+
+TEST(KernelCacheBudget, ClearUnusedPrograms)
+{
+    auto cache        = miopen::KernelCache{};
+    const auto in_use = MakeProgram(100);
+    cache.AddProgram(in_use, MakeName(0), "");
+    cache.AddProgram(MakeProgram(200), MakeName(1), "");
+    cache.AddProgram(MakeProgram(300), MakeName(2), "");
+
+    EXPECT_EQ(cache.ClearUnusedPrograms(), 2u);
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.programs, 1u);
+    EXPECT_EQ(stats.bytes, 100u);
+}
+
+TEST(KernelCacheBudget, ClearsProgramsOfConcurrentlyEvictedInvokers)
+{
+    // Registers the invokers the way Handle::RegisterInvoker does, from several threads.
+    const auto threads = 8;
+    const auto configs = 64;
+    auto cache         = miopen::KernelCache{};
+    auto invokers      = miopen::InvokerCache{16};
+    auto programs      = std::vector<miopen::Program>{};
+    auto workers       = std::vector<std::thread>{};
+    for(auto i = 0; i < threads * configs; ++i)
+    {
+        programs.push_back(MakeProgram(100));
+        cache.AddProgram(programs.back(), MakeName(i), "");
+    }
+
+    for(auto t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            for(auto i = t * configs; i < (t + 1) * configs; ++i)
+            {
+                const auto config  = miopen::NetworkConfig{"config" + std::to_string(i)};
+                const auto program = programs[i];
+                const auto invoker = [program](const miopen::Handle&,
+                                               const miopen::AnyInvokeParams&) {};
+                if(invokers.Register(config, "Solver", invoker) > 0)
+                    cache.ScheduleClearUnusedPrograms();
+            }
+        });
+    }
+    for(auto& worker : workers)
+        worker.join();
+    programs.clear();
+
+    const auto registered = invokers.GetStats();
+    EXPECT_GT(registered.evictions, 0u);
+    EXPECT_EQ(cache.GetStats().programs, threads * configs) << "Released by the next insertion";
+
+    cache.AddProgram(MakeProgram(100), MakeName(threads * configs), "");
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.programs, registered.invokers + 1);
+    EXPECT_EQ(stats.evictions, registered.evictions);
+}
+
+#endif
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/problem_key.hpp>
+#include <miopen/config.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#if MIOPEN_BACKEND_HIP
+#include <miopen/kernel_cache.hpp>
+#endif
+
+TEST(ProblemKey, Compare)
+{
+    const auto make_key = [](const char* name, int value) {
+        auto key = miopen::ProblemKey{name};
+        key.Add(miopenHalf).Add(value).AddRange(std::vector<int>{1, 2});
+        return key;
+    };
+
+    EXPECT_EQ(make_key("Pooling", 1), make_key("Pooling", 1));
+    EXPECT_EQ(make_key("Pooling", 1).GetHash(), make_key("Pooling", 1).GetHash());
+    EXPECT_NE(make_key("Pooling", 1), make_key("Pooling", 2));
+    EXPECT_NE(make_key("Pooling", 1), make_key("Batchnorm", 1));
+    EXPECT_EQ(make_key("Pooling", 1).ToString(), "0-1-2-1-2");
+}
+
+TEST(ProblemKey, RangesAreDelimited)
+{
+    auto first = miopen::ProblemKey{"Test"};
+    first.AddRange(std::vector<int>{1, 2}).AddRange(std::vector<int>{3});
+    auto second = miopen::ProblemKey{"Test"};
+    second.AddRange(std::vector<int>{1}).AddRange(std::vector<int>{2, 3});
+
+    EXPECT_NE(first, second);
+    EXPECT_NE(first.ToString(), second.ToString());
+}
+
+TEST(ProblemKey, TooLong)
+{
+    auto key = miopen::ProblemKey{"Test"};
+    for(auto i = std::size_t{0}; i < miopen::ProblemKey::max_size; ++i)
+        key.Add(i);
+    EXPECT_ANY_THROW(key.Add(0));
+}
+
+TEST(ProblemKey, NetworkConfigIsMadeOnce)
+{
+    auto calls      = 0;
+    const auto make = [&]() {
+        ++calls;
+        return miopen::NetworkConfig{"config" + std::to_string(calls)};
+    };
+
+    auto key         = miopen::ProblemKey{"NetworkConfigIsMadeOnce"};
+    const auto first = miopen::GetNetworkConfig(key, make);
+    EXPECT_EQ(first->ToString(), "config1");
+    EXPECT_EQ(miopen::GetNetworkConfig(key, make)->ToString(), "config1");
+    EXPECT_EQ(calls, 1);
+
+    key.Add(1);
+    EXPECT_EQ(miopen::GetNetworkConfig(key, make)->ToString(), "config2");
+    EXPECT_EQ(calls, 2);
+}
+
+#if MIOPEN_BACKEND_HIP
+
+TEST(ProblemKey, KernelCacheLookup)
+{
+    auto cache = miopen::KernelCache{};
+    auto key   = miopen::ProblemKey{"OpTensor"};
+    key.Add(miopenFloat).Add(256);
+
+    EXPECT_TRUE(cache.GetKernels("Op1dTensorGeneric", key).empty());
+    EXPECT_EQ(cache.GetStats().indexed_keys, 0u) << "Misses are indexed";
+
+    auto kernel = miopen::Kernel{};
+    kernel.name = "Op1dTensorGeneric";
+    cache.AddKernel({"Op1dTensorGeneric", key.ToString()}, kernel, 0);
+    ASSERT_EQ(cache.GetKernels("Op1dTensorGeneric", key).size(), 1u);
+    // Found by the index this time.
+    ASSERT_EQ(cache.GetKernels("Op1dTensorGeneric", key).size(), 1u);
+    EXPECT_EQ(cache.GetKernels("Op1dTensorGeneric", key).front().name, "Op1dTensorGeneric");
+    EXPECT_TRUE(cache.GetKernels("Op2dTensorGeneric", key).empty());
+    EXPECT_EQ(cache.GetStats().indexed_keys, 1u);
+
+    cache.ClearKernels("Op1dTensorGeneric", key.ToString());
+    EXPECT_TRUE(cache.GetKernels("Op1dTensorGeneric", key).empty());
+    cache.AddKernel({"Op1dTensorGeneric", key.ToString()}, kernel, 0);
+    EXPECT_EQ(cache.GetKernels("Op1dTensorGeneric", key).size(), 1u);
+}
+
+#endif
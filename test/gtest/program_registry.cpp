@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+
+#if MIOPEN_BACKEND_HIP
+
+#include <miopen/handle.hpp>
+#include <miopen/program_registry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Program without a module, does not need a device.
+miopen::HIPOCProgram MakeProgram()
+{
+    auto program = miopen::HIPOCProgram{};
+    program.impl = std::make_shared<miopen::HIPOCProgramImpl>();
+    return program;
+}
+
+std::string GetTestName()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+} // namespace
+
+TEST(ProgramRegistry, LoadsOnceConcurrently)
+{
+    auto& registry    = miopen::ProgramRegistry::Get();
+    const auto before = registry.GetStats();
+    auto loads        = std::atomic<int>{0};
+    auto programs     = std::vector<miopen::HIPOCProgram>(16);
+    auto threads      = std::vector<std::thread>{};
+
+    for(auto i = 0u; i < programs.size(); ++i)
+    {
+        threads.emplace_back([&, i]() {
+            programs[i] = registry.GetOrLoad("device", GetTestName(), "", [&]() {
+                ++loads;
+                // Let the other threads come while the program is loading.
+                std::this_thread::sleep_for(std::chrono::milliseconds{50});
+                return MakeProgram();
+            });
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(loads, 1);
+    for(const auto& program : programs)
+        EXPECT_EQ(program.impl, programs.front().impl);
+
+    const auto after = registry.GetStats();
+    EXPECT_EQ(after.loads - before.loads, 1u);
+    EXPECT_EQ(after.hits - before.hits, programs.size() - 1);
+}
+
+TEST(ProgramRegistry, KeysByDeviceAndParams)
+{
+    auto& registry    = miopen::ProgramRegistry::Get();
+    auto loads        = 0;
+    const auto loader = [&]() {
+        ++loads;
+        return MakeProgram();
+    };
+
+    const auto program = registry.GetOrLoad("device0", GetTestName(), "-DA", loader);
+    EXPECT_EQ(registry.GetOrLoad("device0", GetTestName(), "-DA", loader).impl, program.impl);
+    EXPECT_NE(registry.GetOrLoad("device1", GetTestName(), "-DA", loader).impl, program.impl);
+    EXPECT_NE(registry.GetOrLoad("device0", GetTestName(), "-DB", loader).impl, program.impl);
+    EXPECT_EQ(loads, 3);
+}
+
+TEST(ProgramRegistry, ReleasesUnusedPrograms)
+{
+    auto& registry    = miopen::ProgramRegistry::Get();
+    auto loads        = 0;
+    const auto loader = [&]() {
+        ++loads;
+        return MakeProgram();
+    };
+
+    auto program    = registry.GetOrLoad("device", GetTestName(), "", loader);
+    const auto weak = std::weak_ptr<miopen::HIPOCProgramImpl>{program.impl};
+    program         = {};
+    EXPECT_TRUE(weak.expired());
+
+    program = registry.GetOrLoad("device", GetTestName(), "", loader);
+    EXPECT_EQ(loads, 2);
+}
+
+TEST(ProgramRegistry, RetriesFailedLoads)
+{
+    auto& registry = miopen::ProgramRegistry::Get();
+    EXPECT_THROW(registry.GetOrLoad("device",
+                                    GetTestName(),
+                                    "",
+                                    []() -> miopen::HIPOCProgram {
+                                        throw std::runtime_error("Failed to compile");
+                                    }),
+                 std::runtime_error);
+
+    const auto program = registry.GetOrLoad("device", GetTestName(), "", MakeProgram);
+    EXPECT_NE(program.impl, nullptr);
+}
+
+#if MIOPEN_MODE_NOGPU
+TEST(ProgramRegistry, SharedByHandles)
+{
+    auto& registry    = miopen::ProgramRegistry::Get();
+    const auto before = registry.GetStats();
+    auto handles      = std::vector<std::unique_ptr<miopen::Handle>>{};
+    auto programs     = std::vector<miopen::Program>(8);
+    auto threads      = std::vector<std::thread>{};
+
+    for(auto i = 0u; i < programs.size(); ++i)
+        handles.push_back(std::make_unique<miopen::Handle>());
+    for(auto i = 0u; i < programs.size(); ++i)
+    {
+        threads.emplace_back([&, i]() {
+            programs[i] = handles[i]->LoadProgram("MIOpenCheckNumerics.cpp", "", false, "");
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    for(const auto& program : programs)
+        EXPECT_EQ(program.impl, programs.front().impl);
+    EXPECT_EQ(registry.GetStats().loads - before.loads, 1u);
+}
+#endif
+
+#endif
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "db_test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+
+using db_test::Load;
+using db_test::MakeRecord;
+using db_test::WriteFile;
+
+class RamDbReload : public ::testing::Test
+{
+protected:
+    // The file is changed right before the lookups.
+    void SetUp() override
+    {
+        miopen::debug::ramdb_check_interval_override() = std::chrono::milliseconds{0};
+    }
+
+    void TearDown() override
+    {
+        miopen::debug::user_db_log_structured_override() = boost::none;
+        miopen::debug::ramdb_check_interval_override()   = boost::none;
+    }
+
+    static void ExpectReloads(const miopen::RamDb& db, std::size_t full, std::size_t incremental)
+    {
+        const auto stats = db.GetReloadStats();
+        EXPECT_EQ(stats.full, full);
+        EXPECT_EQ(stats.incremental, incremental);
+    }
+};
+
+} // namespace
+
+TEST_F(RamDbReload, AppendsAreParsedIncrementally)
+{
+    const auto temp = miopen::TempFile{"ramdb-reload-append"};
+    const auto path = temp.Path();
+    WriteFile(path, "k1=id:1\nk2=id:2\n");
+
+    // Two instances of the same file stand for two processes sharing it.
+    auto db    = miopen::RamDb{path};
+    auto other = miopen::RamDb{path};
+
+    EXPECT_EQ(Load(db, "k1", "id"), "1");
+    ExpectReloads(db, 1, 0);
+
+    ASSERT_TRUE(other.StoreRecord(MakeRecord("k3", "id", "3")));
+    EXPECT_EQ(Load(db, "k3", "id"), "3");
+    EXPECT_EQ(Load(db, "k2", "id"), "2");
+    ExpectReloads(db, 1, 1);
+
+    miopen::debug::user_db_log_structured_override() = true;
+    ASSERT_TRUE(other.StoreRecord(MakeRecord("k1", "id", "4")));
+    ASSERT_TRUE(other.RemoveRecord(std::string{"k2"}));
+    EXPECT_EQ(Load(db, "k1", "id"), "4");
+    EXPECT_EQ(Load(db, "k2", "id"), "");
+    ExpectReloads(db, 1, 2);
+}
+
+TEST_F(RamDbReload, RewritesAreReloadedCompletely)
+{
+    const auto temp = miopen::TempFile{"ramdb-reload-rewrite"};
+    const auto path = temp.Path();
+    WriteFile(path, "k1=id:1\nk2=id:2\n");
+
+    auto db    = miopen::RamDb{path};
+    auto other = miopen::RamDb{path};
+
+    EXPECT_EQ(Load(db, "k1", "id"), "1");
+    ExpectReloads(db, 1, 0);
+
+    // Changing an existing record in the plain mode rewrites the file.
+    ASSERT_TRUE(other.StoreRecord(MakeRecord("k1", "id", "3")));
+    EXPECT_EQ(Load(db, "k1", "id"), "3");
+    ExpectReloads(db, 2, 0);
+
+    // Same inode and no shrinking, but different contents.
+    WriteFile(path, "k1=id:5\nk2=id:6\n");
+    EXPECT_EQ(Load(db, "k1", "id"), "5");
+    EXPECT_EQ(Load(db, "k2", "id"), "6");
+    ExpectReloads(db, 3, 0);
+}
+
+TEST_F(RamDbReload, OwnChangesDoNotReload)
+{
+    const auto temp = miopen::TempFile{"ramdb-reload-own"};
+    const auto path = temp.Path();
+    WriteFile(path, "k1=id:1\n");
+
+    auto db = miopen::RamDb{path};
+    EXPECT_EQ(Load(db, "k1", "id"), "1");
+
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k2", "id", "2")));
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k1", "id", "3")));
+    ASSERT_TRUE(db.RemoveRecord(std::string{"k2"}));
+    EXPECT_EQ(Load(db, "k1", "id"), "3");
+    EXPECT_EQ(Load(db, "k2", "id"), "");
+    ExpectReloads(db, 1, 0);
+
+    // Own changes are not parsed again once someone else appends to the file.
+    auto other = miopen::RamDb{path};
+    ASSERT_TRUE(other.StoreRecord(MakeRecord("k4", "id", "4")));
+    EXPECT_EQ(Load(db, "k4", "id"), "4");
+    ExpectReloads(db, 1, 1);
+}
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/ramdb.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "db_test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using db_test::WriteFile;
+
+miopen::DbRecord MakeRecord(const std::string& key, int value)
+{
+    return db_test::MakeRecord(key, "id", std::to_string(value));
+}
+
+int Load(miopen::RamDb& db, const std::string& key)
+{
+    const auto value = db_test::Load(db, key, "id");
+    return value.empty() ? 0 : std::stoi(value);
+}
+
+template <class TFunc>
+void RunThreads(int count, const TFunc& func)
+{
+    auto threads = std::vector<std::thread>{};
+    threads.reserve(count);
+    for(auto i = 0; i < count; ++i)
+        threads.emplace_back([&func, i]() { func(i); });
+    for(auto& thread : threads)
+        thread.join();
+}
+
+} // namespace
+
+TEST(RamDbSnapshot, ReadersSeeWritesInOrder)
+{
+    const auto temp = miopen::TempFile{"ramdb-snapshot-order"};
+    const auto path = temp.Path();
+    WriteFile(path, "k=id:1\n");
+
+    auto db = miopen::RamDb{path};
+    ASSERT_EQ(Load(db, "k"), 1);
+
+    constexpr auto last_value = 200;
+    auto done                 = std::atomic<bool>{false};
+    auto failures             = std::atomic<int>{0};
+
+    RunThreads(5, [&](int id) {
+        if(id == 0)
+        {
+            for(auto i = 2; i <= last_value; ++i)
+                EXPECT_TRUE(db.StoreRecord(MakeRecord("k", i)));
+            done = true;
+            return;
+        }
+
+        auto previous = 1;
+        while(!done)
+        {
+            const auto value = Load(db, "k");
+            if(value < previous)
+                ++failures;
+            previous = value;
+        }
+    });
+
+    EXPECT_EQ(failures, 0);
+    EXPECT_EQ(Load(db, "k"), last_value);
+
+    // Own changes are published without reloading the file.
+    const auto stats = db.GetReloadStats();
+    EXPECT_EQ(stats.full, 1);
+    EXPECT_EQ(stats.incremental, 0);
+}
+
+TEST(RamDbSnapshot, ChangesBySomeoneElseAreVisible)
+{
+    const auto temp = miopen::TempFile{"ramdb-snapshot-external"};
+    const auto path = temp.Path();
+    WriteFile(path, "k=id:1\n");
+
+    // Checked on every lookup.
+    miopen::debug::ramdb_check_interval_override() = std::chrono::milliseconds{0};
+
+    auto db = miopen::RamDb{path};
+    ASSERT_EQ(Load(db, "k"), 1);
+
+    WriteFile(path, "k=id:2\n");
+    RunThreads(4, [&](int) { EXPECT_EQ(Load(db, "k"), 2); });
+
+    miopen::debug::ramdb_check_interval_override() = boost::none;
+}
+
+TEST(RamDbSnapshot, ChangesBySomeoneElseAreCheckedPeriodically)
+{
+    const auto temp = miopen::TempFile{"ramdb-snapshot-interval"};
+    const auto path = temp.Path();
+    WriteFile(path, "k1=id:1\n");
+
+    miopen::debug::ramdb_check_interval_override() = std::chrono::hours{1};
+
+    auto db = miopen::RamDb{path};
+    ASSERT_EQ(Load(db, "k1"), 1);
+
+    WriteFile(path, "k1=id:2\n");
+    EXPECT_EQ(Load(db, "k1"), 1);
+
+    // A change of its own makes the db notice the file has changed.
+    EXPECT_TRUE(db.StoreRecord(MakeRecord("k2", 3)));
+    EXPECT_EQ(Load(db, "k1"), 2);
+    EXPECT_EQ(Load(db, "k2"), 3);
+
+    miopen::debug::ramdb_check_interval_override() = boost::none;
+}
+
+TEST(RamDbSnapshot, ManyChanges)
+{
+    const auto temp = miopen::TempFile{"ramdb-snapshot-many"};
+    const auto path = temp.Path();
+    WriteFile(path, "");
+
+    // Enough changes for the shared copy of the cache to be made several times.
+    constexpr auto count = 300;
+    auto db              = miopen::RamDb{path};
+    for(auto i = 0; i < count; ++i)
+        ASSERT_TRUE(db.StoreRecord(MakeRecord("k" + std::to_string(i), i + 1)));
+    for(auto i = 0; i < count; i += 3)
+        ASSERT_TRUE(db.RemoveRecord(std::string{"k"} + std::to_string(i)));
+    for(auto i = 1; i < count; i += 3)
+        ASSERT_TRUE(db.StoreRecord(MakeRecord("k" + std::to_string(i), -i)));
+
+    const auto expected = [](int i) { return i % 3 == 0 ? 0 : i % 3 == 1 ? -i : i + 1; };
+    RunThreads(4, [&](int) {
+        for(auto i = 0; i < count; ++i)
+            EXPECT_EQ(Load(db, "k" + std::to_string(i)), expected(i));
+    });
+
+    auto reread = miopen::RamDb{path};
+    for(auto i = 0; i < count; ++i)
+        EXPECT_EQ(Load(reread, "k" + std::to_string(i)), expected(i));
+}
+
+TEST(RamDbSnapshot, CachedInstancesAreShared)
+{
+    const auto temp = miopen::TempFile{"ramdb-snapshot-cached"};
+    const auto path = temp.Path();
+    WriteFile(path, "k=id:1\n");
+
+    constexpr auto thread_count = 8;
+    auto ram_dbs                = std::vector<const miopen::RamDb*>(thread_count);
+    auto readonly_dbs           = std::vector<const miopen::ReadonlyRamDb*>(thread_count);
+
+    RunThreads(thread_count, [&](int id) {
+        ram_dbs[id]      = &miopen::RamDb::GetCached(path, false);
+        readonly_dbs[id] = &miopen::ReadonlyRamDb::GetCached(path, false);
+    });
+
+    for(auto i = 1; i < thread_count; ++i)
+    {
+        EXPECT_EQ(ram_dbs[i], ram_dbs[0]);
+        EXPECT_EQ(readonly_dbs[i], readonly_dbs[0]);
+    }
+    EXPECT_TRUE(readonly_dbs[0]->FindRecord(std::string{"k"}));
+}
@@ -0,0 +1,245 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/conv_solution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/invoke_params.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/optional.hpp>
+
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/// GenericSearch over a synthetic search space, run by a fake solver whose invokers report the
+/// times of a fake timer instead of running kernels. The journals and the strategies are the real
+/// ones, so the tests of the tuning checkpoints see what an interrupted or distributed search does.
+namespace synthetic_search {
+
+constexpr std::size_t search_size = 150;
+
+/// The same time of each config in every process. Every 7th config fails.
+inline boost::optional<float> Measure(std::size_t i)
+{
+    if(i % 7 == 0)
+        return boost::none;
+    return 1.0f + static_cast<float>((i * 37) % search_size);
+}
+
+inline std::size_t BestConfig()
+{
+    auto best = std::size_t{1};
+    for(auto i = std::size_t{1}; i < search_size; ++i)
+        if(Measure(i) && *Measure(i) < *Measure(best))
+            best = i;
+    return best;
+}
+
+struct Problem
+{
+    void Serialize(std::ostream& stream) const { stream << "synthetic"; }
+};
+
+/// Config with the given index in the search space. The default one is out of the space.
+struct PerformanceConfig
+{
+    std::size_t index = search_size;
+
+    PerformanceConfig() = default;
+    PerformanceConfig(bool) : index(0) {}
+
+    bool SetNextValue(const Problem&) { return ++index < search_size; }
+    bool IsValid(const miopen::ExecutionContext&, const Problem&) const
+    {
+        return index < search_size;
+    }
+    bool operator==(const PerformanceConfig& other) const { return index == other.index; }
+
+    /// Two numbers, so the model strategy has the features to learn from.
+    void Serialize(std::ostream& stream) const { stream << index % 16 << ',' << index / 16; }
+    friend std::ostream& operator<<(std::ostream& stream, const PerformanceConfig& config)
+    {
+        config.Serialize(stream);
+        return stream;
+    }
+};
+
+struct InvokeParams : miopen::InvokeParams
+{
+    Data_t GetWorkspace() const { return nullptr; }
+    std::size_t GetWorkspaceSize() const { return 0; }
+};
+
+struct Solver
+{
+    /// Called on the first run of each config of the search space, before it is measured.
+    std::function<void(std::size_t)> on_measured;
+
+    std::string SolverDbId() const { return "ConvSynthetic"; }
+
+    PerformanceConfig GetDefaultPerformanceConfig(const miopen::ExecutionContext&,
+                                                  const Problem&) const
+    {
+        return {};
+    }
+
+    miopen::solver::ConvSolution GetSolution(const miopen::ExecutionContext&,
+                                             const Problem&,
+                                             const PerformanceConfig& config) const
+    {
+        auto solution            = miopen::solver::ConvSolution{};
+        solution.invoker_factory = [config, on_measured = on_measured](
+                                       const std::vector<miopen::Kernel>&) -> miopen::Invoker {
+            return [config, on_measured, first = true](const miopen::Handle& handle,
+                                                       const miopen::AnyInvokeParams&) mutable {
+                if(config.index >= search_size)
+                {
+                    // The default config is only run for the score at the end.
+                    handle.ResetKernelTime();
+                    handle.AccumKernelTime(static_cast<float>(search_size));
+                    return;
+                }
+                if(first)
+                {
+                    first = false;
+                    on_measured(config.index);
+                }
+                const auto time = Measure(config.index);
+                if(!time)
+                    MIOPEN_THROW("Synthetic failure");
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(*time);
+            };
+        };
+        return solution;
+    }
+};
+
+struct ChildSearch
+{
+    /// Configs measured by the search, by their indices in the search space.
+    std::set<std::size_t> measured;
+    /// Config returned by the search, none if it has been killed.
+    boost::optional<std::size_t> best;
+    bool killed = false;
+};
+
+/// Runs the search in a child process, like another node sharing the journal directory does, with
+/// the given environment variables set. The variables are read once per process, and the parent
+/// never opens a device, so it is safe to fork. The child is killed before measuring more than
+/// kill_after configs.
+inline ChildSearch RunSearch(const std::vector<std::pair<std::string, std::string>>& env,
+                             std::size_t kill_after = std::numeric_limits<std::size_t>::max())
+{
+    struct Report
+    {
+        uint32_t index;
+        uint32_t is_best;
+    };
+
+    int pipe_fds[2];
+    if(pipe(pipe_fds) != 0)
+        throw std::runtime_error("pipe");
+    const auto child = fork();
+    if(child == -1)
+        throw std::runtime_error("fork");
+    if(child == 0)
+    {
+        close(pipe_fds[0]);
+        const auto send = [&](std::size_t index, bool is_best) {
+            const auto report = Report{static_cast<uint32_t>(index), is_best ? 1u : 0u};
+            if(write(pipe_fds[1], &report, sizeof(report)) != sizeof(report))
+                _exit(1);
+        };
+        try
+        {
+            for(const auto& var : env)
+                setenv(var.first.c_str(), var.second.c_str(), 1); // NOLINT (concurrency-mt-unsafe)
+
+            auto measured     = std::size_t{0};
+            const auto solver = Solver{[&](std::size_t index) {
+                if(measured++ == kill_after)
+                    raise(SIGKILL);
+                send(index, false);
+            }};
+
+            auto handle        = miopen::Handle{};
+            const auto context = miopen::ExecutionContext{&handle};
+            const auto best =
+                miopen::solver::GenericSearch(solver, context, Problem{}, InvokeParams{});
+            send(best.index, true);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            _exit(1);
+        }
+        _exit(0);
+    }
+    close(pipe_fds[1]);
+
+    auto result = ChildSearch{};
+    auto report = Report{};
+    while(read(pipe_fds[0], &report, sizeof(report)) == sizeof(report))
+    {
+        if(report.is_best != 0)
+            result.best = report.index;
+        else
+            result.measured.insert(report.index);
+    }
+    close(pipe_fds[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    result.killed = WIFSIGNALED(status);
+    return result;
+}
+
+inline std::size_t CountFiles(const boost::filesystem::path& directory)
+{
+    return std::distance(boost::filesystem::directory_iterator{directory},
+                         boost::filesystem::directory_iterator{});
+}
+
+} // namespace synthetic_search
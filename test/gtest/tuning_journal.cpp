@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/temp_file.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/tuning_journal.hpp>
+
+#include "synthetic_search.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Runs the search in a child process, which is killed after kill_after measurements, and resumes
+/// it in another one.
+void KillAndResume(const std::string& strategy, std::size_t kill_after)
+{
+    const auto directory = miopen::TmpDir{"tuning-journal"};
+    const auto env       = std::vector<std::pair<std::string, std::string>>{
+        {"MIOPEN_DEBUG_TUNING_JOURNAL_DIR", directory.path.string()},
+        {"MIOPEN_DEBUG_TUNING_STRATEGY", strategy}};
+
+    // The configs reported by the killed search are already in the journal.
+    const auto before = synthetic_search::RunSearch(env, kill_after);
+    ASSERT_TRUE(before.killed) << "The search has completed before the kill";
+    ASSERT_EQ(before.measured.size(), kill_after);
+
+    const auto after = synthetic_search::RunSearch(env);
+    for(const auto config : after.measured)
+        EXPECT_EQ(before.measured.count(config), 0) << "Config " << config << " measured again";
+    EXPECT_EQ(before.measured.size() + after.measured.size(), synthetic_search::search_size);
+    ASSERT_TRUE(after.best);
+    EXPECT_EQ(*after.best, synthetic_search::BestConfig());
+    EXPECT_EQ(synthetic_search::CountFiles(directory.path), 0)
+        << "Journal of a complete search is kept";
+}
+
+} // namespace
+
+TEST(TuningJournal, StoresAndLoadsEntries)
+{
+    const auto path = miopen::TempFile{"tuning-journal"};
+    {
+        auto journal = miopen::solver::TuningJournal{path.Path(), "key"};
+        EXPECT_TRUE(journal.GetEntries().empty());
+        journal.Append("1,2,3", 0.125f);
+        journal.Append("4,5,6", boost::none);
+    }
+
+    const auto journal = miopen::solver::TuningJournal{path.Path(), "key"};
+    ASSERT_EQ(journal.GetEntries().size(), 2);
+    EXPECT_EQ(journal.GetEntries()[0].config, "1,2,3");
+    ASSERT_TRUE(journal.GetEntries()[0].time);
+    EXPECT_EQ(*journal.GetEntries()[0].time, 0.125f);
+    EXPECT_EQ(journal.GetEntries()[1].config, "4,5,6");
+    EXPECT_FALSE(journal.GetEntries()[1].time);
+
+    // The journal of another search is not loaded and gets overwritten.
+    auto other = miopen::solver::TuningJournal{path.Path(), "other key"};
+    EXPECT_TRUE(other.GetEntries().empty());
+    other.Append("7,8,9", 1.0f);
+    EXPECT_EQ(miopen::solver::TuningJournal(path.Path(), "other key").GetEntries().size(), 1);
+    EXPECT_TRUE(miopen::solver::TuningJournal(path.Path(), "key").GetEntries().empty());
+}
+
+TEST(TuningJournal, IgnoresIncompleteLine)
+{
+    const auto path = miopen::TempFile{"tuning-journal"};
+    {
+        auto file = std::ofstream{path.Path()};
+        file << "key\n1,2,3;0.5\n4,5,6;garbage\n7,8,9;0.2";
+    }
+    auto journal = miopen::solver::TuningJournal{path.Path(), "key"};
+    ASSERT_EQ(journal.GetEntries().size(), 1);
+    EXPECT_EQ(journal.GetEntries()[0].config, "1,2,3");
+
+    // The cut off line is dropped.
+    journal.Append("10,11,12", 0.1f);
+    const auto reloaded = miopen::solver::TuningJournal{path.Path(), "key"};
+    ASSERT_EQ(reloaded.GetEntries().size(), 2);
+    EXPECT_EQ(reloaded.GetEntries()[1].config, "10,11,12");
+}
+
+TEST(TuningJournal, ResumesRandomSearch)
+{
+    KillAndResume("random", 60);
+}
+
+TEST(TuningJournal, ResumesModelSearch)
+{
+    KillAndResume("model", 40);
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/tuning_plan.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/tensor.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "get_handle.hpp"
+
+namespace {
+
+miopen::conv::ProblemDescription MakeProblem(miopen::conv::Direction direction)
+{
+    const auto in      = miopen::TensorDescriptor{miopenFloat, {16, 64, 28, 28}};
+    const auto weights = miopen::TensorDescriptor{miopenFloat, {64, 64, 3, 3}};
+    const auto conv    = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    const auto out     = conv.GetForwardOutputTensor(in, weights);
+    if(direction == miopen::conv::Direction::Forward)
+        return {in, weights, out, conv, direction};
+    return {out, weights, in, conv, direction};
+}
+
+} // namespace
+
+TEST(TuningPlan, EstimateIsLimitedByTheSlowerStage)
+{
+    const auto model = miopen::conv::TuningCostModel{100, 10};
+
+    // 4 builds on 2 threads take 200 ms, 100 measurements take 1000 ms.
+    EXPECT_FLOAT_EQ(miopen::conv::EstimateTuningTime(4, 100, model, 2, 1e9f), 1000 + 100);
+    // 40 builds on 2 threads take 2000 ms, 10 measurements take 100 ms.
+    EXPECT_FLOAT_EQ(miopen::conv::EstimateTuningTime(40, 10, model, 2, 1e9f), 2000 + 100);
+    EXPECT_FLOAT_EQ(miopen::conv::EstimateTuningTime(0, 10, model, 0, 1e9f), 100);
+    EXPECT_FLOAT_EQ(miopen::conv::EstimateTuningTime(40, 10, model, 2, 500), 500);
+}
+
+TEST(TuningPlan, EnumeratesApplicableSolvers)
+{
+    auto& handle        = get_handle();
+    const auto problems = std::vector<miopen::conv::ProblemDescription>{
+        MakeProblem(miopen::conv::Direction::Forward),
+        MakeProblem(miopen::conv::Direction::BackwardData),
+    };
+
+    const auto plan = miopen::conv::PlanTuning(handle, problems, {});
+    ASSERT_EQ(plan.problems.size(), problems.size());
+
+    auto total = 0.f;
+    for(const auto& problem : plan.problems)
+    {
+        auto tunable = std::size_t{0};
+        auto sum     = 0.f;
+        for(const auto& solver : problem.solvers)
+        {
+            if(!solver.tunable || !solver.error.empty())
+                continue;
+            ++tunable;
+            sum += solver.estimated_ms;
+            EXPECT_GT(solver.searched, 0) << solver.solver;
+            EXPECT_LE(solver.searched, std::max<std::size_t>(solver.primary + solver.spare, 1))
+                << solver.solver;
+            EXPECT_LE(solver.kernel_builds, problem.kernel_builds) << solver.solver;
+            EXPECT_LE(solver.estimated_ms, plan.time_max_ms) << solver.solver;
+        }
+        EXPECT_GT(tunable, 0) << problem.problem;
+        EXPECT_FLOAT_EQ(problem.estimated_ms, sum);
+        EXPECT_LE(problem.kernel_builds, plan.kernel_builds);
+        total += problem.estimated_ms;
+    }
+    EXPECT_FLOAT_EQ(plan.estimated_ms, total);
+
+    std::ostringstream ss;
+    plan.WriteJson(ss);
+    const auto json = nlohmann::json::parse(ss.str());
+    EXPECT_EQ(json["problems"].size(), problems.size());
+    EXPECT_EQ(json["kernel_builds"].get<std::size_t>(), plan.kernel_builds);
+    EXPECT_EQ(json["assumptions"]["threads"].get<std::size_t>(), plan.threads);
+}
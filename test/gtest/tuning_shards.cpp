@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/errors.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/tuning_journal.hpp>
+
+#include "synthetic_search.hpp"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using synthetic_search::search_size;
+
+std::vector<std::pair<std::string, std::string>> ShardEnv(const miopen::TmpDir& directory,
+                                                          const std::string& shard)
+{
+    return {{"MIOPEN_DEBUG_TUNING_JOURNAL_DIR", directory.path.string()},
+            {"MIOPEN_DEBUG_TUNING_SHARD", shard}};
+}
+
+std::string Worker(std::size_t index, std::size_t count)
+{
+    return std::to_string(index) + "/" + std::to_string(count);
+}
+
+} // namespace
+
+TEST(TuningShards, ParsesShard)
+{
+    const auto worker = miopen::solver::ParseTuningShard("2/4");
+    ASSERT_TRUE(worker);
+    EXPECT_EQ(worker->index, 2);
+    EXPECT_EQ(worker->count, 4);
+    EXPECT_FALSE(worker->merge);
+
+    const auto merge = miopen::solver::ParseTuningShard("merge/4");
+    ASSERT_TRUE(merge);
+    EXPECT_EQ(merge->count, 4);
+    EXPECT_TRUE(merge->merge);
+
+    for(const auto invalid : {"4/4", "1", "a/2", "1/0", "1/2x", "merge/"})
+        EXPECT_THROW(miopen::solver::ParseTuningShard(invalid), miopen::Exception) << invalid;
+}
+
+TEST(TuningShards, MergesWorkers)
+{
+    const auto directory = miopen::TmpDir{"tuning-shards"};
+    const auto workers   = std::size_t{3};
+
+    auto measured = std::multiset<std::size_t>{};
+    for(auto i = std::size_t{0}; i < workers; ++i)
+    {
+        const auto part = synthetic_search::RunSearch(ShardEnv(directory, Worker(i, workers)));
+        EXPECT_TRUE(part.best) << "Worker " << i;
+        EXPECT_EQ(part.measured.size(), search_size / workers);
+        for(const auto config : part.measured)
+        {
+            EXPECT_EQ(config % workers, i);
+            measured.insert(config);
+        }
+    }
+    EXPECT_EQ(measured.size(), search_size);
+    EXPECT_EQ(std::set<std::size_t>(measured.begin(), measured.end()).size(), search_size);
+    EXPECT_EQ(synthetic_search::CountFiles(directory.path), workers)
+        << "The workers keep their journals";
+
+    const auto merge = synthetic_search::RunSearch(ShardEnv(directory, "merge/3"));
+    EXPECT_TRUE(merge.measured.empty()) << "The merge measures the configs again";
+    ASSERT_TRUE(merge.best);
+    EXPECT_EQ(*merge.best, synthetic_search::BestConfig());
+    EXPECT_EQ(synthetic_search::CountFiles(directory.path), 0) << "The merge removes the journals";
+}
+
+TEST(TuningShards, MergeMeasuresMissingConfigs)
+{
+    const auto directory = miopen::TmpDir{"tuning-shards"};
+
+    // Worker 1 is killed midway, worker 2 never runs.
+    const auto first  = synthetic_search::RunSearch(ShardEnv(directory, Worker(0, 3)));
+    const auto second = synthetic_search::RunSearch(ShardEnv(directory, Worker(1, 3)), 10);
+    EXPECT_EQ(first.measured.size(), search_size / 3);
+    EXPECT_TRUE(second.killed);
+    EXPECT_EQ(second.measured.size(), 10);
+
+    const auto merge = synthetic_search::RunSearch(ShardEnv(directory, "merge/3"));
+    for(const auto config : merge.measured)
+    {
+        EXPECT_EQ(first.measured.count(config) + second.measured.count(config), 0)
+            << "Config " << config;
+    }
+    EXPECT_EQ(first.measured.size() + second.measured.size() + merge.measured.size(),
+              search_size);
+    ASSERT_TRUE(merge.best);
+    EXPECT_EQ(*merge.best, synthetic_search::BestConfig());
+}
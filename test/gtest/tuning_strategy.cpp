@@ -0,0 +1,203 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tuning_strategy.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Synthetic search space with a smooth cost in the log scale of tile-like parameters, the way the
+/// kernel times usually behave, instead of timing kernels on GPU.
+struct SyntheticSpace
+{
+    std::vector<std::vector<int>> configs;
+
+    SyntheticSpace()
+    {
+        const auto values = std::vector<int>{1, 2, 4, 8, 16, 32, 64};
+        for(const auto a : values)
+            for(const auto b : values)
+                for(const auto c : values)
+                    for(const auto d : values)
+                        configs.push_back({a, b, c, d});
+    }
+
+    std::string Serialize(std::size_t i) const
+    {
+        const auto& config = configs[i];
+        return std::to_string(config[0]) + "," + std::to_string(config[1]) + "," +
+               std::to_string(config[2]) + "," + std::to_string(config[3]) + ",false";
+    }
+
+    /// Configs with too large tiles fail.
+    bool IsFailed(std::size_t i) const { return configs[i][0] * configs[i][1] > 1024; }
+
+    float GetTime(std::size_t i) const
+    {
+        const auto a = std::log2(configs[i][0]) - 4.3;
+        const auto b = std::log2(configs[i][1]) - 2.6;
+        const auto c = std::log2(configs[i][2]) - 1.2;
+        const auto d = std::log2(configs[i][3]);
+        return static_cast<float>(1.0 + 0.3 * a * a + 0.2 * b * b + 0.1 * (a - c) * (a - c) +
+                                  0.05 * d + 0.02 * std::sin(3.0 * (a + b + c + d)));
+    }
+
+    float GetBestTime() const
+    {
+        auto best = std::numeric_limits<float>::max();
+        for(auto i = std::size_t{0}; i < configs.size(); ++i)
+            if(!IsFailed(i))
+                best = std::min(best, GetTime(i));
+        return best;
+    }
+};
+
+/// Runs the search loop of GenericSearch until a config within the given fraction of the best
+/// time is found. \return Number of measured configs.
+std::size_t MeasureUntilWithin(miopen::solver::TuningStrategy& strategy,
+                               const SyntheticSpace& space,
+                               double within)
+{
+    const auto target = space.GetBestTime() * (1.0 + within);
+    strategy.Init(space.configs.size(), [&](std::size_t i) {
+        return miopen::solver::ParseTuningFeatures(space.Serialize(i));
+    });
+
+    auto measured = std::size_t{0};
+    while(true)
+    {
+        const auto proposal = strategy.Propose(space.configs.size());
+        if(proposal.empty())
+            return measured;
+        for(const auto i : proposal)
+        {
+            ++measured;
+            if(space.IsFailed(i))
+            {
+                strategy.Report(i, boost::none);
+                continue;
+            }
+            const auto time = space.GetTime(i);
+            if(time <= target)
+                return measured;
+            strategy.Report(i, time);
+        }
+    }
+}
+
+} // namespace
+
+TEST(TuningStrategy, ParseFeatures)
+{
+    const auto features = miopen::solver::ParseTuningFeatures("64,-2,1.5,true,false:x");
+    ASSERT_EQ(features.size(), 6u);
+    EXPECT_EQ(features[0], 64.0);
+    EXPECT_EQ(features[1], -2.0);
+    EXPECT_EQ(features[2], 1.5);
+    EXPECT_EQ(features[3], 1.0);
+    EXPECT_EQ(features[4], 0.0);
+    EXPECT_EQ(features[5], miopen::solver::ParseTuningFeatures("x").front());
+}
+
+TEST(TuningStrategy, ProposesEachConfigOnce)
+{
+    const auto space = SyntheticSpace{};
+    auto random      = miopen::solver::RandomTuningStrategy{1};
+    auto model       = miopen::solver::ModelTuningStrategy{1};
+
+    for(miopen::solver::TuningStrategy* strategy :
+        std::vector<miopen::solver::TuningStrategy*>{&random, &model})
+    {
+        // The model is fitted each batch, so the space is limited for the test to be fast.
+        const auto size = std::size_t{300};
+        strategy->Init(size, [&](std::size_t i) {
+            return miopen::solver::ParseTuningFeatures(space.Serialize(i));
+        });
+        auto proposed = std::set<std::size_t>{};
+        while(true)
+        {
+            const auto proposal = strategy->Propose(16);
+            if(proposal.empty())
+                break;
+            EXPECT_LE(proposal.size(), 16u);
+            for(const auto i : proposal)
+            {
+                EXPECT_LT(i, size);
+                EXPECT_TRUE(proposed.insert(i).second);
+                strategy->Report(i, space.GetTime(i));
+            }
+        }
+        EXPECT_EQ(proposed.size(), size);
+    }
+}
+
+TEST(TuningStrategy, ModelFindsNearBestFasterThanRandom)
+{
+    const auto space  = SyntheticSpace{};
+    const auto within = 0.05;
+    const auto seeds  = 8;
+
+    auto random_total = std::size_t{0};
+    auto model_total  = std::size_t{0};
+    for(auto seed = 0; seed < seeds; ++seed)
+    {
+        auto random = miopen::solver::RandomTuningStrategy{static_cast<uint64_t>(seed)};
+        auto model  = miopen::solver::ModelTuningStrategy{static_cast<uint64_t>(seed)};
+        random_total += MeasureUntilWithin(random, space, within);
+        model_total += MeasureUntilWithin(model, space, within);
+    }
+
+    std::cout << "Configs measured to get within " << within * 100 << "% of the best of "
+              << space.configs.size() << ": random " << random_total / seeds << ", model "
+              << model_total / seeds << std::endl;
+    EXPECT_LT(model_total * 2, random_total);
+}
+
+TEST(TuningStrategy, EarlyStop)
+{
+    auto disabled = miopen::solver::TuningEarlyStop{0};
+    for(auto i = 0; i < 100; ++i)
+        EXPECT_FALSE(disabled.Update(1.0f));
+
+    auto early_stop = miopen::solver::TuningEarlyStop{3, 0.01};
+    // Failures alone do not stop the search.
+    EXPECT_FALSE(early_stop.Update(boost::none));
+    EXPECT_FALSE(early_stop.Update(boost::none));
+    EXPECT_FALSE(early_stop.Update(boost::none));
+    EXPECT_FALSE(early_stop.Update(10.0f));
+    EXPECT_FALSE(early_stop.Update(5.0f));
+    EXPECT_FALSE(early_stop.Update(5.0f));
+    // Improvements smaller than 1% do not count.
+    EXPECT_FALSE(early_stop.Update(4.99f));
+    EXPECT_TRUE(early_stop.Update(6.0f));
+}
@@ -0,0 +1,230 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db.hpp>
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "db_test_helpers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+using db_test::Load;
+using db_test::MakeRecord;
+
+std::vector<std::string> ReadLines(const std::string& path)
+{
+    auto file  = std::ifstream{path};
+    auto lines = std::vector<std::string>{};
+    auto line  = std::string{};
+    while(std::getline(file, line))
+        lines.push_back(line);
+    return lines;
+}
+
+void WriteLines(const std::string& path, const std::vector<std::string>& lines)
+{
+    auto file = std::ofstream{path};
+    for(const auto& line : lines)
+        file << line << std::endl;
+}
+
+class UserDbLog : public ::testing::Test
+{
+protected:
+    void SetUp() override { miopen::debug::user_db_log_structured_override() = true; }
+    void TearDown() override { miopen::debug::user_db_log_structured_override() = boost::none; }
+};
+
+} // namespace
+
+TEST_F(UserDbLog, ChangesAreAppended)
+{
+    const auto temp = miopen::TempFile{"user-db-log-append"};
+    const auto path = temp.Path();
+
+    auto db = miopen::PlainTextDb{path};
+    ASSERT_TRUE(db.RemoveRecord(std::string{"k0"}));
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k1", "a", "1")));
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k2", "b", "2")));
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k1", "a", "3")));
+    ASSERT_TRUE(db.RemoveRecord(std::string{"k2"}));
+
+    EXPECT_EQ(ReadLines(path), (std::vector<std::string>{"k1=a:1", "k2=b:2", "k1=a:3", "k2="}));
+
+    EXPECT_EQ(Load(db, "k1", "a"), "3");
+    EXPECT_FALSE(db.FindRecord(std::string{"k2"}));
+
+    auto other = miopen::PlainTextDb{path};
+    EXPECT_EQ(Load(other, "k1", "a"), "3");
+    EXPECT_FALSE(other.FindRecord(std::string{"k2"}));
+}
+
+TEST_F(UserDbLog, LastRecordWins)
+{
+    const auto temp = miopen::TempFile{"user-db-log-read"};
+    const auto path = temp.Path();
+
+    WriteLines(path, {"k1=a:1", "k2=b:2", "", "k1=a:3;c:4", "k2=", "k3=d:5"});
+
+    // Both the plain db and the RAM cache have to parse the whole log on the first access.
+    auto db = miopen::PlainTextDb{path};
+    EXPECT_EQ(Load(db, "k1", "a"), "3");
+    EXPECT_EQ(Load(db, "k1", "c"), "4");
+    EXPECT_FALSE(db.FindRecord(std::string{"k2"}));
+    EXPECT_EQ(Load(db, "k3", "d"), "5");
+
+    auto ram = miopen::RamDb{path};
+    EXPECT_EQ(Load(ram, "k1", "a"), "3");
+    EXPECT_FALSE(ram.FindRecord(std::string{"k2"}));
+    EXPECT_EQ(Load(ram, "k3", "d"), "5");
+
+    // Data appended behind the back of the index is picked up as well.
+    {
+        auto file = std::ofstream{path, std::ios::app};
+        file << "k3=d:6" << std::endl;
+    }
+    EXPECT_EQ(Load(db, "k3", "d"), "6");
+}
+
+TEST_F(UserDbLog, Compact)
+{
+    const auto temp = miopen::TempFile{"user-db-log-compact"};
+    const auto path = temp.Path();
+
+    auto db = miopen::PlainTextDb{path};
+    for(auto i = 0; i < 3; ++i)
+        for(const auto key : {"k1", "k2", "k3"})
+            ASSERT_TRUE(db.StoreRecord(MakeRecord(key, "a", std::to_string(i))));
+    ASSERT_TRUE(db.RemoveRecord(std::string{"k2"}));
+    ASSERT_TRUE(db.Compact());
+
+    EXPECT_EQ(ReadLines(path), (std::vector<std::string>{"k1=a:2", "k3=a:2"}));
+    EXPECT_EQ(Load(db, "k1", "a"), "2");
+    EXPECT_FALSE(db.FindRecord(std::string{"k2"}));
+
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k2", "a", "4")));
+    EXPECT_EQ(Load(db, "k2", "a"), "4");
+    EXPECT_EQ(ReadLines(path).size(), 3);
+
+    // Compaction of a plain file changes nothing.
+    ASSERT_TRUE(db.Compact());
+    EXPECT_EQ(ReadLines(path), (std::vector<std::string>{"k1=a:2", "k3=a:2", "k2=a:4"}));
+}
+
+TEST_F(UserDbLog, AutoCompaction)
+{
+    const auto temp = miopen::TempFile{"user-db-log-auto"};
+    const auto path = temp.Path();
+
+    const auto payload = std::string(16 * 1024, 'x');
+    auto db            = miopen::PlainTextDb{path};
+
+    for(auto i = 0; i < 256; ++i)
+        ASSERT_TRUE(db.StoreRecord(MakeRecord("k" + std::to_string(i % 4), "a", payload)));
+    miopen::PlainTextDb::WaitForCompaction();
+
+    // 4 MiB have been written in total, but no more than 1 MiB of garbage can be left behind.
+    const auto lines = ReadLines(path);
+    EXPECT_LT(lines.size(), 70);
+
+    auto keys = std::set<std::string>{};
+    for(const auto& line : lines)
+        keys.insert(line.substr(0, line.find('=')));
+    EXPECT_EQ(keys.size(), 4);
+
+    for(auto i = 0; i < 4; ++i)
+        EXPECT_EQ(Load(db, "k" + std::to_string(i), "a"), payload);
+}
+
+TEST_F(UserDbLog, StaleIndexIsRebuilt)
+{
+    const auto temp = miopen::TempFile{"user-db-log-stale"};
+    const auto path = temp.Path();
+
+    WriteLines(path, {"k1=a:1", "k2=b:2"});
+
+    auto db = miopen::PlainTextDb{path};
+    EXPECT_EQ(Load(db, "k1", "a"), "1");
+
+    // Rewritten in place with the same size, so the index cannot notice the change by itself.
+    WriteLines(path, {"k2=b:2", "k1=a:3"});
+    EXPECT_EQ(Load(db, "k1", "a"), "3");
+    EXPECT_EQ(Load(db, "k2", "b"), "2");
+}
+
+TEST_F(UserDbLog, PlainModeHandlesLog)
+{
+    const auto temp = miopen::TempFile{"user-db-log-plain"};
+    const auto path = temp.Path();
+
+    {
+        auto db = miopen::PlainTextDb{path};
+        ASSERT_TRUE(db.StoreRecord(MakeRecord("k1", "a", "1")));
+        ASSERT_TRUE(db.StoreRecord(MakeRecord("k2", "b", "2")));
+        ASSERT_TRUE(db.StoreRecord(MakeRecord("k1", "a", "3")));
+        ASSERT_TRUE(db.RemoveRecord(std::string{"k2"}));
+    }
+
+    miopen::debug::user_db_log_structured_override() = false;
+
+    // Reads in the plain mode take the last version of each record.
+    auto db = miopen::PlainTextDb{path};
+    EXPECT_EQ(Load(db, "k1", "a"), "3");
+    EXPECT_FALSE(db.FindRecord(std::string{"k2"}));
+    EXPECT_EQ(ReadLines(path).size(), 4);
+
+    // Changes in the plain mode compact the file first.
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k3", "c", "4")));
+    EXPECT_EQ(ReadLines(path), (std::vector<std::string>{"k1=a:3", "k3=c:4"}));
+    ASSERT_TRUE(db.RemoveRecord(std::string{"k1"}));
+    EXPECT_EQ(ReadLines(path), (std::vector<std::string>{"k3=c:4"}));
+}
+
+TEST_F(UserDbLog, PlainModeNoticesLog)
+{
+    const auto temp = miopen::TempFile{"user-db-log-notice"};
+    const auto path = temp.Path();
+
+    miopen::debug::user_db_log_structured_override() = false;
+    auto db = miopen::PlainTextDb{path};
+    ASSERT_TRUE(db.StoreRecord(MakeRecord("k1", "a", "1")));
+    EXPECT_EQ(Load(db, "k1", "a"), "1");
+
+    // The file is known to be unmarked, the appended record has to be noticed anyway.
+    miopen::debug::user_db_log_structured_override() = true;
+    ASSERT_TRUE(miopen::PlainTextDb{path}.StoreRecord(MakeRecord("k1", "a", "2")));
+    miopen::debug::user_db_log_structured_override() = false;
+    EXPECT_EQ(Load(db, "k1", "a"), "2");
+    EXPECT_EQ(ReadLines(path).size(), 2);
+}
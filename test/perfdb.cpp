@@ -39,6 +39,7 @@
 #include <boost/optional.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -1422,6 +1423,9 @@ struct PerfDbDriver : test_driver
         if(!logs_root.empty())
             thread_logs_root() = logs_root;
 
+        // The files are changed behind the back of the cached RamDb instances between the tests.
+        debug::ramdb_check_interval_override() = std::chrono::milliseconds{0};
+
         if(full_set)
         {
             tests::full_set() = true;
@@ -474,6 +474,68 @@ public:
     }
 };
 
+class DbBatchTest : public DbTest
+{
+public:
+    void Run() const
+    {
+        std::cout << "Testing batched writes to db..." << std::endl;
+
+        ProblemData p0(0), p1(1);
+        SQLitePerfDb db(std::string(temp_file), false);
+        SQLitePerfDb other(std::string(temp_file), false);
+
+        {
+            auto batch = db.BeginBatch();
+            EXPECT(db.Update(p0, id0(), value0()));
+            EXPECT(db.Update(p1, id1(), value1()));
+
+            {
+                // Nested batches are committed together with the outermost one.
+                auto nested = db.BeginBatch();
+                EXPECT(db.Update(p0, id2(), value2()));
+            }
+
+            EXPECT(!other.FindRecord(p0));
+            EXPECT(!other.FindRecord(p1));
+        }
+
+        const std::array<std::pair<std::string, SolverData>, 2> data0{{
+            {id0(), value0()},
+            {id2(), value2()},
+        }};
+        const std::array<std::pair<std::string, SolverData>, 1> data1{{
+            {id1(), value1()},
+        }};
+        ValidateSingleEntry(p0, data0, SQLitePerfDb(temp_file, false));
+        ValidateSingleEntry(p1, data1, SQLitePerfDb(temp_file, false));
+
+        // Removal runs after the changes queued before it.
+        {
+            auto batch = db.BeginBatch();
+            EXPECT(db.Update(p1, id0(), value0()));
+            EXPECT(db.Remove(p1, id1()));
+            EXPECT(other.FindRecord(p1));
+        }
+
+        const std::array<std::pair<std::string, SolverData>, 1> data2{{
+            {id0(), value0()},
+        }};
+        ValidateSingleEntry(p1, data2, SQLitePerfDb(temp_file, false));
+
+        SolverData read;
+        EXPECT(!db.Load(p1, id1(), read));
+
+        // Changes of the other threads using the connection are not deferred by the batch.
+        ProblemData p2(2);
+        {
+            auto batch = db.BeginBatch();
+            std::thread([&]() { EXPECT(db.Update(p2, id0(), value0())); }).join();
+            EXPECT(other.FindRecord(p2));
+        }
+    }
+};
+
 class DbParallelTest : public DbTest
 {
 public:
@@ -1268,6 +1330,7 @@ struct PerfDbDriver : test_driver
         DbFindTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
+        DbBatchTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
         DbMultiProcessReadTest().Run();
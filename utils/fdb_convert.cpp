@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/readonlymappeddb.hpp>
+
+#include <iostream>
+#include <string>
+
+static void PrintHelp()
+{
+    std::cout << "Usage: fdb_convert <input.fdb.txt> [<output.fdb.bin>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Converts a text system find-db into the memory-mapped binary image." << std::endl;
+    std::cout << "Output path defaults to the input path with '.txt' replaced by '.bin'."
+              << std::endl;
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn < 2 || argsn > 3)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    const std::string input  = args[1];
+    const std::string output = argsn == 3 ? std::string{args[2]}
+                                          : miopen::ReadonlyMappedDb::GetImagePath(input);
+
+    if(!miopen::ReadonlyMappedDb::ConvertTextDb(input, output))
+    {
+        std::cerr << "Failed to convert " << input << " to " << output << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
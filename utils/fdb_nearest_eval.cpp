@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_db_nearest.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/readonlyramdb.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static void PrintHelp()
+{
+    std::cout << "Usage: fdb_nearest_eval <input.fdb.txt> [<holdout> [<neighbours>]]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Evaluates the nearest find-db records fallback. Every <holdout>-th record "
+                 "(default 10) is removed from the db and its solvers are estimated from "
+                 "<neighbours> (default 3) nearest remaining records."
+              << std::endl;
+    std::cout << "Only the solvers present in the removed record are ranked, which stands for "
+                 "the applicability check."
+              << std::endl;
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn < 2 || argsn > 4)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    const std::string input = args[1];
+    const auto holdout      = argsn > 2 ? std::atoi(args[2]) : 10;
+    const auto neighbours   = argsn > 3 ? std::atoi(args[3]) : 3;
+    if(holdout < 2 || neighbours < 1)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    const auto& db = miopen::ReadonlyRamDb::GetCached(input, true);
+
+    auto keys = std::vector<std::string>{};
+    db.VisitKeys([&](std::string_view key) { keys.emplace_back(key); });
+    std::sort(keys.begin(), keys.end());
+
+    auto index  = miopen::FindDbNearest{};
+    auto tested = std::vector<std::string>{};
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        if(i % holdout == 0)
+            tested.push_back(keys[i]);
+        else
+            index.Add(keys[i]);
+    }
+
+    const auto load = [&](const std::string& key) { return db.FindRecord(key); };
+
+    std::size_t covered = 0, top1 = 0, top3 = 0;
+    auto regret    = 0.0;
+    auto log_error = 0.0;
+
+    for(const auto& key : tested)
+    {
+        const auto record = db.FindRecord(key);
+        auto actual       = std::unordered_map<std::string, float>{};
+        for(const auto& pair : record->As<miopen::FindDbData>())
+        {
+            if(pair.second.time > 0)
+                actual.emplace(pair.first, pair.second.time);
+        }
+        if(actual.empty())
+            continue;
+
+        auto estimates = miopen::FindDbNearest::Rank(index.Find(key, neighbours), load);
+        estimates.erase(std::remove_if(estimates.begin(),
+                                       estimates.end(),
+                                       [&](const auto& estimate) {
+                                           return actual.find(estimate.solver) == actual.end();
+                                       }),
+                        estimates.end());
+        if(estimates.empty())
+            continue;
+        ++covered;
+
+        auto ranked = std::vector<std::pair<float, std::string>>{};
+        for(const auto& pair : actual)
+            ranked.emplace_back(pair.second, pair.first);
+        std::sort(ranked.begin(), ranked.end());
+
+        const auto& predicted = estimates.front();
+        const auto position   = std::find_if(ranked.begin(), ranked.end(), [&](const auto& item) {
+            return item.second == predicted.solver;
+        });
+        if(position == ranked.begin())
+            ++top1;
+        if(position - ranked.begin() < 3)
+            ++top3;
+        regret += position->first / ranked.front().first;
+        log_error += std::abs(std::log2(predicted.time / position->first));
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Records: " << keys.size() << ", held out: " << tested.size() << std::endl;
+    std::cout << "Coverage: " << static_cast<double>(covered) / tested.size() << std::endl;
+    if(covered == 0)
+        return 0;
+    std::cout << "Top-1 accuracy: " << static_cast<double>(top1) / covered << std::endl;
+    std::cout << "Within actual top-3: " << static_cast<double>(top3) / covered << std::endl;
+    std::cout << "Mean regret (time of the chosen / best): " << regret / covered << std::endl;
+    std::cout << "Mean |log2(estimated / actual time)|: " << log_error / covered << std::endl;
+
+    return 0;
+}
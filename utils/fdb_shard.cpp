@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_db_shards.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+static void PrintHelp()
+{
+    std::cout << "Usage: fdb_shard <input.fdb.txt> [<output directory>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Splits a text system find-db into shards by the layouts, data types and"
+              << std::endl;
+    std::cout << "direction of the problems, and writes the list of the shards next to them."
+              << std::endl;
+    std::cout << "Output directory defaults to the directory of the input." << std::endl;
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn < 2 || argsn > 3)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    namespace fs     = boost::filesystem;
+    const auto input = fs::path{args[1]};
+    const auto output =
+        (argsn == 3 ? fs::path{args[2]} : input.parent_path()) / input.filename().string();
+
+    auto file = std::ifstream{input.string()};
+    if(!file)
+    {
+        std::cerr << "Unable to read " << input << std::endl;
+        return 1;
+    }
+
+    // Records keep their order within each shard. Those without a shard are only looked up in
+    // the whole db.
+    auto shards    = std::map<std::string, std::vector<std::string>>{};
+    auto line      = std::string{};
+    auto unsharded = 0;
+    while(std::getline(file, line))
+    {
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+            continue;
+        const auto shard = miopen::FindDbShards::GetShard({line.data(), key_size});
+        if(shard.empty())
+            ++unsharded;
+        else
+            shards[std::string{shard}].push_back(line);
+    }
+
+    auto list = std::ofstream{miopen::FindDbShards::GetListPath(output.string())};
+    for(const auto& shard : shards)
+    {
+        const auto path = miopen::FindDbShards::GetShardPath(output.string(), shard.first);
+        auto shard_file = std::ofstream{path};
+        for(const auto& record : shard.second)
+            shard_file << record << '\n';
+        if(!shard_file)
+        {
+            std::cerr << "Unable to write " << path << std::endl;
+            return 1;
+        }
+        list << shard.first << '\n';
+        std::cout << path << ": " << shard.second.size() << " records" << std::endl;
+    }
+
+    if(!list)
+    {
+        std::cerr << "Unable to write the list of the shards" << std::endl;
+        return 1;
+    }
+    if(unsharded > 0)
+        std::cout << unsharded << " records without a shard are left in the whole db"
+                  << std::endl;
+
+    return 0;
+}